@@ -5,6 +5,7 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
 #include <stdexcept>
 #include <map>
 #include <list>
@@ -299,6 +300,11 @@ namespace triton {
   }
 
 
+  const triton::uint8* API::getConcreteMemoryAreaView(triton::uint64 baseAddr, triton::usize& size) const {
+    return this->arch.getConcreteMemoryAreaView(baseAddr, size);
+  }
+
+
   triton::uint512 API::getConcreteRegisterValue(const triton::arch::RegisterOperand& reg) const {
     return this->arch.getConcreteRegisterValue(reg);
   }
@@ -369,6 +375,17 @@ namespace triton {
     }
 
     this->arch.buildSemantics(inst);
+
+    /* Stage 4 - Free the nodes which are not reachable anymore, the ones of the instruction are kept */
+    if (this->isSymbolicOptimizationEnabled(triton::engines::symbolic::AST_GARBAGE_COLLECTION)) {
+      std::vector<triton::ast::AbstractNode*> nodes;
+      inst.extractAstNodes(nodes);
+      for (triton::usize index = 0; index < nodes.size(); index++)
+        this->pinAstNode(nodes[index]);
+      this->astGarbageCollector->collectAstNodesIfNeeded();
+      for (triton::usize index = 0; index < nodes.size(); index++)
+        this->unpinAstNode(nodes[index]);
+    }
   }
 
 
@@ -439,6 +456,75 @@ namespace triton {
   }
 
 
+  std::vector<triton::arch::Instruction> API::processBasicBlock(const triton::uint8* opcodes, triton::usize size, triton::uint64 addr) {
+    std::vector<triton::arch::Instruction> block;
+    std::vector<triton::ast::AbstractNode*> nodes;
+    triton::usize offset = 0;
+
+    this->checkArchitecture();
+
+    if (opcodes == nullptr)
+      throw std::invalid_argument("API::processBasicBlock(): The opcodes cannot be null.");
+
+    /* The nodes held by the instructions of the block are pinned while the block is processed */
+    bool collect = this->isSymbolicOptimizationEnabled(triton::engines::symbolic::AST_GARBAGE_COLLECTION);
+
+    while (offset < size) {
+      block.resize(block.size() + 1);
+      triton::arch::Instruction& inst = block.back();
+
+      /* The disassembler refines the size, an instruction is at most 16 bytes */
+      inst.setOpcodes(const_cast<triton::uint8*>(opcodes + offset), static_cast<triton::uint32>(std::min<triton::usize>(size - offset, 16)));
+      inst.setAddress(addr + offset);
+
+      try {
+        this->processing(inst);
+      }
+      catch (...) {
+        for (triton::usize index = 0; index < nodes.size(); index++)
+          this->unpinAstNode(nodes[index]);
+        throw;
+      }
+
+      offset += inst.getSize();
+
+      if (collect) {
+        triton::usize pinned = nodes.size();
+        inst.extractAstNodes(nodes);
+        for (; pinned < nodes.size(); pinned++)
+          this->pinAstNode(nodes[pinned]);
+      }
+
+      if (inst.isControlFlow())
+        break;
+    }
+
+    /* Only keep the live-out expressions of the block */
+    if (this->isSymbolicEngineEnabled()) {
+      triton::usize removed = this->symbolic->removeDeadBlockExpressions(block);
+
+      /* The expressions of the block are live, only the previous ones may be removed */
+      if (this->isSymbolicOptimizationEnabled(triton::engines::symbolic::DEAD_EXPRESSIONS_ELIMINATION))
+        removed += this->symbolic->removeDeadSymbolicExpressionsIfNeeded();
+
+      /* The nodes of the removed expressions are reclaimed, the block is pinned again for the concretized written registers */
+      if (removed && collect) {
+        triton::usize pinned = nodes.size();
+        for (triton::usize index = 0; index < block.size(); index++)
+          block[index].extractAstNodes(nodes);
+        for (; pinned < nodes.size(); pinned++)
+          this->pinAstNode(nodes[pinned]);
+        this->astGarbageCollector->collectAstNodesIfNeeded();
+      }
+    }
+
+    for (triton::usize index = 0; index < nodes.size(); index++)
+      this->unpinAstNode(nodes[index]);
+
+    return block;
+  }
+
+
 
   /* AST garbage collector API ====================================================================== */
 
@@ -448,6 +534,19 @@ namespace triton {
   }
 
 
+  void* API::allocateAstNode(triton::usize size) {
+    this->checkAstGarbageCollector();
+    return this->astGarbageCollector->allocateAstNode(size);
+  }
+
+
+  void API::deallocateAstNode(void* ptr) {
+    /* Called by the delete operator, so we cannot throw */
+    if (ptr != nullptr && this->astGarbageCollector != nullptr)
+      this->astGarbageCollector->deallocateAstNode(ptr);
+  }
+
+
   void API::freeAllAstNodes(void) {
     this->checkAstGarbageCollector();
     this->astGarbageCollector->freeAllAstNodes();
@@ -466,6 +565,61 @@ namespace triton {
   }
 
 
+  triton::usize API::markAstNodes(void) {
+    this->checkAstGarbageCollector();
+    return this->astGarbageCollector->markAstNodes();
+  }
+
+
+  void API::freeAstNodesSinceMark(triton::usize mark) {
+    this->checkAstGarbageCollector();
+    this->astGarbageCollector->freeAstNodesSinceMark(mark);
+  }
+
+
+  void API::logChildAstNode(triton::ast::AbstractNode* node, triton::uint32 index) {
+    this->checkAstGarbageCollector();
+    this->astGarbageCollector->logChildAstNode(node, index);
+  }
+
+
+  void API::linkParentAstNode(triton::ast::AbstractNode* node, triton::ast::AbstractNode* parent) {
+    this->checkAstGarbageCollector();
+    this->astGarbageCollector->linkParentAstNode(node, parent);
+  }
+
+
+  void API::unlinkParentAstNode(triton::ast::AbstractNode* node, triton::ast::AbstractNode* parent) {
+    this->checkAstGarbageCollector();
+    this->astGarbageCollector->unlinkParentAstNode(node, parent);
+  }
+
+
+  std::set<triton::ast::AbstractNode*> API::getParentAstNodes(triton::ast::AbstractNode* node) {
+    this->checkAstGarbageCollector();
+    return this->astGarbageCollector->getParentAstNodes(node);
+  }
+
+
+  void API::pinAstNode(triton::ast::AbstractNode* node) {
+    this->checkAstGarbageCollector();
+    this->astGarbageCollector->pinAstNode(node);
+  }
+
+
+  void API::unpinAstNode(triton::ast::AbstractNode* node) {
+    /* Called by destructors, so we cannot throw */
+    if (this->astGarbageCollector != nullptr)
+      this->astGarbageCollector->unpinAstNode(node);
+  }
+
+
+  triton::usize API::collectAstNodes(void) {
+    this->checkAstGarbageCollector();
+    return this->astGarbageCollector->collectAstNodes();
+  }
+
+
   triton::ast::AbstractNode* API::recordAstNode(triton::ast::AbstractNode* node) {
     this->checkAstGarbageCollector();
     return this->astGarbageCollector->recordAstNode(node);
@@ -478,7 +632,7 @@ namespace triton {
   }
 
 
-  const std::set<triton::ast::AbstractNode*>& API::getAllocatedAstNodes(void) const {
+  std::set<triton::ast::AbstractNode*> API::getAllocatedAstNodes(void) const {
     this->checkAstGarbageCollector();
     return this->astGarbageCollector->getAllocatedAstNodes();
   }
@@ -508,6 +662,30 @@ namespace triton {
   }
 
 
+  triton::ast::AbstractNode* API::newAstTemplateHole(triton::uint32 size) {
+    this->checkAstGarbageCollector();
+    return this->astGarbageCollector->newAstTemplateHole(size);
+  }
+
+
+  const triton::ast::AstTemplate* API::getAstTemplate(triton::uint64 key) const {
+    this->checkAstGarbageCollector();
+    return this->astGarbageCollector->getAstTemplate(key);
+  }
+
+
+  const triton::ast::AstTemplate* API::recordAstTemplate(triton::uint64 key, const triton::ast::AstTemplate& tpl) {
+    this->checkAstGarbageCollector();
+    return this->astGarbageCollector->recordAstTemplate(key, tpl);
+  }
+
+
+  void API::clearAstTemplates(void) {
+    this->checkAstGarbageCollector();
+    this->astGarbageCollector->clearAstTemplates();
+  }
+
+
 
   /* AST representation API ========================================================================= */
 
@@ -650,12 +828,43 @@ namespace triton {
   }
 
 
+  void API::extractAstRoots(std::vector<triton::ast::AbstractNode*>& roots) const {
+    this->checkSymbolic();
+    this->symbolic->extractAstRoots(roots);
+  }
+
+
   void API::removeSymbolicExpression(triton::usize symExprId) {
     this->checkSymbolic();
     return this->symbolic->removeSymbolicExpression(symExprId);
   }
 
 
+  void API::holdSymbolicExpression(triton::engines::symbolic::SymbolicExpression* se) {
+    this->checkSymbolic();
+    this->symbolic->holdSymbolicExpression(se);
+  }
+
+
+  void API::releaseSymbolicExpression(triton::engines::symbolic::SymbolicExpression* se) {
+    /* Called by destructors, so we cannot throw */
+    if (this->symbolic != nullptr)
+      this->symbolic->releaseSymbolicExpression(se);
+  }
+
+
+  triton::usize API::removeDeadSymbolicExpressions(void) {
+    this->checkSymbolic();
+    triton::usize removed = this->symbolic->removeDeadSymbolicExpressions();
+
+    /* Free the nodes which are not reachable anymore */
+    if (removed && this->isSymbolicOptimizationEnabled(triton::engines::symbolic::AST_GARBAGE_COLLECTION))
+      this->collectAstNodes();
+
+    return removed;
+  }
+
+
   triton::engines::symbolic::SymbolicExpression* API::createSymbolicExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, triton::arch::OperandWrapper& dst, const std::string& comment) {
     this->checkSymbolic();
     switch (dst.getType()) {
@@ -686,6 +895,12 @@ namespace triton {
   }
 
 
+  triton::engines::symbolic::SymbolicExpression* API::createSymbolicLazyFlagExpression(triton::arch::Instruction& inst, triton::engines::symbolic::LazyAst* lazy, triton::uint512 value, triton::arch::RegisterOperand& flag, const std::string& comment) {
+    this->checkSymbolic();
+    return this->symbolic->createSymbolicLazyFlagExpression(inst, lazy, value, flag, comment);
+  }
+
+
   triton::engines::symbolic::SymbolicExpression* API::createSymbolicVolatileExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, const std::string& comment) {
     this->checkSymbolic();
     return this->symbolic->createSymbolicVolatileExpression(inst, node, comment);
@@ -786,6 +1001,17 @@ namespace triton {
   }
 
 
+  void API::removeAstDictionariesNodes(const std::set<triton::ast::AbstractNode*>& nodes) {
+    /* Called by the garbage collector, the engines may already be removed */
+    if (this->symbolic != nullptr)
+      this->symbolic->removeAstDictionariesNodes(nodes);
+
+    /* The backup is a copy of the symbolic engine, its dictionaries point to the same nodes */
+    if (this->symbolicBackup != nullptr)
+      this->symbolicBackup->removeAstDictionariesNodes(nodes);
+  }
+
+
   std::map<std::string, triton::usize> API::getAstDictionariesStats(void) {
     this->checkSymbolic();
     return this->symbolic->getAstDictionariesStats();
@@ -828,6 +1054,24 @@ namespace triton {
   }
 
 
+  std::vector<triton::usize> API::getRelevantPathConstraints(triton::ast::AbstractNode* node, triton::usize limit) {
+    this->checkSymbolic();
+    return this->symbolic->getRelevantPathConstraints(node, limit);
+  }
+
+
+  triton::ast::AbstractNode* API::getRelevantPathConstraintsAst(triton::ast::AbstractNode* node) {
+    this->checkSymbolic();
+    return this->symbolic->getRelevantPathConstraintsAst(node);
+  }
+
+
+  triton::ast::AbstractNode* API::sliceQueryAst(triton::ast::AbstractNode* node) {
+    this->checkSymbolic();
+    return this->symbolic->sliceQueryAst(node);
+  }
+
+
   void API::addPathConstraint(const triton::arch::Instruction& inst, triton::engines::symbolic::SymbolicExpression* expr) {
     this->checkSymbolic();
     this->symbolic->addPathConstraint(inst, expr);
@@ -912,9 +1156,9 @@ namespace triton {
   }
 
 
-  triton::ast::AbstractNode* API::getFullAst(triton::ast::AbstractNode* node) {
+  triton::ast::AbstractNode* API::getFullAst(triton::ast::AbstractNode* node, bool inplace) {
     this->checkSymbolic();
-    return this->symbolic->getFullAst(node);
+    return this->symbolic->getFullAst(node, inplace);
   }
 
 
@@ -925,10 +1169,10 @@ namespace triton {
   }
 
 
-  triton::ast::AbstractNode* API::getFullAstFromId(triton::usize symExprId) {
+  triton::ast::AbstractNode* API::getFullAstFromId(triton::usize symExprId, bool inplace) {
     this->checkSymbolic();
     triton::ast::AbstractNode* partialAst = this->getAstFromId(symExprId);
-    return this->getFullAst(partialAst);
+    return this->getFullAst(partialAst, inplace);
   }
 
 
@@ -965,15 +1209,99 @@ namespace triton {
   }
 
 
-  std::map<triton::uint32, triton::engines::solver::SolverModel> API::getModel(triton::ast::AbstractNode *node) const {
+  std::map<triton::uint32, triton::engines::solver::SolverModel> API::getModel(triton::ast::AbstractNode *node, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+    this->checkSolver();
+    return this->solver->getModel(node, status, timeout);
+  }
+
+
+  std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>> API::getModels(triton::ast::AbstractNode *node, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+    this->checkSolver();
+    return this->solver->getModels(node, limit, status, timeout);
+  }
+
+
+  triton::usize API::enumerateModels(triton::ast::AbstractNode *node, const std::set<triton::usize>& variables, const std::function<bool(const std::map<triton::uint32, triton::engines::solver::SolverModel>&)>& callback, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout) const {
+    this->checkSolver();
+    return this->solver->enumerateModels(node, variables, callback, limit, status, timeout);
+  }
+
+
+  std::vector<std::map<triton::uint32, triton::engines::solver::SolverModel>> API::getModels(const std::vector<triton::ast::AbstractNode*>& nodes, std::vector<triton::engines::solver::status_e>* status, triton::uint32 timeout) {
+    this->checkSolver();
+    return this->solver->getModels(nodes, status, timeout);
+  }
+
+
+  triton::uint32 API::getSolverThreads(void) const {
+    this->checkSolver();
+    return this->solver->getThreads();
+  }
+
+
+  void API::setSolverThreads(triton::uint32 threads) {
+    this->checkSolver();
+    this->solver->setThreads(threads);
+  }
+
+
+  std::map<triton::uint32, triton::engines::solver::SolverModel> API::getNegatedBranchModel(triton::usize index, triton::engines::solver::status_e* status, triton::uint32 timeout) {
+    this->checkSolver();
+    return this->solver->getNegatedBranchModel(index, status, timeout);
+  }
+
+
+  std::vector<std::map<triton::uint32, triton::engines::solver::SolverModel>> API::getNegatedBranchesModels(void) {
+    this->checkSolver();
+    return this->solver->getNegatedBranchesModels();
+  }
+
+
+  triton::uint32 API::getSolverTimeout(void) const {
+    this->checkSolver();
+    return this->solver->getTimeout();
+  }
+
+
+  void API::setSolverTimeout(triton::uint32 timeout) {
+    this->checkSolver();
+    this->solver->setTimeout(timeout);
+  }
+
+
+  triton::uint32 API::getSolverMemoryLimit(void) const {
+    this->checkSolver();
+    return this->solver->getMemoryLimit();
+  }
+
+
+  void API::setSolverMemoryLimit(triton::uint32 limit) {
+    this->checkSolver();
+    this->solver->setMemoryLimit(limit);
+  }
+
+
+  const std::list<std::map<std::string, triton::uint64>>& API::getSolverQueryStats(void) const {
+    this->checkSolver();
+    return this->solver->getQueryStats();
+  }
+
+
+  void API::clearSolverQueryStats(void) {
+    this->checkSolver();
+    this->solver->clearQueryStats();
+  }
+
+
+  std::map<std::string, triton::usize> API::getSolverQueryCacheStats(void) const {
     this->checkSolver();
-    return this->solver->getModel(node);
+    return this->solver->getQueryCacheStats();
   }
 
 
-  std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>> API::getModels(triton::ast::AbstractNode *node, triton::uint32 limit) const {
+  void API::clearSolverQueryCache(void) {
     this->checkSolver();
-    return this->solver->getModels(node, limit);
+    this->solver->clearQueryCache();
   }
 
 
@@ -1052,6 +1380,18 @@ namespace triton {
   }
 
 
+  bool API::setTaint(const triton::arch::Instruction& inst, const triton::arch::OperandWrapper& op, bool flag) {
+    this->checkTaint();
+    switch (op.getType()) {
+      case triton::arch::OP_IMM: return triton::engines::taint::UNTAINTED;
+      case triton::arch::OP_MEM: return this->setTaintMemory(inst, op.getConstMemory(), flag);
+      case triton::arch::OP_REG: return this->setTaintRegister(inst, op.getConstRegister(), flag);
+      default:
+        throw std::runtime_error("API::setTaint(): Invalid operand.");
+    }
+  }
+
+
   bool API::setTaintMemory(const triton::arch::MemoryOperand& mem, bool flag) {
     this->checkTaint();
     this->taint->setTaintMemory(mem, flag);
@@ -1066,6 +1406,20 @@ namespace triton {
   }
 
 
+  bool API::setTaintMemory(const triton::arch::Instruction& inst, const triton::arch::MemoryOperand& mem, bool flag) {
+    this->checkTaint();
+    this->taint->setTaintMemory(inst, mem, flag);
+    return flag;
+  }
+
+
+  bool API::setTaintRegister(const triton::arch::Instruction& inst, const triton::arch::RegisterOperand& reg, bool flag) {
+    this->checkTaint();
+    this->taint->setTaintRegister(inst, reg, flag);
+    return flag;
+  }
+
+
   bool API::taintMemory(triton::uint64 addr) {
     this->checkTaint();
     return this->taint->taintMemory(addr);
@@ -1084,6 +1438,54 @@ namespace triton {
   }
 
 
+  bool API::taintMemory(triton::uint64 addr, triton::uint32 label) {
+    this->checkTaint();
+    return this->taint->taintMemory(addr, label);
+  }
+
+
+  bool API::taintMemory(const triton::arch::MemoryOperand& mem, triton::uint32 label) {
+    this->checkTaint();
+    return this->taint->taintMemory(mem, label);
+  }
+
+
+  bool API::taintRegister(const triton::arch::RegisterOperand& reg, triton::uint32 label) {
+    this->checkTaint();
+    return this->taint->taintRegister(reg, label);
+  }
+
+
+  void API::enableTaintLabels(bool flag) {
+    this->checkTaint();
+    this->taint->enableLabels(flag);
+  }
+
+
+  bool API::isTaintLabelsEnabled(void) const {
+    this->checkTaint();
+    return this->taint->isLabelsEnabled();
+  }
+
+
+  std::set<triton::uint32> API::getTaintLabels(triton::uint64 addr, triton::uint32 size) {
+    this->checkTaint();
+    return this->taint->getTaintLabels(addr, size);
+  }
+
+
+  std::set<triton::uint32> API::getTaintLabels(const triton::arch::MemoryOperand& mem) {
+    this->checkTaint();
+    return this->taint->getTaintLabels(mem);
+  }
+
+
+  std::set<triton::uint32> API::getTaintLabels(const triton::arch::RegisterOperand& reg) {
+    this->checkTaint();
+    return this->taint->getTaintLabels(reg);
+  }
+
+
   bool API::untaintMemory(triton::uint64 addr) {
     this->checkTaint();
     return this->taint->untaintMemory(addr);
@@ -202,7 +202,9 @@ namespace triton {
         std::set<triton::ast::AbstractNode*> uniqueNodes;
         std::vector<triton::engines::symbolic::SymbolicExpression*>::iterator it;
         for (it = inst.symbolicExpressions.begin(); it != inst.symbolicExpressions.end(); it++) {
-          triton::api.extractUniqueAstNodes(uniqueNodes, (*it)->getAst());
+          /* A lazy expression has no AST to free */
+          if (!(*it)->isLazy())
+            triton::api.extractUniqueAstNodes(uniqueNodes, (*it)->getAst());
           triton::api.removeSymbolicExpression((*it)->getId());
         }
 
@@ -226,7 +228,8 @@ namespace triton {
         std::vector<triton::engines::symbolic::SymbolicExpression*>::iterator it;
         for (it = inst.symbolicExpressions.begin(); it != inst.symbolicExpressions.end(); it++) {
           if ((*it)->isTainted == triton::engines::taint::UNTAINTED) {
-            triton::api.extractUniqueAstNodes(uniqueNodes, (*it)->getAst());
+            if (!(*it)->isLazy())
+              triton::api.extractUniqueAstNodes(uniqueNodes, (*it)->getAst());
             triton::api.removeSymbolicExpression((*it)->getId());
           }
           else
@@ -251,8 +254,9 @@ namespace triton {
         std::vector<triton::engines::symbolic::SymbolicExpression*> newVector;
         std::vector<triton::engines::symbolic::SymbolicExpression*>::iterator it;
         for (it = inst.symbolicExpressions.begin(); it != inst.symbolicExpressions.end(); it++) {
-          if ((*it)->getAst()->isSymbolized() == false) {
-            triton::api.extractUniqueAstNodes(uniqueNodes, (*it)->getAst());
+          if ((*it)->isSymbolized() == false) {
+            if (!(*it)->isLazy())
+              triton::api.extractUniqueAstNodes(uniqueNodes, (*it)->getAst());
             triton::api.removeSymbolicExpression((*it)->getId());
           }
           else
@@ -291,6 +295,13 @@ namespace triton {
     }
 
 
+    const triton::uint8* Architecture::getConcreteMemoryAreaView(triton::uint64 baseAddr, triton::usize& size) const {
+      if (!this->cpu)
+        throw std::runtime_error("Architecture::getConcreteMemoryAreaView(): You must define an architecture.");
+      return this->cpu->getConcreteMemoryAreaView(baseAddr, size);
+    }
+
+
     triton::uint512 Architecture::getConcreteRegisterValue(const triton::arch::RegisterOperand& reg) const {
       if (!this->cpu)
         throw std::runtime_error("Architecture::getConcreteRegisterValue(): You must define an architecture.");
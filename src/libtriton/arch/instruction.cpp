@@ -45,20 +45,24 @@ namespace triton {
 
 
     void Instruction::copy(const Instruction& other) {
-      this->address             = other.address;
-      this->branch              = other.branch;
-      this->conditionTaken      = other.conditionTaken;
-      this->controlFlow         = other.controlFlow;
-      this->loadAccess          = other.loadAccess;
-      this->memoryAccess        = other.memoryAccess;
-      this->operands            = other.operands;
-      this->prefix              = other.prefix;
-      this->registerState       = other.registerState;
-      this->size                = other.size;
-      this->storeAccess         = other.storeAccess;
-      this->symbolicExpressions = other.symbolicExpressions;
-      this->tid                 = other.tid;
-      this->type                = other.type;
+      this->address              = other.address;
+      this->branch               = other.branch;
+      this->conditionTaken       = other.conditionTaken;
+      this->controlFlow          = other.controlFlow;
+      this->lazyWrittenRegisters = other.lazyWrittenRegisters;
+      this->loadAccess           = other.loadAccess;
+      this->memoryAccess         = other.memoryAccess;
+      this->operands             = other.operands;
+      this->prefix               = other.prefix;
+      this->readImmediates       = other.readImmediates;
+      this->readRegisters        = other.readRegisters;
+      this->registerState        = other.registerState;
+      this->size                 = other.size;
+      this->storeAccess          = other.storeAccess;
+      this->symbolicExpressions  = other.symbolicExpressions;
+      this->tid                  = other.tid;
+      this->type                 = other.type;
+      this->writtenRegisters     = other.writtenRegisters;
 
       std::memcpy(this->opcodes, other.opcodes, sizeof(this->opcodes));
 
@@ -141,6 +145,10 @@ namespace triton {
 
 
     const std::set<std::pair<triton::arch::RegisterOperand, triton::ast::AbstractNode*>>& Instruction::getWrittenRegisters(void) const {
+      std::set<std::pair<triton::arch::RegisterOperand, triton::engines::symbolic::SymbolicExpression*>>::const_iterator it;
+      for (it = this->lazyWrittenRegisters.begin(); it != this->lazyWrittenRegisters.end(); it++)
+        this->writtenRegisters.insert(std::make_pair(it->first, it->second->getAst()));
+      this->lazyWrittenRegisters.clear();
       return this->writtenRegisters;
     }
 
@@ -150,6 +158,28 @@ namespace triton {
     }
 
 
+    void Instruction::extractAstNodes(std::vector<triton::ast::AbstractNode*>& nodes) const {
+      std::set<std::pair<triton::arch::MemoryOperand, triton::ast::AbstractNode*>>::const_iterator it1;
+      std::set<std::pair<triton::arch::RegisterOperand, triton::ast::AbstractNode*>>::const_iterator it2;
+      std::set<std::pair<triton::arch::ImmediateOperand, triton::ast::AbstractNode*>>::const_iterator it3;
+
+      for (it1 = this->loadAccess.begin(); it1 != this->loadAccess.end(); it1++)
+        nodes.push_back(it1->second);
+
+      for (it1 = this->storeAccess.begin(); it1 != this->storeAccess.end(); it1++)
+        nodes.push_back(it1->second);
+
+      for (it2 = this->readRegisters.begin(); it2 != this->readRegisters.end(); it2++)
+        nodes.push_back(it2->second);
+
+      for (it2 = this->writtenRegisters.begin(); it2 != this->writtenRegisters.end(); it2++)
+        nodes.push_back(it2->second);
+
+      for (it3 = this->readImmediates.begin(); it3 != this->readImmediates.end(); it3++)
+        nodes.push_back(it3->second);
+    }
+
+
     void Instruction::updateContext(const triton::arch::MemoryOperand& mem) {
       this->memoryAccess.push_back(mem);
     }
@@ -203,6 +233,24 @@ namespace triton {
     }
 
 
+    void Instruction::setLazyWrittenRegister(const triton::arch::RegisterOperand& reg, triton::engines::symbolic::SymbolicExpression* se) {
+      this->lazyWrittenRegisters.insert(std::make_pair(reg, se));
+    }
+
+
+    void Instruction::concretizeLazyWrittenRegister(const triton::engines::symbolic::SymbolicExpression* se) {
+      /* The register holds the concrete value of the flag */
+      std::set<std::pair<triton::arch::RegisterOperand, triton::engines::symbolic::SymbolicExpression*>>::iterator it;
+      for (it = this->lazyWrittenRegisters.begin(); it != this->lazyWrittenRegisters.end(); it++) {
+        if (it->second == se) {
+          this->writtenRegisters.insert(std::make_pair(it->first, triton::ast::bv(it->first.getConcreteValue(), it->first.getBitSize())));
+          this->lazyWrittenRegisters.erase(it);
+          return;
+        }
+      }
+    }
+
+
     void Instruction::setReadImmediate(const triton::arch::ImmediateOperand& imm, triton::ast::AbstractNode* node) {
       this->readImmediates.insert(std::make_pair(imm, node));
     }
@@ -337,6 +385,7 @@ namespace triton {
       this->readImmediates.clear();
       this->readRegisters.clear();
       this->storeAccess.clear();
+      this->lazyWrittenRegisters.clear();
       this->symbolicExpressions.clear();
       this->writtenRegisters.clear();
 
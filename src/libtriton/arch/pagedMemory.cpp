@@ -0,0 +1,352 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+#include <pagedMemory.hpp>
+
+
+
+namespace triton {
+  namespace arch {
+
+    MemoryPage::MemoryPage() {
+      std::memset(this->data, 0x00, sizeof(this->data));
+      std::memset(this->mapped, 0x00, sizeof(this->mapped));
+      this->count = 0;
+    }
+
+
+    MemoryRadixNode::MemoryRadixNode() {
+      std::memset(this->slots, 0x00, sizeof(this->slots));
+      this->count = 0;
+    }
+
+
+    PagedMemory::PagedMemory(triton::uint32 addressSize) {
+      if (addressSize <= MEMORY_PAGE_BITS || addressSize > QWORD_SIZE_BIT)
+        throw std::runtime_error("PagedMemory::PagedMemory(): Invalid address size.");
+
+      this->root          = nullptr;
+      this->levels        = (addressSize - MEMORY_PAGE_BITS + MEMORY_RADIX_BITS - 1) / MEMORY_RADIX_BITS;
+      this->numberOfPages = 0;
+      this->lastPageBase  = 0;
+      this->lastPage      = nullptr;
+    }
+
+
+    PagedMemory::PagedMemory(const PagedMemory& copy) {
+      this->levels        = copy.levels;
+      this->root          = copy.copyRadixNode(copy.root, 0);
+      this->numberOfPages = copy.numberOfPages;
+      this->lastPageBase  = 0;
+      this->lastPage      = nullptr;
+    }
+
+
+    PagedMemory::~PagedMemory() {
+      this->clear();
+    }
+
+
+    void PagedMemory::operator=(const PagedMemory& copy) {
+      if (this == &copy)
+        return;
+      this->clear();
+      this->levels        = copy.levels;
+      this->root          = copy.copyRadixNode(copy.root, 0);
+      this->numberOfPages = copy.numberOfPages;
+    }
+
+
+    void PagedMemory::clear(void) {
+      this->freeRadixNode(this->root, 0);
+      this->root          = nullptr;
+      this->numberOfPages = 0;
+      this->lastPageBase  = 0;
+      this->lastPage      = nullptr;
+    }
+
+
+    triton::uint32 PagedMemory::getRadixIndex(triton::uint64 addr, triton::uint32 level) const {
+      /* The first level resolves the most significant bits of the page number */
+      triton::uint32 shift = MEMORY_PAGE_BITS + (this->levels - 1 - level) * MEMORY_RADIX_BITS;
+      return static_cast<triton::uint32>((addr >> shift) & (MEMORY_RADIX_SLOTS - 1));
+    }
+
+
+    MemoryRadixNode* PagedMemory::copyRadixNode(const MemoryRadixNode* node, triton::uint32 level) const {
+      if (node == nullptr)
+        return nullptr;
+
+      MemoryRadixNode* ret = new MemoryRadixNode();
+      ret->count = node->count;
+
+      for (triton::uint32 index = 0; index < MEMORY_RADIX_SLOTS; index++) {
+        if (node->slots[index] == nullptr)
+          continue;
+        if (level + 1 == this->levels)
+          ret->slots[index] = new MemoryPage(*static_cast<const MemoryPage*>(node->slots[index]));
+        else
+          ret->slots[index] = this->copyRadixNode(static_cast<const MemoryRadixNode*>(node->slots[index]), level + 1);
+      }
+
+      return ret;
+    }
+
+
+    void PagedMemory::freeRadixNode(MemoryRadixNode* node, triton::uint32 level) const {
+      if (node == nullptr)
+        return;
+
+      for (triton::uint32 index = 0; index < MEMORY_RADIX_SLOTS && node->count; index++) {
+        if (node->slots[index] == nullptr)
+          continue;
+        if (level + 1 == this->levels)
+          delete static_cast<MemoryPage*>(node->slots[index]);
+        else
+          this->freeRadixNode(static_cast<MemoryRadixNode*>(node->slots[index]), level + 1);
+        node->count--;
+      }
+
+      delete node;
+    }
+
+
+    MemoryPage* PagedMemory::findPage(triton::uint64 addr) const {
+      triton::uint64 base = addr & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK);
+      void* slot = this->root;
+
+      if (this->lastPage != nullptr && this->lastPageBase == base)
+        return this->lastPage;
+
+      for (triton::uint32 level = 0; level < this->levels && slot != nullptr; level++)
+        slot = static_cast<MemoryRadixNode*>(slot)->slots[this->getRadixIndex(addr, level)];
+
+      if (slot == nullptr)
+        return nullptr;
+
+      this->lastPageBase = base;
+      this->lastPage     = static_cast<MemoryPage*>(slot);
+
+      return this->lastPage;
+    }
+
+
+    MemoryPage* PagedMemory::getPage(triton::uint64 addr) {
+      MemoryPage* page = this->findPage(addr);
+
+      if (page != nullptr)
+        return page;
+
+      if (this->root == nullptr)
+        this->root = new MemoryRadixNode();
+
+      MemoryRadixNode* node = this->root;
+      for (triton::uint32 level = 0; level < this->levels; level++) {
+        void*& slot = node->slots[this->getRadixIndex(addr, level)];
+
+        if (slot == nullptr) {
+          if (level + 1 == this->levels)
+            slot = new MemoryPage();
+          else
+            slot = new MemoryRadixNode();
+          node->count++;
+        }
+
+        if (level + 1 < this->levels)
+          node = static_cast<MemoryRadixNode*>(slot);
+        else
+          page = static_cast<MemoryPage*>(slot);
+      }
+
+      this->numberOfPages++;
+      this->lastPageBase = addr & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK);
+      this->lastPage     = page;
+
+      return page;
+    }
+
+
+    void PagedMemory::removePage(triton::uint64 addr) {
+      MemoryRadixNode* path[MEMORY_RADIX_MAX_LEVELS];
+      MemoryRadixNode* node = this->root;
+
+      /* Record the path to the page */
+      for (triton::uint32 level = 0; level < this->levels; level++) {
+        if (node == nullptr)
+          return;
+        path[level] = node;
+        if (level + 1 < this->levels)
+          node = static_cast<MemoryRadixNode*>(node->slots[this->getRadixIndex(addr, level)]);
+      }
+
+      void*& slot = path[this->levels - 1]->slots[this->getRadixIndex(addr, this->levels - 1)];
+      if (slot == nullptr)
+        return;
+
+      if (this->lastPage == slot)
+        this->lastPage = nullptr;
+
+      delete static_cast<MemoryPage*>(slot);
+      this->numberOfPages--;
+
+      /* Free the nodes which became empty, from the leaf up to the root */
+      for (triton::uint32 level = this->levels; level-- > 0;) {
+        path[level]->slots[this->getRadixIndex(addr, level)] = nullptr;
+        if (--path[level]->count != 0)
+          return;
+        delete path[level];
+      }
+
+      this->root = nullptr;
+    }
+
+
+    triton::uint8 PagedMemory::getByte(triton::uint64 addr) const {
+      const MemoryPage* page = this->findPage(addr);
+
+      if (page == nullptr)
+        return 0x00;
+
+      return page->data[addr & MEMORY_PAGE_MASK];
+    }
+
+
+    void PagedMemory::read(triton::uint64 addr, triton::uint8* area, triton::usize size) const {
+      while (size) {
+        triton::usize offset = addr & MEMORY_PAGE_MASK;
+        triton::usize chunk  = std::min<triton::usize>(size, MEMORY_PAGE_SIZE - offset);
+        const MemoryPage* page = this->findPage(addr);
+
+        if (page == nullptr)
+          std::memset(area, 0x00, chunk);
+        else
+          std::memcpy(area, page->data + offset, chunk);
+
+        addr += chunk;
+        area += chunk;
+        size -= chunk;
+      }
+    }
+
+
+    const triton::uint8* PagedMemory::getView(triton::uint64 addr, triton::usize& size) const {
+      triton::usize offset = addr & MEMORY_PAGE_MASK;
+      const MemoryPage* page = this->findPage(addr);
+
+      if (page == nullptr) {
+        size = 0;
+        return nullptr;
+      }
+
+      size = MEMORY_PAGE_SIZE - offset;
+      return page->data + offset;
+    }
+
+
+    void PagedMemory::setByte(triton::uint64 addr, triton::uint8 value) {
+      triton::usize offset = addr & MEMORY_PAGE_MASK;
+      MemoryPage* page = this->getPage(addr);
+      triton::uint8 bit = static_cast<triton::uint8>(1 << (offset & 7));
+
+      if (!(page->mapped[offset >> 3] & bit)) {
+        page->mapped[offset >> 3] |= bit;
+        page->count++;
+      }
+
+      page->data[offset] = value;
+    }
+
+
+    void PagedMemory::write(triton::uint64 addr, const triton::uint8* area, triton::usize size) {
+      while (size) {
+        triton::usize offset = addr & MEMORY_PAGE_MASK;
+        triton::usize chunk  = std::min<triton::usize>(size, MEMORY_PAGE_SIZE - offset);
+        MemoryPage* page = this->getPage(addr);
+
+        std::memcpy(page->data + offset, area, chunk);
+
+        if (chunk == MEMORY_PAGE_SIZE) {
+          std::memset(page->mapped, 0xff, sizeof(page->mapped));
+          page->count = MEMORY_PAGE_SIZE;
+        }
+
+        else if (page->count != MEMORY_PAGE_SIZE) {
+          for (triton::usize index = offset; index < offset + chunk; index++) {
+            triton::uint8 bit = static_cast<triton::uint8>(1 << (index & 7));
+            if (!(page->mapped[index >> 3] & bit)) {
+              page->mapped[index >> 3] |= bit;
+              page->count++;
+            }
+          }
+        }
+
+        addr += chunk;
+        area += chunk;
+        size -= chunk;
+      }
+    }
+
+
+    bool PagedMemory::isMapped(triton::uint64 addr, triton::usize size) const {
+      while (size) {
+        triton::usize offset = addr & MEMORY_PAGE_MASK;
+        triton::usize chunk  = std::min<triton::usize>(size, MEMORY_PAGE_SIZE - offset);
+        const MemoryPage* page = this->findPage(addr);
+
+        if (page == nullptr)
+          return false;
+
+        if (page->count != MEMORY_PAGE_SIZE) {
+          for (triton::usize index = offset; index < offset + chunk; index++) {
+            if (!(page->mapped[index >> 3] & (1 << (index & 7))))
+              return false;
+          }
+        }
+
+        addr += chunk;
+        size -= chunk;
+      }
+      return true;
+    }
+
+
+    void PagedMemory::unmap(triton::uint64 addr, triton::usize size) {
+      while (size) {
+        triton::usize offset = addr & MEMORY_PAGE_MASK;
+        triton::usize chunk  = std::min<triton::usize>(size, MEMORY_PAGE_SIZE - offset);
+        MemoryPage* page     = this->findPage(addr);
+
+        if (page != nullptr) {
+          for (triton::usize index = offset; index < offset + chunk; index++) {
+            triton::uint8 bit = static_cast<triton::uint8>(1 << (index & 7));
+            if (page->mapped[index >> 3] & bit) {
+              page->mapped[index >> 3] &= ~bit;
+              page->data[index] = 0x00;
+              page->count--;
+            }
+          }
+
+          if (page->count == 0)
+            this->removePage(addr);
+        }
+
+        addr += chunk;
+        size -= chunk;
+      }
+    }
+
+
+    triton::usize PagedMemory::getNumberOfPages(void) const {
+      return this->numberOfPages;
+    }
+
+  }; /* arch namespace */
+}; /* triton namespace */
@@ -26,17 +26,23 @@ namespace triton {
     namespace x86 {
 
       x8664Cpu::x8664Cpu() {
+        this->handle = 0;
         this->clear();
       }
 
 
       x8664Cpu::x8664Cpu(const x8664Cpu& other) {
+        this->handle = 0;
         this->copy(other);
       }
 
 
       x8664Cpu::~x8664Cpu() {
         this->memory.clear();
+        if (this->handle) {
+          triton::extlibs::capstone::csh handle = this->handle;
+          triton::extlibs::capstone::cs_close(&handle);
+        }
       }
 
 
@@ -648,78 +654,79 @@ namespace triton {
         triton::extlibs::capstone::csh       handle;
         triton::extlibs::capstone::cs_insn*  insn;
         triton::usize                        count = 0;
+        const DecodedInstruction*            decoded = nullptr;
 
         /* Check if the opcodes and opcodes' size are defined */
         if (inst.getOpcodes() == nullptr || inst.getSize() == 0)
           throw std::runtime_error("x8664Cpu::disassembly(): Opcodes and opcodesSize must be definied.");
 
-        /* Open capstone */
-        if (triton::extlibs::capstone::cs_open(triton::extlibs::capstone::CS_ARCH_X86, triton::extlibs::capstone::CS_MODE_64, &handle) != triton::extlibs::capstone::CS_ERR_OK)
-          throw std::runtime_error("x8664Cpu::disassembly(): Cannot open capstone.");
+        /* Skip capstone if these opcodes have already been decoded at this address */
+        decoded = this->decodeCache.find(inst);
+        if (decoded != nullptr) {
+          this->decodeCache.apply(*decoded, inst);
+          return;
+        }
 
-        /* Init capstone's options */
-        triton::extlibs::capstone::cs_option(handle, triton::extlibs::capstone::CS_OPT_DETAIL, triton::extlibs::capstone::CS_OPT_ON);
-        triton::extlibs::capstone::cs_option(handle, triton::extlibs::capstone::CS_OPT_SYNTAX, triton::extlibs::capstone::CS_OPT_SYNTAX_INTEL);
+        /* Open capstone once for the lifetime of the CPU */
+        if (this->handle == 0) {
+          if (triton::extlibs::capstone::cs_open(triton::extlibs::capstone::CS_ARCH_X86, triton::extlibs::capstone::CS_MODE_64, &handle) != triton::extlibs::capstone::CS_ERR_OK)
+            throw std::runtime_error("x8664Cpu::disassembly(): Cannot open capstone.");
+
+          /* Init capstone's options */
+          triton::extlibs::capstone::cs_option(handle, triton::extlibs::capstone::CS_OPT_DETAIL, triton::extlibs::capstone::CS_OPT_ON);
+          triton::extlibs::capstone::cs_option(handle, triton::extlibs::capstone::CS_OPT_SYNTAX, triton::extlibs::capstone::CS_OPT_SYNTAX_INTEL);
+          this->handle = handle;
+        }
+        handle = this->handle;
 
         /* Let's disass and build our operands */
         count = triton::extlibs::capstone::cs_disasm(handle, inst.getOpcodes(), inst.getSize(), inst.getAddress(), 0, &insn);
         if (count > 0) {
+          DecodedInstruction entry;
           triton::extlibs::capstone::cs_detail* detail = insn->detail;
           for (triton::uint32 j = 0; j < 1; j++) {
 
             /* Init the disassembly */
             std::stringstream str;
             str << insn[j].mnemonic << " " <<  insn[j].op_str;
-            inst.setDisassembly(str.str());
+            entry.disassembly = str.str();
 
             /* Refine the size */
-            inst.setSize(insn[j].size);
+            entry.opcodes.assign(inst.getOpcodes(), inst.getOpcodes() + insn[j].size);
 
             /* Init the instruction's type */
-            inst.setType(triton::arch::x86::capstoneInstructionToTritonInstruction(insn[j].id));
+            entry.type = triton::arch::x86::capstoneInstructionToTritonInstruction(insn[j].id);
 
             /* Init the instruction's prefix */
-            inst.setPrefix(triton::arch::x86::capstonePrefixToTritonPrefix(detail->x86.prefix[0]));
+            entry.prefix = triton::arch::x86::capstonePrefixToTritonPrefix(detail->x86.prefix[0]);
 
             /* Init operands */
             for (triton::uint32 n = 0; n < detail->x86.op_count; n++) {
               triton::extlibs::capstone::cs_x86_op* op = &(detail->x86.operands[n]);
+              DecodedOperand operand;
+              operand.size = op->size;
               switch(op->type) {
 
                 case triton::extlibs::capstone::X86_OP_IMM:
-                  inst.operands.push_back(triton::arch::OperandWrapper(triton::arch::ImmediateOperand(op->imm, op->size)));
+                  operand.type  = triton::arch::OP_IMM;
+                  operand.value = op->imm;
+                  entry.operands.push_back(operand);
                   break;
 
-                case triton::extlibs::capstone::X86_OP_MEM: {
-                  triton::arch::MemoryOperand mem = inst.popMemoryAccess();
-
-                  /* Set the size if the memory is not valid */
-                  if (!mem.isValid())
-                    mem.setPair(std::make_pair(((op->size * BYTE_SIZE_BIT) - 1), 0));
-
-                  /* LEA if exists */
-                  triton::arch::RegisterOperand segment(triton::arch::x86::capstoneRegisterToTritonRegister(op->mem.segment));
-                  triton::arch::RegisterOperand base(triton::arch::x86::capstoneRegisterToTritonRegister(op->mem.base));
-                  triton::arch::RegisterOperand index(triton::arch::x86::capstoneRegisterToTritonRegister(op->mem.index));
-                  triton::arch::ImmediateOperand disp(op->mem.disp, base.isValid() ? base.getSize() : index.isValid() ? index.getSize() : op->size);
-                  triton::arch::ImmediateOperand scale(op->mem.scale, base.isValid() ? base.getSize() : index.isValid() ? index.getSize() : op->size);
-
-                  /* Specify that LEA contains a PC relative */
-                  if (base.getId() == TRITON_X86_REG_PC.getId())
-                    mem.setPcRelative(inst.getNextAddress());
-
-                  mem.setSegmentRegister(segment);
-                  mem.setBaseRegister(base);
-                  mem.setIndexRegister(index);
-                  mem.setDisplacement(disp);
-                  mem.setScale(scale);
-
-                  inst.operands.push_back(triton::arch::OperandWrapper(mem));
+                case triton::extlibs::capstone::X86_OP_MEM:
+                  operand.type    = triton::arch::OP_MEM;
+                  operand.segment = triton::arch::x86::capstoneRegisterToTritonRegister(op->mem.segment);
+                  operand.reg     = triton::arch::x86::capstoneRegisterToTritonRegister(op->mem.base);
+                  operand.index   = triton::arch::x86::capstoneRegisterToTritonRegister(op->mem.index);
+                  operand.value   = op->mem.disp;
+                  operand.scale   = op->mem.scale;
+                  entry.operands.push_back(operand);
                   break;
-                }
 
                 case triton::extlibs::capstone::X86_OP_REG:
-                  inst.operands.push_back(triton::arch::OperandWrapper(inst.getRegisterState(triton::arch::x86::capstoneRegisterToTritonRegister(op->reg))));
+                  operand.type = triton::arch::OP_REG;
+                  operand.reg  = triton::arch::x86::capstoneRegisterToTritonRegister(op->reg);
+                  entry.operands.push_back(operand);
                   break;
 
                 default:
@@ -732,21 +739,21 @@ namespace triton {
           if (detail->groups_count > 0) {
             for (triton::uint32 n = 0; n < detail->groups_count; n++) {
               if (detail->groups[n] == triton::extlibs::capstone::X86_GRP_JUMP)
-                inst.setBranch(true);
+                entry.branch = true;
               if (detail->groups[n] == triton::extlibs::capstone::X86_GRP_JUMP ||
                   detail->groups[n] == triton::extlibs::capstone::X86_GRP_CALL ||
                   detail->groups[n] == triton::extlibs::capstone::X86_GRP_RET)
-                inst.setControlFlow(true);
+                entry.controlFlow = true;
             }
           }
           /* Free capstone stuffs */
           triton::extlibs::capstone::cs_free(insn, count);
+
+          /* Init the instruction from what capstone said */
+          this->decodeCache.apply(this->decodeCache.insert(inst, entry), inst);
         }
         else
           throw std::runtime_error("x8664Cpu::disassembly(): Failed to disassemble the given code.");
-
-        triton::extlibs::capstone::cs_close(&handle);
-        return;
       }
 
 
@@ -758,9 +765,7 @@ namespace triton {
 
 
       triton::uint8 x8664Cpu::getConcreteMemoryValue(triton::uint64 addr) const {
-        if (this->memory.find(addr) == this->memory.end())
-          return 0x00;
-        return this->memory.at(addr);
+        return this->memory.getByte(addr);
       }
 
 
@@ -768,27 +773,34 @@ namespace triton {
         triton::uint512 ret = 0;
         triton::uint64 addr = mem.getAddress();
         triton::uint32 size = mem.getSize();
+        triton::uint8 area[DQQWORD_SIZE];
 
         if (size == 0 || size > DQQWORD_SIZE)
           throw std::invalid_argument("x8664Cpu::getConcreteMemoryValue(): Invalid size memory.");
 
+        this->memory.read(addr, area, size);
         for (triton::sint32 i = size-1; i >= 0; i--)
-          ret = ((ret << BYTE_SIZE_BIT) | this->getConcreteMemoryValue(addr+i));
+          ret = ((ret << BYTE_SIZE_BIT) | area[i]);
 
         return ret;
       }
 
 
       std::vector<triton::uint8> x8664Cpu::getConcreteMemoryAreaValue(triton::uint64 baseAddr, triton::usize size) const {
-        std::vector<triton::uint8> area;
+        std::vector<triton::uint8> area(size);
 
-        for (triton::usize index = 0; index < size; index++)
-          area.push_back(this->getConcreteMemoryValue(baseAddr+index));
+        if (size)
+          this->memory.read(baseAddr, area.data(), size);
 
         return area;
       }
 
 
+      const triton::uint8* x8664Cpu::getConcreteMemoryAreaView(triton::uint64 baseAddr, triton::usize& size) const {
+        return this->memory.getView(baseAddr, size);
+      }
+
+
       triton::uint512 x8664Cpu::getConcreteRegisterValue(const triton::arch::RegisterOperand& reg) const {
         triton::uint512 value = 0;
         switch (reg.getId()) {
@@ -1020,7 +1032,7 @@ namespace triton {
 
 
       void x8664Cpu::setConcreteMemoryValue(triton::uint64 addr, triton::uint8 value) {
-        this->memory[addr] = value;
+        this->memory.setByte(addr, value);
       }
 
 
@@ -1032,24 +1044,25 @@ namespace triton {
         if (size == 0 || size > DQQWORD_SIZE)
           throw std::invalid_argument("x8664Cpu::setConcreteMemoryValue(): Invalid size memory.");
 
+        triton::uint8 area[DQQWORD_SIZE];
+
         for (triton::uint32 i = 0; i < size; i++) {
-          this->memory[addr+i] = (cv & 0xff).convert_to<triton::uint8>();
+          area[i] = (cv & 0xff).convert_to<triton::uint8>();
           cv >>= 8;
         }
+
+        this->memory.write(addr, area, size);
       }
 
 
       void x8664Cpu::setConcreteMemoryAreaValue(triton::uint64 baseAddr, const std::vector<triton::uint8>& values) {
-        for (triton::usize index = 0; index < values.size(); index++) {
-          this->memory[baseAddr+index] = values[index];
-        }
+        if (values.size())
+          this->memory.write(baseAddr, values.data(), values.size());
       }
 
 
       void x8664Cpu::setConcreteMemoryAreaValue(triton::uint64 baseAddr, const triton::uint8* area, triton::usize size) {
-        for (triton::usize index = 0; index < size; index++) {
-          this->memory[baseAddr+index] = area[index];
-        }
+        this->memory.write(baseAddr, area, size);
       }
 
 
@@ -1383,19 +1396,12 @@ namespace triton {
 
 
       bool x8664Cpu::isMemoryMapped(triton::uint64 baseAddr, triton::usize size) {
-        for (triton::usize index = 0; index < size; index++) {
-          if (this->memory.find(baseAddr + index) == this->memory.end())
-            return false;
-        }
-        return true;
+        return this->memory.isMapped(baseAddr, size);
       }
 
 
       void x8664Cpu::unmapMemory(triton::uint64 baseAddr, triton::usize size) {
-        for (triton::usize index = 0; index < size; index++) {
-          if (this->memory.find(baseAddr + index) != this->memory.end())
-            this->memory.erase(baseAddr + index);
-        }
+        this->memory.unmap(baseAddr, size);
       }
 
     }; /* x86 namespace */
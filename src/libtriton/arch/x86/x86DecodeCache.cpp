@@ -0,0 +1,144 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <cstring>
+#include <stdexcept>
+
+#include <cpuSize.hpp>
+#include <immediateOperand.hpp>
+#include <memoryOperand.hpp>
+#include <operandWrapper.hpp>
+#include <registerOperand.hpp>
+#include <x86DecodeCache.hpp>
+#include <x86Specifications.hpp>
+
+
+
+namespace triton {
+  namespace arch {
+    namespace x86 {
+
+      DecodedOperand::DecodedOperand() {
+        this->type    = 0;
+        this->size    = 0;
+        this->value   = 0;
+        this->reg     = triton::arch::x86::ID_REG_INVALID;
+        this->segment = triton::arch::x86::ID_REG_INVALID;
+        this->index   = triton::arch::x86::ID_REG_INVALID;
+        this->scale   = 0;
+      }
+
+
+      DecodedInstruction::DecodedInstruction() {
+        this->type        = 0;
+        this->prefix      = 0;
+        this->branch      = false;
+        this->controlFlow = false;
+      }
+
+
+      const DecodedInstruction* DecodeCache::find(const triton::arch::Instruction& inst) const {
+        auto it = this->instructions.find(inst.getAddress());
+
+        if (it == this->instructions.end())
+          return nullptr;
+
+        /* The bytes at this address have changed */
+        const std::vector<triton::uint8>& opcodes = it->second.opcodes;
+        if (inst.getSize() < opcodes.size() || std::memcmp(inst.getOpcodes(), opcodes.data(), opcodes.size()) != 0)
+          return nullptr;
+
+        return &it->second;
+      }
+
+
+      const DecodedInstruction& DecodeCache::insert(const triton::arch::Instruction& inst, const DecodedInstruction& decoded) {
+        DecodedInstruction& entry = this->instructions[inst.getAddress()];
+        entry = decoded;
+        return entry;
+      }
+
+
+      void DecodeCache::apply(const DecodedInstruction& decoded, triton::arch::Instruction& inst) const {
+        /* Init the disassembly */
+        inst.setDisassembly(decoded.disassembly);
+
+        /* Refine the size */
+        inst.setSize(static_cast<triton::uint32>(decoded.opcodes.size()));
+
+        /* Init the instruction's type */
+        inst.setType(decoded.type);
+
+        /* Init the instruction's prefix */
+        inst.setPrefix(decoded.prefix);
+
+        /* Init operands */
+        for (auto op = decoded.operands.begin(); op != decoded.operands.end(); op++) {
+          switch (op->type) {
+
+            case triton::arch::OP_IMM:
+              inst.operands.push_back(triton::arch::OperandWrapper(triton::arch::ImmediateOperand(op->value, op->size)));
+              break;
+
+            case triton::arch::OP_MEM: {
+              triton::arch::MemoryOperand mem = inst.popMemoryAccess();
+
+              /* Set the size if the memory is not valid */
+              if (!mem.isValid())
+                mem.setPair(std::make_pair(((op->size * BYTE_SIZE_BIT) - 1), 0));
+
+              /* LEA if exists */
+              triton::arch::RegisterOperand segment(op->segment);
+              triton::arch::RegisterOperand base(op->reg);
+              triton::arch::RegisterOperand index(op->index);
+              triton::arch::ImmediateOperand disp(op->value, base.isValid() ? base.getSize() : index.isValid() ? index.getSize() : op->size);
+              triton::arch::ImmediateOperand scale(op->scale, base.isValid() ? base.getSize() : index.isValid() ? index.getSize() : op->size);
+
+              /* Specify that LEA contains a PC relative */
+              if (base.getId() == TRITON_X86_REG_PC.getId())
+                mem.setPcRelative(inst.getNextAddress());
+
+              mem.setSegmentRegister(segment);
+              mem.setBaseRegister(base);
+              mem.setIndexRegister(index);
+              mem.setDisplacement(disp);
+              mem.setScale(scale);
+
+              inst.operands.push_back(triton::arch::OperandWrapper(mem));
+              break;
+            }
+
+            case triton::arch::OP_REG:
+              inst.operands.push_back(triton::arch::OperandWrapper(inst.getRegisterState(op->reg)));
+              break;
+
+            default:
+              throw std::invalid_argument("DecodeCache::apply(): Invalid operand.");
+          }
+        }
+
+        /* Set branch */
+        if (decoded.branch)
+          inst.setBranch(true);
+
+        if (decoded.controlFlow)
+          inst.setControlFlow(true);
+      }
+
+
+      void DecodeCache::clear(void) {
+        this->instructions.clear();
+      }
+
+
+      triton::usize DecodeCache::size(void) const {
+        return this->instructions.size();
+      }
+
+    }; /* x86 namespace */
+  }; /* arch namespace */
+}; /* triton namespace */
@@ -723,6 +723,277 @@ namespace triton {
         }
 
 
+        /*
+         * Flag semantics templates.
+         *
+         * The shape of the flags of the arithmetic and logical instructions only depends on the bounds of the
+         * destination and on the size of the operands. With the SEMANTICS_TEMPLATES optimization, each shape
+         * is built once as an AST template (see triton::ast::AstTemplate) and next executions instantiate it.
+         * The operands are given in `ops`: `ops[0]` is a reference to the parent expression, `ops[1]` and
+         * `ops[2]` are op1 and op2.
+         */
+
+        /* The templates of the flag semantics */
+        enum flag_template_e {
+          AF_TEMPLATE = 0,
+          CFADD_TEMPLATE,
+          CFSUB_TEMPLATE,
+          OFADD_TEMPLATE,
+          OFSUB_TEMPLATE,
+          PF_TEMPLATE,
+          SF_TEMPLATE,
+          ZF_TEMPLATE,
+        };
+
+        /* Builds the AST of a flag semantics */
+        typedef triton::ast::AbstractNode* (*flagBuilder)(const std::vector<triton::ast::AbstractNode*>& ops, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low);
+
+
+        static const triton::ast::AstTemplate* flagTemplate(flag_template_e id, flagBuilder build, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low, const std::vector<triton::ast::AbstractNode*>& ops) {
+          /* The key packs the template id and six sizes of 10 bits (sizes are at most 512 bits) */
+          triton::uint64 key = id;
+          key = (key << 10) | bvSize;
+          key = (key << 10) | high;
+          key = (key << 10) | low;
+          for (triton::uint32 index = 0; index < ops.size(); index++)
+            key = (key << 10) | ops[index]->getBitvectorSize();
+
+          const triton::ast::AstTemplate* tpl = triton::api.getAstTemplate(key);
+          if (tpl == nullptr) {
+            std::vector<triton::ast::AbstractNode*> holes;
+            for (triton::uint32 index = 0; index < ops.size(); index++)
+              holes.push_back(triton::api.newAstTemplateHole(ops[index]->getBitvectorSize()));
+            tpl = triton::api.recordAstTemplate(key, triton::ast::AstTemplate(build(holes, bvSize, high, low), holes));
+          }
+
+          return tpl;
+        }
+
+
+        static triton::ast::AbstractNode* flagNode(flag_template_e id, flagBuilder build, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low, const std::vector<triton::ast::AbstractNode*>& ops) {
+          if (!triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::SEMANTICS_TEMPLATES))
+            return build(ops, bvSize, high, low);
+          return flagTemplate(id, build, bvSize, high, low, ops)->instantiate(ops);
+        }
+
+
+        /* Returns the concrete value of a flag semantics, the same way as its builder but without any node */
+        static triton::uint512 flagValue(flag_template_e id, triton::uint32 high, triton::uint32 low, const std::vector<triton::ast::AbstractNode*>& ops) {
+          triton::uint512 one = 1;
+          triton::uint512 v0  = ops[0]->evaluate();
+          triton::uint512 v1  = (ops.size() > 1) ? ops[1]->evaluate() : 0;
+          triton::uint512 v2  = (ops.size() > 2) ? ops[2]->evaluate() : 0;
+          triton::uint512 res = (v0 >> low) & ((one << (high - low + 1)) - 1);
+          triton::uint512 node;
+
+          switch (id) {
+            case AF_TEMPLATE:
+              return ((0x10 & (res ^ v1 ^ v2)) == 0x10) ? 1 : 0;
+
+            case CFADD_TEMPLATE:
+              node = (v1 & v2) ^ ((v1 ^ v2 ^ res) & (v1 ^ v2));
+              break;
+
+            case CFSUB_TEMPLATE:
+              node = (v1 ^ (v2 ^ res)) ^ ((v1 ^ res) & (v1 ^ v2));
+              break;
+
+            case OFADD_TEMPLATE:
+              node = (v1 ^ (v2 ^ ((one << ops[2]->getBitvectorSize()) - 1))) & (v1 ^ res);
+              break;
+
+            case OFSUB_TEMPLATE:
+              node = (v1 ^ v2) & (v1 ^ res);
+              break;
+
+            case PF_TEMPLATE:
+              node = 1;
+              for (triton::uint32 counter = 0; counter <= BYTE_SIZE_BIT-1; counter++)
+                node ^= (res >> counter) & 1;
+              return node;
+
+            case SF_TEMPLATE:
+              node = v0;
+              break;
+
+            case ZF_TEMPLATE:
+              return (res == 0) ? 1 : 0;
+
+            default:
+              throw std::runtime_error("triton::arch::x86::semantics::flagValue(): Invalid flag template.");
+          }
+
+          return (node >> high) & 1;
+        }
+
+
+        /*
+         * Lazy flags.
+         *
+         * With the LAZY_FLAGS optimization, the AST of a flag is only built when the flag is read. The concrete
+         * value of the flag is still computed at once, from the template with SEMANTICS_TEMPLATES or directly
+         * otherwise, without allocating any node.
+         */
+        class LazyFlag : public triton::engines::symbolic::LazyAst {
+          protected:
+            flag_template_e id;
+            flagBuilder build_;
+            triton::uint32 bvSize;
+            triton::uint32 high;
+            triton::uint32 low;
+            std::vector<triton::ast::AbstractNode*> ops;
+
+          public:
+            LazyFlag(flag_template_e id, flagBuilder build, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low, const std::vector<triton::ast::AbstractNode*>& ops) {
+              this->id     = id;
+              this->build_ = build;
+              this->bvSize = bvSize;
+              this->high   = high;
+              this->low    = low;
+              this->ops    = ops;
+            }
+
+            triton::ast::AbstractNode* build(void) {
+              return flagNode(this->id, this->build_, this->bvSize, this->high, this->low, this->ops);
+            }
+
+            bool isSymbolized(void) const {
+              for (triton::uint32 index = 0; index < this->ops.size(); index++) {
+                if (this->ops[index]->isSymbolized())
+                  return true;
+              }
+              return false;
+            }
+
+            void extractRoots(std::vector<triton::ast::AbstractNode*>& roots) const {
+              roots.insert(roots.end(), this->ops.begin(), this->ops.end());
+            }
+        };
+
+
+        static triton::engines::symbolic::SymbolicExpression* flagExpression(triton::arch::Instruction& inst, flag_template_e id, flagBuilder build, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low, const std::vector<triton::ast::AbstractNode*>& ops, triton::arch::RegisterOperand& flag, const std::string& comment) {
+          std::vector<triton::uint512> values;
+
+          if (!triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::LAZY_FLAGS))
+            return triton::api.createSymbolicFlagExpression(inst, flagNode(id, build, bvSize, high, low, ops), flag, comment);
+
+          if (!triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::SEMANTICS_TEMPLATES)) {
+            triton::uint512 value = flagValue(id, high, low, ops);
+            return triton::api.createSymbolicLazyFlagExpression(inst, new LazyFlag(id, build, bvSize, high, low, ops), value, flag, comment);
+          }
+
+          for (triton::uint32 index = 0; index < ops.size(); index++)
+            values.push_back(ops[index]->evaluate());
+
+          triton::uint512 value = flagTemplate(id, build, bvSize, high, low, ops)->evaluate(values);
+          return triton::api.createSymbolicLazyFlagExpression(inst, new LazyFlag(id, build, bvSize, high, low, ops), value, flag, comment);
+        }
+
+
+        static triton::ast::AbstractNode* afNode(const std::vector<triton::ast::AbstractNode*>& ops, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low) {
+          return triton::ast::ite(
+                   triton::ast::equal(
+                     triton::ast::bv(0x10, bvSize),
+                     triton::ast::bvand(
+                       triton::ast::bv(0x10, bvSize),
+                       triton::ast::bvxor(
+                         triton::ast::extract(high, low, ops[0]),
+                         triton::ast::bvxor(ops[1], ops[2])
+                       )
+                     )
+                   ),
+                   triton::ast::bv(1, 1),
+                   triton::ast::bv(0, 1)
+                 );
+        }
+
+
+        static triton::ast::AbstractNode* cfAddNode(const std::vector<triton::ast::AbstractNode*>& ops, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low) {
+          return triton::ast::extract(high, high,
+                   triton::ast::bvxor(
+                     triton::ast::bvand(ops[1], ops[2]),
+                     triton::ast::bvand(
+                       triton::ast::bvxor(
+                         triton::ast::bvxor(ops[1], ops[2]),
+                         triton::ast::extract(high, low, ops[0])
+                       ),
+                     triton::ast::bvxor(ops[1], ops[2]))
+                   )
+                 );
+        }
+
+
+        static triton::ast::AbstractNode* cfSubNode(const std::vector<triton::ast::AbstractNode*>& ops, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low) {
+          auto res = triton::ast::extract(high, low, ops[0]);
+          return triton::ast::extract(high, high,
+                   triton::ast::bvxor(
+                     triton::ast::bvxor(ops[1], triton::ast::bvxor(ops[2], res)),
+                     triton::ast::bvand(
+                       triton::ast::bvxor(ops[1], res),
+                       triton::ast::bvxor(ops[1], ops[2])
+                     )
+                   )
+                 );
+        }
+
+
+        static triton::ast::AbstractNode* ofAddNode(const std::vector<triton::ast::AbstractNode*>& ops, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low) {
+          return triton::ast::extract(high, high,
+                   triton::ast::bvand(
+                     triton::ast::bvxor(ops[1], triton::ast::bvnot(ops[2])),
+                     triton::ast::bvxor(ops[1], triton::ast::extract(high, low, ops[0]))
+                   )
+                 );
+        }
+
+
+        static triton::ast::AbstractNode* ofSubNode(const std::vector<triton::ast::AbstractNode*>& ops, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low) {
+          return triton::ast::extract(high, high,
+                   triton::ast::bvand(
+                     triton::ast::bvxor(ops[1], ops[2]),
+                     triton::ast::bvxor(ops[1], triton::ast::extract(high, low, ops[0]))
+                   )
+                 );
+        }
+
+
+        static triton::ast::AbstractNode* pfNode(const std::vector<triton::ast::AbstractNode*>& ops, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low) {
+          auto res  = triton::ast::extract(high, low, ops[0]);
+          auto node = triton::ast::bv(1, 1);
+
+          for (triton::uint32 counter = 0; counter <= BYTE_SIZE_BIT-1; counter++) {
+            node = triton::ast::bvxor(
+                     node,
+                     triton::ast::extract(0, 0,
+                       triton::ast::bvlshr(
+                         res,
+                         triton::ast::bv(counter, BYTE_SIZE_BIT)
+                       )
+                    )
+                  );
+          }
+
+          return node;
+        }
+
+
+        static triton::ast::AbstractNode* sfNode(const std::vector<triton::ast::AbstractNode*>& ops, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low) {
+          return triton::ast::extract(high, high, ops[0]);
+        }
+
+
+        static triton::ast::AbstractNode* zfNode(const std::vector<triton::ast::AbstractNode*>& ops, triton::uint32 bvSize, triton::uint32 high, triton::uint32 low) {
+          return triton::ast::ite(
+                   triton::ast::equal(
+                     triton::ast::extract(high, low, ops[0]),
+                     triton::ast::bv(0, bvSize)
+                   ),
+                   triton::ast::bv(1, 1),
+                   triton::ast::bv(0, 1)
+                 );
+        }
+
+
         void af_s(triton::arch::Instruction& inst, triton::engines::symbolic::SymbolicExpression* parent, triton::arch::OperandWrapper& dst, triton::ast::AbstractNode* op1, triton::ast::AbstractNode* op2, bool vol) {
           auto bvSize = dst.getBitSize();
           auto low    = vol ? 0 : dst.getAbstractLow();
@@ -732,26 +1003,10 @@ namespace triton {
            * Create the semantic.
            * af = 0x10 == (0x10 & (regDst ^ op1 ^ op2))
            */
-          auto node = triton::ast::ite(
-                        triton::ast::equal(
-                          triton::ast::bv(0x10, bvSize),
-                          triton::ast::bvand(
-                            triton::ast::bv(0x10, bvSize),
-                            triton::ast::bvxor(
-                              triton::ast::extract(high, low, triton::ast::reference(parent->getId())),
-                              triton::ast::bvxor(op1, op2)
-                            )
-                          )
-                        ),
-                        triton::ast::bv(1, 1),
-                        triton::ast::bv(0, 1)
-                      );
-
-          /* Create the symbolic expression */
-          auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_AF, "Adjust flag");
+          auto expr = flagExpression(inst, AF_TEMPLATE, afNode, bvSize, high, low, {triton::ast::reference(parent->getId()), op1, op2}, TRITON_X86_REG_AF, "Adjust flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_AF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_AF, parent->isTainted);
         }
 
 
@@ -783,7 +1038,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_AF, "Adjust flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_AF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_AF, parent->isTainted);
         }
 
 
@@ -796,23 +1051,10 @@ namespace triton {
            * Create the semantic.
            * cf = MSB((op0 & op1) ^ ((op0 ^ op1 ^ parent) & (op0 ^ op1)));
            */
-          auto node = triton::ast::extract(high, high,
-                        triton::ast::bvxor(
-                          triton::ast::bvand(op1, op2),
-                          triton::ast::bvand(
-                            triton::ast::bvxor(
-                              triton::ast::bvxor(op1, op2),
-                              triton::ast::extract(high, low, triton::ast::reference(parent->getId()))
-                            ),
-                          triton::ast::bvxor(op1, op2))
-                        )
-                      );
-
-          /* Create the symbolic expression */
-          auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
+          auto expr = flagExpression(inst, CFADD_TEMPLATE, cfAddNode, bvSize, high, low, {triton::ast::reference(parent->getId()), op1, op2}, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -834,7 +1076,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -858,7 +1100,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -882,7 +1124,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -908,7 +1150,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -936,7 +1178,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -967,7 +1209,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -995,7 +1237,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -1024,7 +1266,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -1054,7 +1296,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -1084,7 +1326,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -1113,7 +1355,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -1126,21 +1368,10 @@ namespace triton {
            * Create the semantic.
            * cf = extract(bvSize, bvSize (((op1 ^ op2 ^ res) ^ ((op1 ^ res) & (op1 ^ op2)))))
            */
-          auto node = triton::ast::extract(high, high,
-                        triton::ast::bvxor(
-                          triton::ast::bvxor(op1, triton::ast::bvxor(op2, triton::ast::extract(high, low, triton::ast::reference(parent->getId())))),
-                          triton::ast::bvand(
-                            triton::ast::bvxor(op1, triton::ast::extract(high, low, triton::ast::reference(parent->getId()))),
-                            triton::ast::bvxor(op1, op2)
-                          )
-                        )
-                      );
-
-          /* Create the symbolic expression */
-          auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_CF, "Carry flag");
+          auto expr = flagExpression(inst, CFSUB_TEMPLATE, cfSubNode, bvSize, high, low, {triton::ast::reference(parent->getId()), op1, op2}, TRITON_X86_REG_CF, "Carry flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_CF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_CF, parent->isTainted);
         }
 
 
@@ -1153,18 +1384,10 @@ namespace triton {
            * Create the semantic.
            * of = MSB((op1 ^ ~op2) & (op1 ^ regDst))
            */
-          auto node = triton::ast::extract(high, high,
-                        triton::ast::bvand(
-                          triton::ast::bvxor(op1, triton::ast::bvnot(op2)),
-                          triton::ast::bvxor(op1, triton::ast::extract(high, low, triton::ast::reference(parent->getId())))
-                        )
-                      );
-
-          /* Create the symbolic expression */
-          auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
+          auto expr = flagExpression(inst, OFADD_TEMPLATE, ofAddNode, bvSize, high, low, {triton::ast::reference(parent->getId()), op1, op2}, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1186,7 +1409,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1210,7 +1433,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1234,7 +1457,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1269,7 +1492,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1303,7 +1526,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1337,7 +1560,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1361,7 +1584,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1390,7 +1613,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1414,7 +1637,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1427,18 +1650,10 @@ namespace triton {
            * Create the semantic.
            * of = high:bool((op1 ^ op2) & (op1 ^ regDst))
            */
-          auto node = triton::ast::extract(high, high,
-                        triton::ast::bvand(
-                          triton::ast::bvxor(op1, op2),
-                          triton::ast::bvxor(op1, triton::ast::extract(high, low, triton::ast::reference(parent->getId())))
-                        )
-                      );
-
-          /* Create the symbolic expression */
-          auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_OF, "Overflow flag");
+          auto expr = flagExpression(inst, OFSUB_TEMPLATE, ofSubNode, bvSize, high, low, {triton::ast::reference(parent->getId()), op1, op2}, TRITON_X86_REG_OF, "Overflow flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_OF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_OF, parent->isTainted);
         }
 
 
@@ -1452,24 +1667,10 @@ namespace triton {
            * pf is set to one if there is an even number of bit set to 1 in the least
            * significant byte of the result.
            */
-          auto node = triton::ast::bv(1, 1);
-          for (triton::uint32 counter = 0; counter <= BYTE_SIZE_BIT-1; counter++) {
-            node = triton::ast::bvxor(
-                     node,
-                     triton::ast::extract(0, 0,
-                       triton::ast::bvlshr(
-                         triton::ast::extract(high, low, triton::ast::reference(parent->getId())),
-                         triton::ast::bv(counter, BYTE_SIZE_BIT)
-                       )
-                    )
-                  );
-          }
-
-          /* Create the symbolic expression */
-          auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_PF, "Parity flag");
+          auto expr = flagExpression(inst, PF_TEMPLATE, pfNode, BYTE_SIZE_BIT, high, low, {triton::ast::reference(parent->getId())}, TRITON_X86_REG_PF, "Parity flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_PF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_PF, parent->isTainted);
         }
 
 
@@ -1506,7 +1707,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node2, TRITON_X86_REG_PF, "Parity flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_PF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_PF, parent->isTainted);
         }
 
 
@@ -1518,13 +1719,10 @@ namespace triton {
            * Create the semantic.
            * sf = high:bool(regDst)
            */
-          auto node = triton::ast::extract(high, high, triton::ast::reference(parent->getId()));
-
-          /* Create the symbolic expression */
-          auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_SF, "Sign flag");
+          auto expr = flagExpression(inst, SF_TEMPLATE, sfNode, bvSize, high, 0, {triton::ast::reference(parent->getId())}, TRITON_X86_REG_SF, "Sign flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_SF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_SF, parent->isTainted);
         }
 
 
@@ -1547,7 +1745,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_SF, "Sign flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_SF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_SF, parent->isTainted);
         }
 
 
@@ -1560,20 +1758,10 @@ namespace triton {
            * Create the semantic.
            * zf = 0 == regDst
            */
-          auto node = triton::ast::ite(
-                        triton::ast::equal(
-                          triton::ast::extract(high, low, triton::ast::reference(parent->getId())),
-                          triton::ast::bv(0, bvSize)
-                        ),
-                        triton::ast::bv(1, 1),
-                        triton::ast::bv(0, 1)
-                      );
-
-          /* Create the symbolic expression */
-          auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_ZF, "Zero flag");
+          auto expr = flagExpression(inst, ZF_TEMPLATE, zfNode, bvSize, high, low, {triton::ast::reference(parent->getId())}, TRITON_X86_REG_ZF, "Zero flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_ZF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_ZF, parent->isTainted);
         }
 
 
@@ -1594,7 +1782,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_ZF, "Zero flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_ZF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_ZF, parent->isTainted);
         }
 
 
@@ -1625,7 +1813,7 @@ namespace triton {
           auto expr = triton::api.createSymbolicFlagExpression(inst, node, TRITON_X86_REG_ZF, "Zero flag");
 
           /* Spread the taint from the parent to the child */
-          expr->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_ZF, parent->isTainted);
+          expr->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_ZF, parent->isTainted);
         }
 
 
@@ -2480,7 +2668,7 @@ namespace triton {
           auto expr2 = triton::api.createSymbolicExpression(inst, node2, src, "CDQ EAX operation");
 
           /* Spread taint */
-          expr2->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_EAX, expr1->isTainted);
+          expr2->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_EAX, expr1->isTainted);
 
           /* Create the semantics - EDX = TMP[63...32] */
           auto node3 = triton::ast::extract(QWORD_SIZE_BIT-1, DWORD_SIZE_BIT, triton::ast::reference(expr1->getId()));
@@ -2489,7 +2677,7 @@ namespace triton {
           auto expr3 = triton::api.createSymbolicExpression(inst, node3, dst, "CDQ EDX operation");
 
           /* Spread taint */
-          expr3->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_EDX, expr1->isTainted);
+          expr3->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_EDX, expr1->isTainted);
 
           /* Upate the symbolic control flow */
           triton::arch::x86::semantics::controlFlow_s(inst);
@@ -3647,7 +3835,7 @@ namespace triton {
           auto expr2 = triton::api.createSymbolicExpression(inst, node2, src, "CQO RAX operation");
 
           /* Spread taint */
-          expr2->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_RAX, expr1->isTainted);
+          expr2->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_RAX, expr1->isTainted);
 
           /* Create the semantics - RDX = TMP[127...64] */
           auto node3 = triton::ast::extract(DQWORD_SIZE_BIT-1, QWORD_SIZE_BIT, triton::ast::reference(expr1->getId()));
@@ -3656,7 +3844,7 @@ namespace triton {
           auto expr3 = triton::api.createSymbolicExpression(inst, node3, dst, "CQO RDX operation");
 
           /* Spread taint */
-          expr3->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_RDX, expr1->isTainted);
+          expr3->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_RDX, expr1->isTainted);
 
           /* Upate the symbolic control flow */
           triton::arch::x86::semantics::controlFlow_s(inst);
@@ -3686,7 +3874,7 @@ namespace triton {
           auto expr2 = triton::api.createSymbolicExpression(inst, node2, src, "CWD AX operation");
 
           /* Spread taint */
-          expr2->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_AX, expr1->isTainted);
+          expr2->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_AX, expr1->isTainted);
 
           /* Create the semantics - DX = TMP[31...16] */
           auto node3 = triton::ast::extract(DWORD_SIZE_BIT-1, WORD_SIZE_BIT, triton::ast::reference(expr1->getId()));
@@ -3695,7 +3883,7 @@ namespace triton {
           auto expr3 = triton::api.createSymbolicExpression(inst, node3, dst, "CWD DX operation");
 
           /* Spread taint */
-          expr3->isTainted = triton::api.setTaintRegister(TRITON_X86_REG_DX, expr1->isTainted);
+          expr3->isTainted = triton::api.setTaintRegister(inst, TRITON_X86_REG_DX, expr1->isTainted);
 
           /* Upate the symbolic control flow */
           triton::arch::x86::semantics::controlFlow_s(inst);
@@ -10602,8 +10790,8 @@ namespace triton {
           auto expr2 = triton::api.createSymbolicExpression(inst, node2, src, "XCHG operation");
 
           /* Spread taint */
-          expr1->isTainted = triton::api.setTaint(dst, srcT);
-          expr2->isTainted = triton::api.setTaint(src, dstT);
+          expr1->isTainted = triton::api.setTaint(inst, dst, srcT);
+          expr2->isTainted = triton::api.setTaint(inst, src, dstT);
 
           /* Create symbolic operands */
           op1 = triton::api.buildSymbolicOperand(inst, dst);
@@ -10650,8 +10838,8 @@ namespace triton {
           auto expr2 = triton::api.createSymbolicExpression(inst, node2, src, "XCHG operation");
 
           /* Spread taint */
-          expr1->isTainted = triton::api.setTaint(dst, srcT);
-          expr2->isTainted = triton::api.setTaint(src, dstT);
+          expr1->isTainted = triton::api.setTaint(inst, dst, srcT);
+          expr2->isTainted = triton::api.setTaint(inst, src, dstT);
 
           /* Upate the symbolic control flow */
           triton::arch::x86::semantics::controlFlow_s(inst);
@@ -5,7 +5,9 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
 #include <cmath>
+#include <limits>
 
 #include <api.hpp>
 #include <ast.hpp>
@@ -17,10 +19,320 @@
 namespace triton {
   namespace ast {
 
+    /* ====== Native evaluation */
+
+    /*
+     * Nodes are evaluated according to the width class of their operands: native 64-bit
+     * integers up to 64 bits, 128-bit integers up to 128 bits (SSE) and 512-bit integers
+     * above (AVX). Values are always kept masked to the size of the node.
+     */
+
+    template <typename T>
+    static inline T nativeMask(triton::uint32 size) {
+      if (size >= static_cast<triton::uint32>(std::numeric_limits<T>::digits))
+        return ~static_cast<T>(0);
+      return (static_cast<T>(1) << size) - 1;
+    }
+
+
+    template <typename T>
+    static inline T nativeNeg(const T& value, triton::uint32 size) {
+      return (~value + 1) & nativeMask<T>(size);
+    }
+
+
+    template <typename T>
+    static T nativeUnary(enum kind_e kind, const T& op, triton::uint32 size) {
+      switch (kind) {
+        case BVNEG_NODE:  return nativeNeg<T>(op, size);
+        case BVNOT_NODE:  return (~op & nativeMask<T>(size));
+        default:
+          throw std::runtime_error("triton::ast::nativeUnary(): Invalid kind of node.");
+      }
+    }
+
+
+    template <typename T>
+    static T nativeBinary(enum kind_e kind, const T& op1, const T& op2, triton::uint32 size) {
+      T mask   = nativeMask<T>(size);
+      T sign   = (size != 0) ? (static_cast<T>(1) << (size - 1)) : static_cast<T>(0);
+      bool op1Negative = ((op1 & sign) != 0);
+      bool op2Negative = ((op2 & sign) != 0);
+      T op1Abs = op1Negative ? nativeNeg<T>(op1, size) : op1;
+      T op2Abs = op2Negative ? nativeNeg<T>(op2, size) : op2;
+      T value  = 0;
+
+      switch (kind) {
+        case BVADD_NODE:  return ((op1 + op2) & mask);
+        case BVAND_NODE:  return (op1 & op2);
+        case BVMUL_NODE:  return ((op1 * op2) & mask);
+        case BVNAND_NODE: return (~(op1 & op2) & mask);
+        case BVNOR_NODE:  return (~(op1 | op2) & mask);
+        case BVOR_NODE:   return (op1 | op2);
+        case BVSUB_NODE:  return ((op1 - op2) & mask);
+        case BVXNOR_NODE: return (~(op1 ^ op2) & mask);
+        case BVXOR_NODE:  return (op1 ^ op2);
+
+        case BVSHL_NODE:
+          if (op2 >= size)
+            return 0;
+          return ((op1 << static_cast<triton::uint32>(op2)) & mask);
+
+        case BVLSHR_NODE:
+          if (op2 >= size)
+            return 0;
+          return (op1 >> static_cast<triton::uint32>(op2));
+
+        case BVASHR_NODE:
+          if (op2 >= size)
+            return op1Negative ? mask : static_cast<T>(0);
+          value = (op1 >> static_cast<triton::uint32>(op2));
+          if (op1Negative)
+            value |= (mask & ~(mask >> static_cast<triton::uint32>(op2)));
+          return value;
+
+        case BVUDIV_NODE:
+          if (op2 == 0)
+            return mask;
+          return (op1 / op2);
+
+        case BVUREM_NODE:
+          if (op2 == 0)
+            return op1;
+          return (op1 % op2);
+
+        case BVSDIV_NODE:
+          if (op2 == 0)
+            return op1Negative ? static_cast<T>(1) : mask;
+          value = (op1Abs / op2Abs);
+          return (op1Negative != op2Negative) ? nativeNeg<T>(value, size) : value;
+
+        case BVSREM_NODE:
+          if (op2 == 0)
+            return op1;
+          value = (op1Abs % op2Abs);
+          return op1Negative ? nativeNeg<T>(value, size) : value;
+
+        case BVSMOD_NODE:
+          /* The result has the sign of the divisor */
+          if (op2 == 0)
+            return op1;
+          value = (op1Abs % op2Abs);
+          if (value == 0)
+            return value;
+          value = op1Negative ? nativeNeg<T>(value, size) : value;
+          if (op1Negative != op2Negative)
+            value = ((value + op2) & mask);
+          return value;
+
+        case BVUGE_NODE:  return static_cast<T>(op1 >= op2);
+        case BVUGT_NODE:  return static_cast<T>(op1 > op2);
+        case BVULE_NODE:  return static_cast<T>(op1 <= op2);
+        case BVULT_NODE:  return static_cast<T>(op1 < op2);
+
+        /* Flipping the sign bit turns a signed comparison into an unsigned one */
+        case BVSGE_NODE:  return static_cast<T>((op1 ^ sign) >= (op2 ^ sign));
+        case BVSGT_NODE:  return static_cast<T>((op1 ^ sign) > (op2 ^ sign));
+        case BVSLE_NODE:  return static_cast<T>((op1 ^ sign) <= (op2 ^ sign));
+        case BVSLT_NODE:  return static_cast<T>((op1 ^ sign) < (op2 ^ sign));
+
+        case DISTINCT_NODE: return static_cast<T>(op1 != op2);
+        case EQUAL_NODE:    return static_cast<T>(op1 == op2);
+
+        default:
+          throw std::runtime_error("triton::ast::nativeBinary(): Invalid kind of node.");
+      }
+    }
+
+
+    /* ====== Childs of a node */
+
+    AstChilds::AstChilds() {
+      this->childs   = this->inlined;
+      this->count    = 0;
+      this->capacity = AST_INLINE_CHILDS;
+    }
+
+
+    AstChilds::AstChilds(const AstChilds& copy) {
+      this->childs   = this->inlined;
+      this->count    = 0;
+      this->capacity = AST_INLINE_CHILDS;
+      *this = copy;
+    }
+
+
+    AstChilds::~AstChilds() {
+      if (this->childs != this->inlined)
+        delete[] this->childs;
+    }
+
+
+    AstChilds& AstChilds::operator=(const AstChilds& other) {
+      if (this == &other)
+        return *this;
+
+      this->count = 0;
+      for (triton::uint32 index = 0; index < other.count; index++)
+        this->push_back(other.childs[index]);
+
+      return *this;
+    }
+
+
+    bool AstChilds::operator==(const AstChilds& other) const {
+      if (this->count != other.count)
+        return false;
+
+      for (triton::uint32 index = 0; index < this->count; index++) {
+        if (this->childs[index] != other.childs[index])
+          return false;
+      }
+
+      return true;
+    }
+
+
+    AbstractNode*& AstChilds::operator[](triton::uint32 index) {
+      return this->childs[index];
+    }
+
+
+    AbstractNode* const& AstChilds::operator[](triton::uint32 index) const {
+      return this->childs[index];
+    }
+
+
+    triton::uint32 AstChilds::size(void) const {
+      return this->count;
+    }
+
+
+    bool AstChilds::empty(void) const {
+      return (this->count == 0);
+    }
+
+
+    void AstChilds::push_back(AbstractNode* child) {
+      /* Spill to the heap */
+      if (this->count == this->capacity) {
+        AbstractNode** childs = new AbstractNode*[this->capacity * 2];
+
+        for (triton::uint32 index = 0; index < this->count; index++)
+          childs[index] = this->childs[index];
+
+        if (this->childs != this->inlined)
+          delete[] this->childs;
+
+        this->childs    = childs;
+        this->capacity *= 2;
+      }
+
+      this->childs[this->count++] = child;
+    }
+
+
+    AstChilds::iterator AstChilds::begin(void) {
+      return this->childs;
+    }
+
+
+    AstChilds::iterator AstChilds::end(void) {
+      return this->childs + this->count;
+    }
+
+
+    AstChilds::const_iterator AstChilds::begin(void) const {
+      return this->childs;
+    }
+
+
+    AstChilds::const_iterator AstChilds::end(void) const {
+      return this->childs + this->count;
+    }
+
+
+    /* ====== Value of a node */
+
+    AstValue::AstValue() {
+      this->narrow = 0;
+      this->wide   = nullptr;
+    }
+
+
+    AstValue::AstValue(const AstValue& copy) {
+      this->narrow = copy.narrow;
+      this->wide   = nullptr;
+      if (copy.wide != nullptr)
+        this->wide = new triton::uint512(*copy.wide);
+    }
+
+
+    AstValue::~AstValue() {
+      delete this->wide;
+    }
+
+
+    AstValue& AstValue::operator=(const AstValue& other) {
+      if (other.wide == nullptr) {
+        delete this->wide;
+        this->narrow = other.narrow;
+        this->wide   = nullptr;
+      }
+      else
+        *this = *other.wide;
+
+      return *this;
+    }
+
+
+    AstValue& AstValue::operator=(triton::uint64 value) {
+      if (this->wide != nullptr)
+        *this->wide = value;
+      else
+        this->narrow = value;
+      return *this;
+    }
+
+
+    AstValue& AstValue::operator=(const triton::uint512& value) {
+      /* Keep the box once allocated, a wide node stays wide */
+      if (this->wide != nullptr)
+        *this->wide = value;
+
+      else if ((value >> 64) == 0)
+        this->narrow = value.convert_to<triton::uint64>();
+
+      else
+        this->wide = new triton::uint512(value);
+
+      return *this;
+    }
+
+
+    bool AstValue::isNarrow(void) const {
+      return (this->wide == nullptr || (*this->wide >> 64) == 0);
+    }
+
+
+    triton::uint64 AstValue::getNarrow(void) const {
+      if (this->wide != nullptr)
+        return this->wide->convert_to<triton::uint64>();
+      return this->narrow;
+    }
+
+
+    triton::uint512 AstValue::getValue(void) const {
+      if (this->wide != nullptr)
+        return *this->wide;
+      return this->narrow;
+    }
+
+
     /* ====== Abstract node */
 
     AbstractNode::AbstractNode(enum kind_e kind) {
-      this->eval        = 0;
+      this->hash        = 0;
       this->kind        = kind;
       this->size        = 0;
       this->symbolized  = false;
@@ -28,7 +340,7 @@ namespace triton {
 
 
     AbstractNode::AbstractNode() {
-      this->eval        = 0;
+      this->hash        = 0;
       this->kind        = UNDEFINED_NODE;
       this->size        = 0;
       this->symbolized  = false;
@@ -37,13 +349,11 @@ namespace triton {
 
     AbstractNode::AbstractNode(const AbstractNode& copy) {
       this->eval        = copy.eval;
+      this->hash        = copy.hash;
       this->kind        = copy.kind;
-      this->parents     = copy.parents;
       this->size        = copy.size;
       this->symbolized  = copy.symbolized;
-
-      for (triton::uint32 index = 0; index < copy.childs.size(); index++)
-        this->childs.push_back(triton::ast::newInstance(copy.childs[index]));
+      this->childs      = copy.childs;
     }
 
 
@@ -52,6 +362,16 @@ namespace triton {
     }
 
 
+    void* AbstractNode::operator new(std::size_t size) {
+      return triton::api.allocateAstNode(size);
+    }
+
+
+    void AbstractNode::operator delete(void* ptr) {
+      triton::api.deallocateAstNode(ptr);
+    }
+
+
     enum kind_e AbstractNode::getKind(void) const {
       return this->kind;
     }
@@ -63,6 +383,10 @@ namespace triton {
 
 
     triton::uint512 AbstractNode::getBitvectorMask(void) const {
+      /* Fast path for nodes up to 64 bits */
+      if (this->size <= 64)
+        return (this->size == 64) ? static_cast<triton::uint64>(-1) : ((static_cast<triton::uint64>(1) << this->size) - 1);
+
       triton::uint512 mask = -1;
       mask = mask >> (512 - this->size);
       return mask;
@@ -70,7 +394,11 @@ namespace triton {
 
 
     bool AbstractNode::isSigned(void) const {
-      if ((this->eval >> (this->size-1)) & 1)
+      /* Fast path for nodes up to 64 bits */
+      if (this->size <= 64 && this->eval.isNarrow())
+        return (this->size != 0) && ((this->eval.getNarrow() >> (this->size-1)) & 1);
+
+      if ((this->eval.getValue() >> (this->size-1)) & 1)
         return true;
       return false;
     }
@@ -82,33 +410,51 @@ namespace triton {
 
 
     triton::uint512 AbstractNode::evaluate(void) const {
-      return this->eval;
+      return this->eval.getValue();
+    }
+
+
+    triton::uint64 AbstractNode::evaluateNarrow(void) const {
+      return this->eval.getNarrow();
     }
 
 
-    std::vector<AbstractNode*>& AbstractNode::getChilds(void) {
+    triton::uint64 AbstractNode::getHash(void) const {
+      return this->hash;
+    }
+
+
+    AstChilds& AbstractNode::getChilds(void) {
       return this->childs;
     }
 
 
-    std::set<AbstractNode*>& AbstractNode::getParents(void) {
-      return this->parents;
+    std::set<AbstractNode*> AbstractNode::getParents(void) {
+      return triton::api.getParentAstNodes(this);
     }
 
 
     void AbstractNode::setParent(AbstractNode* p) {
-      this->parents.insert(p);
+      triton::api.linkParentAstNode(this, p);
     }
 
 
     void AbstractNode::removeParent(AbstractNode* p) {
-      this->parents.erase(p);
+      triton::api.unlinkParentAstNode(this, p);
     }
 
 
-    void AbstractNode::setParent(std::set<AbstractNode*>& p) {
-      for (std::set<AbstractNode*>::iterator it = p.begin(); it != p.end(); it++)
-        this->parents.insert(*it);
+    void AbstractNode::setParent(const std::set<AbstractNode*>& p) {
+      for (std::set<AbstractNode*>::const_iterator it = p.begin(); it != p.end(); it++)
+        triton::api.linkParentAstNode(this, *it);
+    }
+
+
+    void AbstractNode::initParents(void) {
+      std::set<AbstractNode*> parents = this->getParents();
+
+      for (std::set<AbstractNode*>::iterator it = parents.begin(); it != parents.end(); it++)
+        (*it)->init();
     }
 
 
@@ -124,6 +470,9 @@ namespace triton {
       if (child == nullptr)
         throw std::runtime_error("AbstractNode::setChild(): child cannot be null.");
 
+      /* Log the previous child, it is restored if the new one is freed by a rollback */
+      triton::api.logChildAstNode(this, index);
+
       /* Setup the parent of the child */
       child->setParent(this);
 
@@ -172,9 +521,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -183,12 +534,11 @@ namespace triton {
     }
 
 
-    triton::uint512 AssertNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void AssertNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -220,7 +570,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = ((this->childs[0]->evaluate() + this->childs[1]->evaluate()) & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -228,9 +578,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -239,12 +591,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvaddNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvaddNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -276,7 +627,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = (this->childs[0]->evaluate() & this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -284,9 +635,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -295,12 +648,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvandNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvandNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -325,47 +677,15 @@ namespace triton {
 
 
     void BvashrNode::init(void) {
-      triton::uint32 shift  = 0;
-      triton::uint512 mask  = 0;
-      triton::uint512 value = 0;
-
       if (this->childs.size() < 2)
         throw std::runtime_error("BvashrNode::init(): Must take at least two childs.");
 
       if (this->childs[0]->getBitvectorSize() != this->childs[1]->getBitvectorSize())
         throw std::runtime_error("BvashrNode::init(): Must take two nodes of same size.");
 
-      value = this->childs[0]->evaluate();
-      shift = this->childs[1]->evaluate().convert_to<triton::uint32>();
-
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-
-      /* Mask based on the sign */
-      if (this->childs[0]->isSigned()) {
-        mask = 1;
-        mask = ((mask << (this->size-1)) & this->getBitvectorMask());
-      }
-
-      if (shift >= this->size && this->childs[0]->isSigned()) {
-        this->eval = -1;
-        this->eval &= this->getBitvectorMask();
-      }
-
-      else if (shift >= this->size && !this->childs[0]->isSigned()) {
-        this->eval = 0;
-      }
-
-      else if (shift == 0) {
-        this->eval = value;
-      }
-
-      else {
-        this->eval = value & this->getBitvectorMask();
-        for (triton::uint32 index = 0; index < shift; index++) {
-          this->eval = (((this->eval >> 1) | mask) & this->getBitvectorMask());
-        }
-      }
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -373,9 +693,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -384,12 +706,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvashrNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvashrNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -437,9 +758,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -448,12 +771,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvdeclNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvdeclNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -485,7 +807,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = (this->childs[0]->evaluate() >> this->childs[1]->evaluate().convert_to<triton::uint32>());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -493,9 +815,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -504,12 +828,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvlshrNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvlshrNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -541,7 +864,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = ((this->childs[0]->evaluate() * this->childs[1]->evaluate()) & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -549,9 +872,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -560,12 +885,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvmulNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvmulNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -597,7 +921,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = (~(this->childs[0]->evaluate() & this->childs[1]->evaluate()) & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -605,9 +929,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -616,12 +942,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvnandNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvnandNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -649,7 +974,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = ((-(this->childs[0]->evaluate().convert_to<triton::sint512>())).convert_to<triton::uint512>() & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateUnary(this->kind, this->childs[0]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -657,9 +982,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -668,12 +995,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvnegNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvnegNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -705,7 +1031,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = (~(this->childs[0]->evaluate() | this->childs[1]->evaluate()) & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -713,9 +1039,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -724,12 +1052,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvnorNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvnorNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -757,7 +1084,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = (~this->childs[0]->evaluate() & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateUnary(this->kind, this->childs[0]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -765,9 +1092,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -776,12 +1105,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvnotNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvnotNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -813,7 +1141,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = (this->childs[0]->evaluate() | this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -821,9 +1149,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -832,12 +1162,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvorNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvorNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -880,12 +1209,18 @@ namespace triton {
         throw std::runtime_error("BvrolNode::init(): rot must be a DECIMAL_NODE.");
 
       rot   = reinterpret_cast<DecimalNode*>(this->childs[0])->getValue().convert_to<triton::uint32>();
-      value = this->childs[1]->evaluate();
 
       /* Init attributes */
       this->size = this->childs[1]->getBitvectorSize();
       rot %= this->size;
-      this->eval = (((value << rot) | (value >> (this->size - rot))) & this->getBitvectorMask());
+      if (this->size <= 64) {
+        triton::uint64 narrow = this->childs[1]->evaluateNarrow();
+        this->eval = (rot == 0) ? narrow : (((narrow << rot) | (narrow >> (this->size - rot))) & nativeMask<triton::uint64>(this->size));
+      }
+      else {
+        value = this->childs[1]->evaluate();
+        this->eval = (((value << rot) | (value >> (this->size - rot))) & this->getBitvectorMask());
+      }
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -893,9 +1228,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -904,12 +1241,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvrolNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvrolNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -951,12 +1287,18 @@ namespace triton {
         throw std::runtime_error("BvrorNode::init(): rot must be a DECIMAL_NODE.");
 
       rot   = reinterpret_cast<DecimalNode*>(this->childs[0])->getValue().convert_to<triton::uint32>();
-      value = this->childs[1]->evaluate();
 
       /* Init attributes */
       this->size = this->childs[1]->getBitvectorSize();
       rot %= this->size;
-      this->eval = (((value >> rot) | (value << (this->size - rot))) & this->getBitvectorMask());
+      if (this->size <= 64) {
+        triton::uint64 narrow = this->childs[1]->evaluateNarrow();
+        this->eval = (rot == 0) ? narrow : (((narrow >> rot) | (narrow << (this->size - rot))) & nativeMask<triton::uint64>(this->size));
+      }
+      else {
+        value = this->childs[1]->evaluate();
+        this->eval = (((value >> rot) | (value << (this->size - rot))) & this->getBitvectorMask());
+      }
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -964,9 +1306,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -975,12 +1319,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvrorNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvrorNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1004,28 +1347,15 @@ namespace triton {
 
 
     void BvsdivNode::init(void) {
-      triton::sint512 op1Signed = 0;
-      triton::sint512 op2Signed = 0;
-
       if (this->childs.size() < 2)
         throw std::runtime_error("BvsdivNode::init(): Must take at least two childs.");
 
       if (this->childs[0]->getBitvectorSize() != this->childs[1]->getBitvectorSize())
         throw std::runtime_error("BvsdivNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->childs[0]);
-      op2Signed = triton::ast::modularSignExtend(this->childs[1]);
-
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-
-      if (op2Signed == 0) {
-        this->eval = (op1Signed < 0 ? 1 : -1);
-        this->eval &= this->getBitvectorMask();
-      }
-      else
-        this->eval = ((op1Signed / op2Signed).convert_to<triton::uint512>() & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1033,9 +1363,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1044,12 +1376,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvsdivNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvsdivNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1073,22 +1404,15 @@ namespace triton {
 
 
     void BvsgeNode::init(void) {
-      triton::sint512 op1Signed = 0;
-      triton::sint512 op2Signed = 0;
-
       if (this->childs.size() < 2)
         throw std::runtime_error("BvsgeNode::init(): Must take at least two childs.");
 
       if (this->childs[0]->getBitvectorSize() != this->childs[1]->getBitvectorSize())
         throw std::runtime_error("BvsgeNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->childs[0]);
-      op2Signed = triton::ast::modularSignExtend(this->childs[1]);
-
       /* Init attributes */
       this->size = 1;
-      this->eval = (op1Signed >= op2Signed);
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1096,9 +1420,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1107,12 +1433,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvsgeNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvsgeNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1136,22 +1461,15 @@ namespace triton {
 
 
     void BvsgtNode::init(void) {
-      triton::sint512 op1Signed = 0;
-      triton::sint512 op2Signed = 0;
-
       if (this->childs.size() < 2)
         throw std::runtime_error("BvsgtNode::init(): Must take at least two childs.");
 
       if (this->childs[0]->getBitvectorSize() != this->childs[1]->getBitvectorSize())
         throw std::runtime_error("BvsgtNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->childs[0]);
-      op2Signed = triton::ast::modularSignExtend(this->childs[1]);
-
       /* Init attributes */
       this->size = 1;
-      this->eval = (op1Signed > op2Signed);
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1159,9 +1477,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1170,12 +1490,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvsgtNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvsgtNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1207,7 +1526,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = ((this->childs[0]->evaluate() << this->childs[1]->evaluate().convert_to<triton::uint32>()) & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1215,9 +1534,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1226,12 +1547,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvshlNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvshlNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1255,22 +1575,15 @@ namespace triton {
 
 
     void BvsleNode::init(void) {
-      triton::sint512 op1Signed = 0;
-      triton::sint512 op2Signed = 0;
-
       if (this->childs.size() < 2)
         throw std::runtime_error("BvsleNode::init(): Must take at least two childs.");
 
       if (this->childs[0]->getBitvectorSize() != this->childs[1]->getBitvectorSize())
         throw std::runtime_error("BvsleNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->childs[0]);
-      op2Signed = triton::ast::modularSignExtend(this->childs[1]);
-
       /* Init attributes */
       this->size = 1;
-      this->eval = (op1Signed <= op2Signed);
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1278,9 +1591,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1289,12 +1604,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvsleNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvsleNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1318,22 +1632,15 @@ namespace triton {
 
 
     void BvsltNode::init(void) {
-      triton::sint512 op1Signed = 0;
-      triton::sint512 op2Signed = 0;
-
       if (this->childs.size() < 2)
         throw std::runtime_error("BvsltNode::init(): Must take at least two childs.");
 
       if (this->childs[0]->getBitvectorSize() != this->childs[1]->getBitvectorSize())
         throw std::runtime_error("BvsltNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->childs[0]);
-      op2Signed = triton::ast::modularSignExtend(this->childs[1]);
-
       /* Init attributes */
       this->size = 1;
-      this->eval = (op1Signed < op2Signed);
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1341,9 +1648,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1352,12 +1661,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvsltNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvsltNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1381,26 +1689,15 @@ namespace triton {
 
 
     void BvsmodNode::init(void) {
-      triton::sint512 op1Signed = 0;
-      triton::sint512 op2Signed = 0;
-
       if (this->childs.size() < 2)
         throw std::runtime_error("BvsmodNode::init(): Must take at least two childs.");
 
       if (this->childs[0]->getBitvectorSize() != this->childs[1]->getBitvectorSize())
         throw std::runtime_error("BvsmodNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->childs[0]);
-      op2Signed = triton::ast::modularSignExtend(this->childs[1]);
-
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-
-      if (this->childs[1]->evaluate() == 0)
-        this->eval = this->childs[0]->evaluate();
-      else
-        this->eval = ((((op1Signed % op2Signed) + op2Signed) % op2Signed).convert_to<triton::uint512>() & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1408,9 +1705,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1419,12 +1718,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvsmodNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvsmodNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1448,26 +1746,15 @@ namespace triton {
 
 
     void BvsremNode::init(void) {
-      triton::sint512 op1Signed = 0;
-      triton::sint512 op2Signed = 0;
-
       if (this->childs.size() < 2)
         throw std::runtime_error("BvsremNode::init(): Must take at least two childs.");
 
       if (this->childs[0]->getBitvectorSize() != this->childs[1]->getBitvectorSize())
         throw std::runtime_error("BvsremNode::init(): Must take two nodes of same size.");
 
-      /* Sign extend */
-      op1Signed = triton::ast::modularSignExtend(this->childs[0]);
-      op2Signed = triton::ast::modularSignExtend(this->childs[1]);
-
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-
-      if (this->childs[1]->evaluate() == 0)
-        this->eval = this->childs[0]->evaluate();
-      else
-        this->eval = ((op1Signed - ((op1Signed / op2Signed) * op2Signed)).convert_to<triton::uint512>() & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1475,9 +1762,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1486,12 +1775,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvsremNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvsremNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1523,7 +1811,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = ((this->childs[0]->evaluate() - this->childs[1]->evaluate()) & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1531,9 +1819,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1542,12 +1832,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvsubNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvsubNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1579,11 +1868,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-
-      if (this->childs[1]->evaluate() == 0)
-        this->eval = (-1 & this->getBitvectorMask());
-      else
-        this->eval = (this->childs[0]->evaluate() / this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1591,9 +1876,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1602,12 +1889,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvudivNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvudivNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1639,7 +1925,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->childs[0]->evaluate() >= this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1647,9 +1933,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1658,12 +1946,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvugeNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvugeNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1695,7 +1982,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->childs[0]->evaluate() > this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1703,9 +1990,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1714,12 +2003,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvugtNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvugtNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1751,7 +2039,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->childs[0]->evaluate() <= this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1759,9 +2047,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1770,12 +2060,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvuleNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvuleNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1807,7 +2096,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->childs[0]->evaluate() < this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1815,9 +2104,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1826,12 +2117,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvultNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvultNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1863,11 +2153,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-
-      if (this->childs[1]->evaluate() == 0)
-        this->eval = this->childs[0]->evaluate();
-      else
-        this->eval = (this->childs[0]->evaluate() % this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1875,9 +2161,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1886,12 +2174,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvuremNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvuremNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -1923,7 +2210,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = (~(this->childs[0]->evaluate() ^ this->childs[1]->evaluate()) & this->getBitvectorMask());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1931,9 +2218,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1942,12 +2231,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvxnorNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvxnorNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -1979,7 +2267,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[0]->getBitvectorSize();
-      this->eval = (this->childs[0]->evaluate() ^ this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -1987,9 +2275,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -1998,12 +2288,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvxorNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvxorNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -2055,9 +2344,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2066,12 +2357,11 @@ namespace triton {
     }
 
 
-    triton::uint512 BvNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void BvNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -2108,9 +2398,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2119,12 +2411,11 @@ namespace triton {
     }
 
 
-    triton::uint512 CompoundNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void CompoundNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -2164,6 +2455,8 @@ namespace triton {
 
 
     void ConcatNode::init(void) {
+      triton::uint512 value = 0;
+
       if (this->childs.size() < 2)
         throw std::runtime_error("ConcatNode::init(): Must take at least two childs.");
 
@@ -2176,9 +2469,18 @@ namespace triton {
       if (this->size > MAX_BITS_SUPPORTED)
         throw std::runtime_error("ConcatNode::init(): Size connot be greater than MAX_BITS_SUPPORTED.");
 
-      this->eval = this->childs[0]->evaluate();
-      for (triton::uint32 index = 0; index < this->childs.size()-1; index++)
-        this->eval = ((this->eval << this->childs[index+1]->getBitvectorSize()) | this->childs[index+1]->evaluate());
+      if (this->size <= 64) {
+        triton::uint64 narrow = this->childs[0]->evaluateNarrow();
+        for (triton::uint32 index = 0; index < this->childs.size()-1; index++)
+          narrow = ((narrow << this->childs[index+1]->getBitvectorSize()) | this->childs[index+1]->evaluateNarrow());
+        this->eval = narrow;
+      }
+      else {
+        value = this->childs[0]->evaluate();
+        for (triton::uint32 index = 0; index < this->childs.size()-1; index++)
+          value = ((value << this->childs[index+1]->getBitvectorSize()) | this->childs[index+1]->evaluate());
+        this->eval = value;
+      }
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -2186,9 +2488,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2197,12 +2501,11 @@ namespace triton {
     }
 
 
-    triton::uint512 ConcatNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void ConcatNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -2231,9 +2534,11 @@ namespace triton {
       this->size        = 0;
       this->symbolized  = false;
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2247,9 +2552,14 @@ namespace triton {
     }
 
 
-    triton::uint512 DecimalNode::hash(triton::uint32 deep) {
-      triton::uint512 hash = this->kind ^ this->value;
-      return hash;
+    void DecimalNode::initHash(void) {
+      triton::uint512 value = this->value;
+      triton::uint64 h = triton::ast::hashMix(this->kind);
+      do {
+        h = triton::ast::hashMix(h ^ static_cast<triton::uint64>(value & 0xffffffffffffffffULL));
+        value >>= 64;
+      } while (value != 0);
+      this->hash = h;
     }
 
 
@@ -2292,9 +2602,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2303,12 +2615,11 @@ namespace triton {
     }
 
 
-    triton::uint512 DeclareFunctionNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void DeclareFunctionNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -2337,7 +2648,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->childs[0]->evaluate() != this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -2345,9 +2656,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2356,12 +2669,11 @@ namespace triton {
     }
 
 
-    triton::uint512 DistinctNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void DistinctNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -2390,7 +2702,7 @@ namespace triton {
 
       /* Init attributes */
       this->size = 1;
-      this->eval = (this->childs[0]->evaluate() == this->childs[1]->evaluate());
+      this->eval = triton::ast::evaluateBinary(this->kind, this->childs[0], this->childs[1]);
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -2398,9 +2710,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2409,12 +2723,11 @@ namespace triton {
     }
 
 
-    triton::uint512 EqualNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void EqualNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -2456,7 +2769,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = ((high - low) + 1);
-      this->eval = ((this->childs[2]->evaluate() >> low) & this->getBitvectorMask());
+      if (this->childs[2]->getBitvectorSize() <= 64 && low < 64)
+        this->eval = ((this->childs[2]->evaluateNarrow() >> low) & nativeMask<triton::uint64>(this->size));
+      else
+        this->eval = ((this->childs[2]->evaluate() >> low) & this->getBitvectorMask());
 
       if (this->size > this->childs[2]->getBitvectorSize() || high >= this->childs[2]->getBitvectorSize())
         throw std::runtime_error("ExtractNode::init(): The size of the extraction is higher than the child expression.");
@@ -2467,9 +2783,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2478,12 +2796,11 @@ namespace triton {
     }
 
 
-    triton::uint512 ExtractNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void ExtractNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -2516,7 +2833,10 @@ namespace triton {
 
       /* Init attributes */
       this->size = this->childs[1]->getBitvectorSize();
-      this->eval = this->childs[0]->evaluate() ? this->childs[1]->evaluate() : this->childs[2]->evaluate();
+      if (this->size <= 64)
+        this->eval = this->childs[0]->evaluateNarrow() ? this->childs[1]->evaluateNarrow() : this->childs[2]->evaluateNarrow();
+      else
+        this->eval = this->childs[0]->evaluate() ? this->childs[1]->evaluate() : this->childs[2]->evaluate();
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -2524,9 +2844,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2535,12 +2857,11 @@ namespace triton {
     }
 
 
-    triton::uint512 IteNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void IteNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -2577,9 +2898,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2588,12 +2911,11 @@ namespace triton {
     }
 
 
-    triton::uint512 LandNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void LandNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -2634,9 +2956,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2645,12 +2969,11 @@ namespace triton {
     }
 
 
-    triton::uint512 LetNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void LetNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -2686,9 +3009,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2697,12 +3022,11 @@ namespace triton {
     }
 
 
-    triton::uint512 LnotNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void LnotNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -2739,9 +3063,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2750,12 +3076,11 @@ namespace triton {
     }
 
 
-    triton::uint512 LorNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void LorNode::initHash(void) {
+      triton::uint64 h = this->kind;
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * this->childs[index]->hash(deep+1);
-      return triton::ast::rotl(h, deep);
+        h += triton::ast::hashMix(this->childs[index]->getHash());
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -2793,9 +3118,11 @@ namespace triton {
         triton::api.getAstFromId(this->value)->setParent(this);
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2809,9 +3136,12 @@ namespace triton {
     }
 
 
-    triton::uint512 ReferenceNode::hash(triton::uint32 deep) {
-      triton::uint512 hash = this->kind ^ this->value;
-      return hash;
+    void ReferenceNode::initHash(void) {
+      /* A reference has the hash of the expression it points to */
+      if (triton::api.isSymbolicExpressionIdExists(this->value))
+        this->hash = triton::api.getAstFromId(this->value)->getHash();
+      else
+        this->hash = triton::ast::hashMix(this->kind ^ this->value);
     }
 
 
@@ -2840,9 +3170,11 @@ namespace triton {
       this->size        = 0;
       this->symbolized  = false;
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2856,12 +3188,11 @@ namespace triton {
     }
 
 
-    triton::uint512 StringNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind;
-      triton::uint32 index = 1;
+    void StringNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (std::string::iterator it=this->value.begin(); it != this->value.end(); it++)
-        h = h ^ triton::ast::pow(*it, index++);
-      return triton::ast::rotl(h, deep);
+        h = (h ^ static_cast<triton::uint8>(*it)) * 0x100000001b3ULL;
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -2900,7 +3231,14 @@ namespace triton {
       if (size > MAX_BITS_SUPPORTED)
         throw std::runtime_error("SxNode::SxNode(): Size connot be greater than MAX_BITS_SUPPORTED.");
 
-      this->eval = ((((this->childs[1]->evaluate() >> (this->childs[1]->getBitvectorSize()-1)) == 0) ? this->childs[1]->evaluate() : (this->childs[1]->evaluate() | ~(this->childs[1]->getBitvectorMask()))) & this->getBitvectorMask());
+      if (this->size <= 64) {
+        triton::uint64 narrow = this->childs[1]->evaluateNarrow();
+        if (this->childs[1]->isSigned())
+          narrow |= ~nativeMask<triton::uint64>(this->childs[1]->getBitvectorSize());
+        this->eval = (narrow & nativeMask<triton::uint64>(this->size));
+      }
+      else
+        this->eval = ((((this->childs[1]->evaluate() >> (this->childs[1]->getBitvectorSize()-1)) == 0) ? this->childs[1]->evaluate() : (this->childs[1]->evaluate() | ~(this->childs[1]->getBitvectorMask()))) & this->getBitvectorMask());
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -2908,9 +3246,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2919,12 +3259,11 @@ namespace triton {
     }
 
 
-    triton::uint512 SxNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void SxNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
 
@@ -2959,9 +3298,11 @@ namespace triton {
       else
         throw std::runtime_error("VariableNode::init(): Variable not found.");
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -2975,12 +3316,11 @@ namespace triton {
     }
 
 
-    triton::uint512 VariableNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind;
-      triton::uint32 index = 1;
-      for (std::string::iterator it = this->value.begin(); it != this->value.end(); it++)
-        h = h ^ triton::ast::pow(*it, index++);
-      return triton::ast::rotl(h, deep);
+    void VariableNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
+      for (std::string::iterator it=this->value.begin(); it != this->value.end(); it++)
+        h = (h ^ static_cast<triton::uint8>(*it)) * 0x100000001b3ULL;
+      this->hash = triton::ast::hashMix(h);
     }
 
 
@@ -3019,7 +3359,10 @@ namespace triton {
       if (size > MAX_BITS_SUPPORTED)
         throw std::runtime_error("ZxNode::init(): Size connot be greater than MAX_BITS_SUPPORTED.");
 
-      this->eval = (this->childs[1]->evaluate() & this->getBitvectorMask());
+      if (this->size <= 64)
+        this->eval = this->childs[1]->evaluateNarrow();
+      else
+        this->eval = (this->childs[1]->evaluate() & this->getBitvectorMask());
 
       /* Init childs and spread information */
       for (triton::uint32 index = 0; index < this->childs.size(); index++) {
@@ -3027,9 +3370,11 @@ namespace triton {
         this->symbolized |= this->childs[index]->isSymbolized();
       }
 
+      /* Init the structural hash */
+      this->initHash();
+
       /* Init parents */
-      for (std::set<AbstractNode*>::iterator it = this->parents.begin(); it != this->parents.end(); it++)
-        (*it)->init();
+      this->initParents();
     }
 
 
@@ -3038,12 +3383,11 @@ namespace triton {
     }
 
 
-    triton::uint512 ZxNode::hash(triton::uint32 deep) {
-      triton::uint512 h = this->kind, s = this->childs.size();
-      if (s) h = h * s;
+    void ZxNode::initHash(void) {
+      triton::uint64 h = triton::ast::hashMix(this->kind);
       for (triton::uint32 index = 0; index < this->childs.size(); index++)
-        h = h * triton::ast::pow(this->childs[index]->hash(deep+1), index+1);
-      return triton::ast::rotl(h, deep);
+        h = triton::ast::hashMix(h ^ this->childs[index]->getHash());
+      this->hash = h;
     }
 
   }; /* ast namespace */
@@ -3066,7 +3410,7 @@ namespace triton {
     bool operator==(AbstractNode& node1, AbstractNode& node2) {
       return (node1.evaluate() == node2.evaluate()) &&
              (node1.getBitvectorSize() == node2.getBitvectorSize()) &&
-             (node1.hash(1) == node2.hash(1));
+             (node1.getHash() == node2.getHash());
     }
 
 
@@ -3080,18 +3424,248 @@ namespace triton {
 namespace triton {
   namespace ast {
 
-    triton::uint512 pow(triton::uint512 hash, triton::uint32 n) {
-      triton::uint512 mask = -1;
-      for (triton::uint32 i = 0; i < n; i++)
-        hash = ((hash * hash) & mask);
-      return hash;
+    triton::uint64 hashMix(triton::uint64 value) {
+      value ^= value >> 30;
+      value *= 0xbf58476d1ce4e5b9ULL;
+      value ^= value >> 27;
+      value *= 0x94d049bb133111ebULL;
+      value ^= value >> 31;
+      return value;
+    }
+
+
+    AstValue evaluateUnary(enum kind_e kind, AbstractNode* op) {
+      triton::uint32 size = op->getBitvectorSize();
+      AstValue value;
+
+      if (size <= 64)
+        value = nativeUnary<triton::uint64>(kind, op->evaluateNarrow(), size);
+
+      else if (size <= 128)
+        value = triton::uint512(nativeUnary<triton::uint128>(kind, op->evaluate().convert_to<triton::uint128>(), size));
+
+      else
+        value = nativeUnary<triton::uint512>(kind, op->evaluate(), size);
+
+      return value;
+    }
+
+
+    AstValue evaluateBinary(enum kind_e kind, AbstractNode* op1, AbstractNode* op2) {
+      triton::uint32 size = std::max(op1->getBitvectorSize(), op2->getBitvectorSize());
+      AstValue value;
+
+      if (size <= 64)
+        value = nativeBinary<triton::uint64>(kind, op1->evaluateNarrow(), op2->evaluateNarrow(), size);
+
+      else if (size <= 128)
+        value = triton::uint512(nativeBinary<triton::uint128>(kind, op1->evaluate().convert_to<triton::uint128>(), op2->evaluate().convert_to<triton::uint128>(), size));
+
+      else
+        value = nativeBinary<triton::uint512>(kind, op1->evaluate(), op2->evaluate(), size);
+
+      return value;
+    }
+
+
+    static triton::uint512 nativeUnaryValue(enum kind_e kind, const triton::uint512& op, triton::uint32 size) {
+      if (size <= 64)
+        return nativeUnary<triton::uint64>(kind, op.convert_to<triton::uint64>(), size);
+      if (size <= 128)
+        return nativeUnary<triton::uint128>(kind, op.convert_to<triton::uint128>(), size);
+      return nativeUnary<triton::uint512>(kind, op, size);
+    }
+
+
+    static triton::uint512 nativeBinaryValue(enum kind_e kind, const triton::uint512& op1, const triton::uint512& op2, triton::uint32 size) {
+      if (size <= 64)
+        return nativeBinary<triton::uint64>(kind, op1.convert_to<triton::uint64>(), op2.convert_to<triton::uint64>(), size);
+      if (size <= 128)
+        return nativeBinary<triton::uint128>(kind, op1.convert_to<triton::uint128>(), op2.convert_to<triton::uint128>(), size);
+      return nativeBinary<triton::uint512>(kind, op1, op2, size);
     }
 
 
-    triton::uint512 rotl(triton::uint512 value, triton::uint32 shift) {
-      if ((shift &= 511) == 0)
-        return value;
-      return ((value << shift) | (value >> (512 - shift)));
+    /* Returns the nodes whose values are needed to evaluate a node under a model */
+    static void getEvaluationOperands(AbstractNode* node, std::vector<AbstractNode*>& operands) {
+      if (!node->isSymbolized())
+        return;
+
+      if (node->getKind() == REFERENCE_NODE) {
+        operands.push_back(triton::api.getAstFromId(reinterpret_cast<ReferenceNode*>(node)->getValue()));
+        return;
+      }
+
+      AstChilds& childs = node->getChilds();
+      for (triton::uint32 index = 0; index < childs.size(); index++)
+        operands.push_back(childs[index]);
+    }
+
+
+    triton::uint512 evaluateOperation(AbstractNode* node, const std::vector<triton::uint512>& values) {
+      AstChilds& childs = node->getChilds();
+      triton::uint512 value = 0;
+
+      if (values.size() != childs.size())
+        throw std::invalid_argument("triton::ast::evaluateOperation(): Wrong number of values.");
+
+      switch (node->getKind()) {
+        case ASSERT_NODE:
+          return values[0];
+
+        case BVNEG_NODE:
+        case BVNOT_NODE:
+          return nativeUnaryValue(node->getKind(), values[0], node->getBitvectorSize());
+
+        case BVROL_NODE:
+        case BVROR_NODE: {
+          triton::uint32 size = node->getBitvectorSize();
+          triton::uint32 rot  = childs[0]->evaluate().convert_to<triton::uint32>() % size;
+          value = values[1];
+          if (rot == 0)
+            return value;
+          if (node->getKind() == BVROL_NODE)
+            return (((value << rot) | (value >> (size - rot))) & node->getBitvectorMask());
+          return (((value >> rot) | (value << (size - rot))) & node->getBitvectorMask());
+        }
+
+        case CONCAT_NODE:
+          value = values[0];
+          for (triton::uint32 index = 1; index < childs.size(); index++)
+            value = ((value << childs[index]->getBitvectorSize()) | values[index]);
+          return value;
+
+        case EXTRACT_NODE:
+          return ((values[2] >> childs[1]->evaluate().convert_to<triton::uint32>()) & node->getBitvectorMask());
+
+        case ITE_NODE:
+          return (values[0] != 0) ? values[1] : values[2];
+
+        case LAND_NODE:
+          value = 1;
+          for (triton::uint32 index = 0; index < childs.size(); index++)
+            value = (values[index] != 0) ? value : 0;
+          return value;
+
+        case LOR_NODE:
+          value = 0;
+          for (triton::uint32 index = 0; index < childs.size(); index++)
+            value = (values[index] != 0) ? 1 : value;
+          return value;
+
+        case LNOT_NODE:
+          return (values[0] == 0) ? 1 : 0;
+
+        case SX_NODE:
+          value = values[1];
+          if ((value >> (childs[1]->getBitvectorSize() - 1)) & 1)
+            value |= (node->getBitvectorMask() & ~childs[1]->getBitvectorMask());
+          return value;
+
+        case ZX_NODE:
+          return values[1];
+
+        case BVADD_NODE:
+        case BVAND_NODE:
+        case BVASHR_NODE:
+        case BVLSHR_NODE:
+        case BVMUL_NODE:
+        case BVNAND_NODE:
+        case BVNOR_NODE:
+        case BVOR_NODE:
+        case BVSDIV_NODE:
+        case BVSGE_NODE:
+        case BVSGT_NODE:
+        case BVSHL_NODE:
+        case BVSLE_NODE:
+        case BVSLT_NODE:
+        case BVSMOD_NODE:
+        case BVSREM_NODE:
+        case BVSUB_NODE:
+        case BVUDIV_NODE:
+        case BVUGE_NODE:
+        case BVUGT_NODE:
+        case BVULE_NODE:
+        case BVULT_NODE:
+        case BVUREM_NODE:
+        case BVXNOR_NODE:
+        case BVXOR_NODE:
+        case DISTINCT_NODE:
+        case EQUAL_NODE:
+          return nativeBinaryValue(node->getKind(), values[0], values[1], std::max(childs[0]->getBitvectorSize(), childs[1]->getBitvectorSize()));
+
+        default:
+          throw std::runtime_error("triton::ast::evaluateOperation(): Unsupported kind of node.");
+      }
+    }
+
+
+    /* Evaluates a node under a model, the values of its operands are already known */
+    static triton::uint512 evaluateNodeWithModel(AbstractNode* node, const std::map<triton::usize, triton::uint512>& model, std::map<AbstractNode*, triton::uint512>& values) {
+      AstChilds& childs = node->getChilds();
+      std::vector<triton::uint512> operands;
+
+      /* Nodes without symbolic variable keep their concrete value */
+      if (!node->isSymbolized())
+        return node->evaluate();
+
+      switch (node->getKind()) {
+        case VARIABLE_NODE: {
+          triton::engines::symbolic::SymbolicVariable* symVar = triton::api.getSymbolicVariableFromName(reinterpret_cast<VariableNode*>(node)->getValue());
+          std::map<triton::usize, triton::uint512>::const_iterator it = model.find(symVar->getId());
+          if (it == model.end())
+            return node->evaluate();
+          return (it->second & node->getBitvectorMask());
+        }
+
+        case REFERENCE_NODE:
+          return values[triton::api.getAstFromId(reinterpret_cast<ReferenceNode*>(node)->getValue())];
+
+        default:
+          for (triton::uint32 index = 0; index < childs.size(); index++)
+            operands.push_back(values[childs[index]]);
+          return triton::ast::evaluateOperation(node, operands);
+      }
+    }
+
+
+    /*
+     * Evaluates an AST in post-order with an explicit worklist. Subtrees
+     * without symbolic variable are not visited, their concrete value is
+     * already known.
+     */
+    triton::uint512 evaluateWithModel(AbstractNode* node, const std::map<triton::usize, triton::uint512>& model, std::map<AbstractNode*, triton::uint512>& values) {
+      std::vector<std::pair<AbstractNode*, bool>> worklist;
+      std::vector<AbstractNode*> operands;
+
+      worklist.push_back(std::make_pair(node, false));
+      while (!worklist.empty()) {
+        AbstractNode* current = worklist.back().first;
+
+        /* Already evaluated */
+        if (values.find(current) != values.end()) {
+          worklist.pop_back();
+          continue;
+        }
+
+        /* First visit, evaluate the operands before the node */
+        if (worklist.back().second == false) {
+          worklist.back().second = true;
+          operands.clear();
+          getEvaluationOperands(current, operands);
+          for (triton::uint32 index = 0; index < operands.size(); index++) {
+            if (values.find(operands[index]) == values.end())
+              worklist.push_back(std::make_pair(operands[index], false));
+          }
+          continue;
+        }
+
+        /* Second visit, the values of all operands are known */
+        worklist.pop_back();
+        values[current] = evaluateNodeWithModel(current, model, values);
+      }
+
+      return values[node];
     }
 
 
@@ -3563,6 +4137,17 @@ namespace triton {
 
 
     AbstractNode* newInstance(AbstractNode* node) {
+      AbstractNode* newNode = triton::ast::newShallowInstance(node);
+      AstChilds& childs = newNode->getChilds();
+
+      for (triton::uint32 index = 0; index < childs.size(); index++)
+        childs[index] = triton::ast::newInstance(childs[index]);
+
+      return newNode;
+    }
+
+
+    AbstractNode* newShallowInstance(AbstractNode* node) {
       AbstractNode* newNode = nullptr;
       switch (node->getKind()) {
         case ASSERT_NODE:               newNode = new AssertNode(*reinterpret_cast<AssertNode*>(node)); break;
@@ -3615,10 +4200,10 @@ namespace triton {
         case VARIABLE_NODE:             newNode = new VariableNode(*reinterpret_cast<VariableNode*>(node)); break;
         case ZX_NODE:                   newNode = new ZxNode(*reinterpret_cast<ZxNode*>(node)); break;
         default:
-          throw std::invalid_argument("triton::ast::newInstance(): Invalid kind node.");
+          throw std::invalid_argument("triton::ast::newShallowInstance(): Invalid kind node.");
       }
       if (newNode == nullptr)
-        throw std::invalid_argument("triton::ast::newInstance(): No enough memory.");
+        throw std::invalid_argument("triton::ast::newShallowInstance(): No enough memory.");
       return newNode;
     }
 
@@ -5,6 +5,7 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <api.hpp>
 #include <astDictionaries.hpp>
 
 
@@ -12,11 +13,19 @@
 namespace triton {
   namespace ast {
 
+    /* Initial number of slots of the table. Must be a power of two. */
+    const triton::usize astDictionariesInitialSize = 1024;
+
+
     AstDictionaries::AstDictionaries() {
       this->allocatedNodes        = 0;
       this->allocatedDictionaries = 0;
+      this->tombstones            = 0;
+      this->totalProbes           = 0;
+      this->maxProbeLength        = 0;
 
-      this->linkDictionaries();
+      AstDictionaryEntry empty = {0, nullptr};
+      this->dictionaries.assign(astDictionariesInitialSize, empty);
     }
 
 
@@ -26,339 +35,242 @@ namespace triton {
 
 
     AstDictionaries::~AstDictionaries() {
-      for (auto it = this->assertDictionary.begin(); it != this->assertDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvaddDictionary.begin(); it != this->bvaddDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvandDictionary.begin(); it != this->bvandDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvashrDictionary.begin(); it != this->bvashrDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvdeclDictionary.begin(); it != this->bvdeclDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvlshrDictionary.begin(); it != this->bvlshrDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvmulDictionary.begin(); it != this->bvmulDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvnandDictionary.begin(); it != this->bvnandDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvnegDictionary.begin(); it != this->bvnegDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvnorDictionary.begin(); it != this->bvnorDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvnotDictionary.begin(); it != this->bvnotDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvorDictionary.begin(); it != this->bvorDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvrolDictionary.begin(); it != this->bvrolDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvrorDictionary.begin(); it != this->bvrorDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvsdivDictionary.begin(); it != this->bvsdivDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvsgeDictionary.begin(); it != this->bvsgeDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvsgtDictionary.begin(); it != this->bvsgtDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvshlDictionary.begin(); it != this->bvshlDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvsleDictionary.begin(); it != this->bvsleDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvsltDictionary.begin(); it != this->bvsltDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvsmodDictionary.begin(); it != this->bvsmodDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvsremDictionary.begin(); it != this->bvsremDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvsubDictionary.begin(); it != this->bvsubDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvudivDictionary.begin(); it != this->bvudivDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvugeDictionary.begin(); it != this->bvugeDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvugtDictionary.begin(); it != this->bvugtDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvuleDictionary.begin(); it != this->bvuleDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvultDictionary.begin(); it != this->bvultDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvuremDictionary.begin(); it != this->bvuremDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvxnorDictionary.begin(); it != this->bvxnorDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvxorDictionary.begin(); it != this->bvxorDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->bvDictionary.begin(); it != this->bvDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->compoundDictionary.begin(); it != this->compoundDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->concatDictionary.begin(); it != this->concatDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->decimalDictionary.begin(); it != this->decimalDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->declareFunctionDictionary.begin(); it != this->declareFunctionDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->distinctDictionary.begin(); it != this->distinctDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->equalDictionary.begin(); it != this->equalDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->extractDictionary.begin(); it != this->extractDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->iteDictionary.begin(); it != this->iteDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->landDictionary.begin(); it != this->landDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->letDictionary.begin(); it != this->letDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->lnotDictionary.begin(); it != this->lnotDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->lorDictionary.begin(); it != this->lorDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->referenceDictionary.begin(); it != this->referenceDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->stringDictionary.begin(); it != this->stringDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->sxDictionary.begin(); it != this->sxDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->variableDictionary.begin(); it != this->variableDictionary.end(); it++)
-        delete it->second;
-      for (auto it = this->zxDictionary.begin(); it != this->zxDictionary.end(); it++)
-        delete it->second;
+      /* Nodes are carved from the slabs of the AST garbage collector which frees them */
     }
 
 
     void AstDictionaries::copy(const AstDictionaries& other) {
-      this->allocatedNodes              = other.allocatedNodes;
-      this->allocatedDictionaries       = other.allocatedDictionaries;
-
-      this->assertDictionary            = other.assertDictionary;
-      this->bvaddDictionary             = other.bvaddDictionary;
-      this->bvandDictionary             = other.bvandDictionary;
-      this->bvashrDictionary            = other.bvashrDictionary;
-      this->bvdeclDictionary            = other.bvdeclDictionary;
-      this->bvlshrDictionary            = other.bvlshrDictionary;
-      this->bvmulDictionary             = other.bvmulDictionary;
-      this->bvnandDictionary            = other.bvnandDictionary;
-      this->bvnegDictionary             = other.bvnegDictionary;
-      this->bvnorDictionary             = other.bvnorDictionary;
-      this->bvnotDictionary             = other.bvnotDictionary;
-      this->bvorDictionary              = other.bvorDictionary;
-      this->bvrolDictionary             = other.bvrolDictionary;
-      this->bvrorDictionary             = other.bvrorDictionary;
-      this->bvsdivDictionary            = other.bvsdivDictionary;
-      this->bvsgeDictionary             = other.bvsgeDictionary;
-      this->bvsgtDictionary             = other.bvsgtDictionary;
-      this->bvshlDictionary             = other.bvshlDictionary;
-      this->bvsleDictionary             = other.bvsleDictionary;
-      this->bvsltDictionary             = other.bvsltDictionary;
-      this->bvsmodDictionary            = other.bvsmodDictionary;
-      this->bvsremDictionary            = other.bvsremDictionary;
-      this->bvsubDictionary             = other.bvsubDictionary;
-      this->bvudivDictionary            = other.bvudivDictionary;
-      this->bvugeDictionary             = other.bvugeDictionary;
-      this->bvugtDictionary             = other.bvugtDictionary;
-      this->bvuleDictionary             = other.bvuleDictionary;
-      this->bvultDictionary             = other.bvultDictionary;
-      this->bvuremDictionary            = other.bvuremDictionary;
-      this->bvxnorDictionary            = other.bvxnorDictionary;
-      this->bvxorDictionary             = other.bvxorDictionary;
-      this->bvDictionary                = other.bvDictionary;
-      this->compoundDictionary          = other.compoundDictionary;
-      this->concatDictionary            = other.concatDictionary;
-      this->decimalDictionary           = other.decimalDictionary;
-      this->declareFunctionDictionary   = other.declareFunctionDictionary;
-      this->distinctDictionary          = other.distinctDictionary;
-      this->equalDictionary             = other.equalDictionary;
-      this->extractDictionary           = other.extractDictionary;
-      this->iteDictionary               = other.iteDictionary;
-      this->landDictionary              = other.landDictionary;
-      this->letDictionary               = other.letDictionary;
-      this->lnotDictionary              = other.lnotDictionary;
-      this->lorDictionary               = other.lorDictionary;
-      this->referenceDictionary         = other.referenceDictionary;
-      this->stringDictionary            = other.stringDictionary;
-      this->sxDictionary                = other.sxDictionary;
-      this->variableDictionary          = other.variableDictionary;
-      this->zxDictionary                = other.zxDictionary;
-
-      this->linkDictionaries();
+      this->allocatedNodes        = other.allocatedNodes;
+      this->allocatedDictionaries = other.allocatedDictionaries;
+      this->tombstones            = other.tombstones;
+      this->totalProbes           = other.totalProbes;
+      this->maxProbeLength        = other.maxProbeLength;
+      this->dictionaries          = other.dictionaries;
     }
 
 
-    void AstDictionaries::linkDictionaries(void) {
-      this->dictionaries[triton::ast::ASSERT_NODE]             = &this->assertDictionary;
-      this->dictionaries[triton::ast::BVADD_NODE]              = &this->bvaddDictionary;
-      this->dictionaries[triton::ast::BVAND_NODE]              = &this->bvandDictionary;
-      this->dictionaries[triton::ast::BVASHR_NODE]             = &this->bvashrDictionary;
-      this->dictionaries[triton::ast::BVDECL_NODE]             = &this->bvdeclDictionary;
-      this->dictionaries[triton::ast::BVLSHR_NODE]             = &this->bvlshrDictionary;
-      this->dictionaries[triton::ast::BVMUL_NODE]              = &this->bvmulDictionary;
-      this->dictionaries[triton::ast::BVNAND_NODE]             = &this->bvnandDictionary;
-      this->dictionaries[triton::ast::BVNEG_NODE]              = &this->bvnegDictionary;
-      this->dictionaries[triton::ast::BVNOR_NODE]              = &this->bvnorDictionary;
-      this->dictionaries[triton::ast::BVNOT_NODE]              = &this->bvnotDictionary;
-      this->dictionaries[triton::ast::BVOR_NODE]               = &this->bvorDictionary;
-      this->dictionaries[triton::ast::BVROL_NODE]              = &this->bvrolDictionary;
-      this->dictionaries[triton::ast::BVROR_NODE]              = &this->bvrorDictionary;
-      this->dictionaries[triton::ast::BVSDIV_NODE]             = &this->bvsdivDictionary;
-      this->dictionaries[triton::ast::BVSGE_NODE]              = &this->bvsgeDictionary;
-      this->dictionaries[triton::ast::BVSGT_NODE]              = &this->bvsgtDictionary;
-      this->dictionaries[triton::ast::BVSHL_NODE]              = &this->bvshlDictionary;
-      this->dictionaries[triton::ast::BVSLE_NODE]              = &this->bvsleDictionary;
-      this->dictionaries[triton::ast::BVSLT_NODE]              = &this->bvsltDictionary;
-      this->dictionaries[triton::ast::BVSMOD_NODE]             = &this->bvsmodDictionary;
-      this->dictionaries[triton::ast::BVSREM_NODE]             = &this->bvsremDictionary;
-      this->dictionaries[triton::ast::BVSUB_NODE]              = &this->bvsubDictionary;
-      this->dictionaries[triton::ast::BVUDIV_NODE]             = &this->bvudivDictionary;
-      this->dictionaries[triton::ast::BVUGE_NODE]              = &this->bvugeDictionary;
-      this->dictionaries[triton::ast::BVUGT_NODE]              = &this->bvugtDictionary;
-      this->dictionaries[triton::ast::BVULE_NODE]              = &this->bvuleDictionary;
-      this->dictionaries[triton::ast::BVULT_NODE]              = &this->bvultDictionary;
-      this->dictionaries[triton::ast::BVUREM_NODE]             = &this->bvuremDictionary;
-      this->dictionaries[triton::ast::BVXNOR_NODE]             = &this->bvxnorDictionary;
-      this->dictionaries[triton::ast::BVXOR_NODE]              = &this->bvxorDictionary;
-      this->dictionaries[triton::ast::BV_NODE]                 = &this->bvDictionary;
-      this->dictionaries[triton::ast::COMPOUND_NODE]           = &this->compoundDictionary;
-      this->dictionaries[triton::ast::CONCAT_NODE]             = &this->concatDictionary;
-      this->dictionaries[triton::ast::DECIMAL_NODE]            = &this->decimalDictionary;
-      this->dictionaries[triton::ast::DECLARE_FUNCTION_NODE]   = &this->declareFunctionDictionary;
-      this->dictionaries[triton::ast::DISTINCT_NODE]           = &this->distinctDictionary;
-      this->dictionaries[triton::ast::EQUAL_NODE]              = &this->equalDictionary;
-      this->dictionaries[triton::ast::EXTRACT_NODE]            = &this->extractDictionary;
-      this->dictionaries[triton::ast::ITE_NODE]                = &this->iteDictionary;
-      this->dictionaries[triton::ast::LAND_NODE]               = &this->landDictionary;
-      this->dictionaries[triton::ast::LET_NODE]                = &this->letDictionary;
-      this->dictionaries[triton::ast::LNOT_NODE]               = &this->lnotDictionary;
-      this->dictionaries[triton::ast::LOR_NODE]                = &this->lorDictionary;
-      this->dictionaries[triton::ast::REFERENCE_NODE]          = &this->referenceDictionary;
-      this->dictionaries[triton::ast::STRING_NODE]             = &this->stringDictionary;
-      this->dictionaries[triton::ast::SX_NODE]                 = &this->sxDictionary;
-      this->dictionaries[triton::ast::VARIABLE_NODE]           = &this->variableDictionary;
-      this->dictionaries[triton::ast::ZX_NODE]                 = &this->zxDictionary;
+    bool AstDictionaries::isSameNode(triton::ast::AbstractNode* node1, triton::ast::AbstractNode* node2) const {
+      if (node1->getKind() != node2->getKind())
+        return false;
+
+      if (node1->getBitvectorSize() != node2->getBitvectorSize())
+        return false;
+
+      switch (node1->getKind()) {
+        case triton::ast::DECIMAL_NODE:
+          return static_cast<triton::ast::DecimalNode*>(node1)->getValue() == static_cast<triton::ast::DecimalNode*>(node2)->getValue();
+
+        case triton::ast::REFERENCE_NODE:
+          return static_cast<triton::ast::ReferenceNode*>(node1)->getValue() == static_cast<triton::ast::ReferenceNode*>(node2)->getValue();
+
+        case triton::ast::STRING_NODE:
+          return static_cast<triton::ast::StringNode*>(node1)->getValue() == static_cast<triton::ast::StringNode*>(node2)->getValue();
+
+        case triton::ast::VARIABLE_NODE:
+          return static_cast<triton::ast::VariableNode*>(node1)->getValue() == static_cast<triton::ast::VariableNode*>(node2)->getValue();
+
+        default:
+          return node1->getChilds() == node2->getChilds();
+      }
     }
 
 
-    triton::ast::AbstractNode* AstDictionaries::browseAstDictionaries(triton::ast::AbstractNode* node) {
-      this->allocatedNodes++;
-      triton::uint32 kind = node->getKind();
+    bool AstDictionaries::isUsedSlot(const AstDictionaryEntry& entry) {
+      return (entry.node != nullptr);
+    }
 
-      switch (kind) {
 
-        case triton::ast::DECIMAL_NODE: {
-          auto value       = static_cast<triton::ast::DecimalNode*>(node)->getValue();
-          auto dictionary  = static_cast<std::map<triton::uint512, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
-          }
-          (*dictionary)[value] = node;
-          break;
-        }
+    bool AstDictionaries::isFreeSlot(const AstDictionaryEntry& entry) {
+      return (entry.node == nullptr && entry.hash != astDictionariesTombstone);
+    }
 
-        case triton::ast::REFERENCE_NODE: {
-          auto value       = static_cast<triton::ast::ReferenceNode*>(node)->getValue();
-          auto dictionary  = static_cast<std::map<triton::usize, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
-          }
-          (*dictionary)[value] = node;
-          break;
-        }
 
-        case triton::ast::STRING_NODE: {
-          auto value       = static_cast<triton::ast::StringNode*>(node)->getValue();
-          auto dictionary  = static_cast<std::map<std::string, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
+    void AstDictionaries::insertNode(triton::uint64 hash, triton::ast::AbstractNode* node) {
+      triton::usize mask  = this->dictionaries.size() - 1;
+      triton::usize index = hash & mask;
+
+      while (this->dictionaries[index].node != nullptr)
+        index = (index + 1) & mask;
+
+      this->dictionaries[index].hash = hash;
+      this->dictionaries[index].node = node;
+    }
+
+
+    void AstDictionaries::rebuildDictionaries(triton::usize size) {
+      std::vector<AstDictionaryEntry> old;
+      AstDictionaryEntry empty = {0, nullptr};
+
+      old.swap(this->dictionaries);
+      this->dictionaries.assign(size, empty);
+      this->tombstones = 0;
+
+      for (auto it = old.begin(); it != old.end(); it++) {
+        if (this->isUsedSlot(*it))
+          this->insertNode(it->hash, it->node);
+      }
+    }
+
+
+    void AstDictionaries::removeAstDictionariesNodes(const std::set<triton::ast::AbstractNode*>& nodes) {
+      triton::usize mask = this->dictionaries.size() - 1;
+
+      for (auto it = nodes.begin(); it != nodes.end(); it++) {
+        triton::usize index = (*it)->getHash() & mask;
+
+        /* Clearing a slot would break the probe sequences which go through it, so it becomes a tombstone */
+        while (!this->isFreeSlot(this->dictionaries[index])) {
+          if (this->dictionaries[index].node == *it) {
+            this->dictionaries[index].hash = astDictionariesTombstone;
+            this->dictionaries[index].node = nullptr;
+            this->allocatedDictionaries--;
+            this->tombstones++;
+            break;
           }
-          (*dictionary)[value] = node;
-          break;
+          index = (index + 1) & mask;
         }
+      }
+    }
 
-        case triton::ast::VARIABLE_NODE: {
-          auto value       = static_cast<triton::ast::VariableNode*>(node)->getValue();
-          auto dictionary  = static_cast<std::map<std::string, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
-          }
-          (*dictionary)[value] = node;
-          break;
+
+    triton::ast::AbstractNode* AstDictionaries::browseAstDictionaries(triton::ast::AbstractNode* node) {
+      triton::uint64 hash   = node->getHash();
+      triton::usize mask    = this->dictionaries.size() - 1;
+      triton::usize index   = hash & mask;
+      triton::usize probes  = 1;
+
+      this->allocatedNodes++;
+
+      triton::usize slot    = this->dictionaries.size();
+
+      while (!this->isFreeSlot(this->dictionaries[index])) {
+        AstDictionaryEntry& entry = this->dictionaries[index];
+
+        /* The first tombstone of the sequence is reused if the node is new */
+        if (!this->isUsedSlot(entry)) {
+          if (slot == this->dictionaries.size())
+            slot = index;
         }
 
-        default: {
-          auto value       = node->getChilds();
-          auto dictionary  = static_cast<std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*>*>((this->dictionaries[kind]));
-          if (dictionary->find(value) != dictionary->end()) {
-            delete node;
-            return (*dictionary)[value];
+        else if (entry.hash == hash && this->isSameNode(entry.node, node)) {
+          this->totalProbes += probes;
+          if (probes > this->maxProbeLength)
+            this->maxProbeLength = probes;
+
+          /* The node has already been linked to its childs by init(), unlink it before freeing it */
+          triton::ast::AstChilds& childs = node->getChilds();
+          for (triton::uint32 i = 0; i < childs.size(); i++)
+            childs[i]->removeParent(node);
+
+          if (node->getKind() == triton::ast::REFERENCE_NODE) {
+            triton::usize id = static_cast<triton::ast::ReferenceNode*>(node)->getValue();
+            if (triton::api.isSymbolicExpressionIdExists(id))
+              triton::api.getAstFromId(id)->removeParent(node);
           }
-          (*dictionary)[value] = node;
-          break;
+
+          delete node;
+          return entry.node;
         }
 
+        index = (index + 1) & mask;
+        probes++;
       }
 
+      this->totalProbes += probes;
+      if (probes > this->maxProbeLength)
+        this->maxProbeLength = probes;
+
+      if (slot != this->dictionaries.size()) {
+        index = slot;
+        this->tombstones--;
+      }
+
+      this->dictionaries[index].hash = hash;
+      this->dictionaries[index].node = node;
       this->allocatedDictionaries++;
+
+      /* Keep the load factor (tombstones included) under 1/2 to keep probe sequences short */
+      if ((this->allocatedDictionaries + this->tombstones) * 2 > this->dictionaries.size()) {
+        if (this->allocatedDictionaries * 4 > this->dictionaries.size())
+          this->rebuildDictionaries(this->dictionaries.size() * 2);
+        else
+          this->rebuildDictionaries(this->dictionaries.size());
+      }
+
       return nullptr;
     }
 
 
     std::map<std::string, triton::usize> AstDictionaries::getAstDictionariesStats(void) {
       std::map<std::string, triton::usize> stats;
-      stats["assert"]                 = this->assertDictionary.size();
-      stats["bvadd"]                  = this->bvaddDictionary.size();
-      stats["bvand"]                  = this->bvandDictionary.size();
-      stats["bvashr"]                 = this->bvashrDictionary.size();
-      stats["bvdecl"]                 = this->bvdeclDictionary.size();
-      stats["bvlshr"]                 = this->bvlshrDictionary.size();
-      stats["bvmul"]                  = this->bvmulDictionary.size();
-      stats["bvnand"]                 = this->bvnandDictionary.size();
-      stats["bvneg"]                  = this->bvnegDictionary.size();
-      stats["bvnor"]                  = this->bvnorDictionary.size();
-      stats["bvnot"]                  = this->bvnotDictionary.size();
-      stats["bvor"]                   = this->bvorDictionary.size();
-      stats["bvrol"]                  = this->bvrolDictionary.size();
-      stats["bvror"]                  = this->bvrorDictionary.size();
-      stats["bvsdiv"]                 = this->bvsdivDictionary.size();
-      stats["bvsge"]                  = this->bvsgeDictionary.size();
-      stats["bvsgt"]                  = this->bvsgtDictionary.size();
-      stats["bvshl"]                  = this->bvshlDictionary.size();
-      stats["bvsle"]                  = this->bvsleDictionary.size();
-      stats["bvslt"]                  = this->bvsltDictionary.size();
-      stats["bvsmod"]                 = this->bvsmodDictionary.size();
-      stats["bvsrem"]                 = this->bvsremDictionary.size();
-      stats["bvsub"]                  = this->bvsubDictionary.size();
-      stats["bvudiv"]                 = this->bvudivDictionary.size();
-      stats["bvuge"]                  = this->bvugeDictionary.size();
-      stats["bvugt"]                  = this->bvugtDictionary.size();
-      stats["bvule"]                  = this->bvuleDictionary.size();
-      stats["bvult"]                  = this->bvultDictionary.size();
-      stats["bvurem"]                 = this->bvuremDictionary.size();
-      stats["bvxnor"]                 = this->bvxnorDictionary.size();
-      stats["bvxor"]                  = this->bvxorDictionary.size();
-      stats["bv"]                     = this->bvDictionary.size();
-      stats["compound"]               = this->compoundDictionary.size();
-      stats["concat"]                 = this->concatDictionary.size();
-      stats["decimal"]                = this->decimalDictionary.size();
-      stats["declareFunction"]        = this->declareFunctionDictionary.size();
-      stats["distinct"]               = this->distinctDictionary.size();
-      stats["equal"]                  = this->equalDictionary.size();
-      stats["extract"]                = this->extractDictionary.size();
-      stats["ite"]                    = this->iteDictionary.size();
-      stats["land"]                   = this->landDictionary.size();
-      stats["let"]                    = this->letDictionary.size();
-      stats["lnot"]                   = this->lnotDictionary.size();
-      stats["lor"]                    = this->lorDictionary.size();
-      stats["reference"]              = this->referenceDictionary.size();
-      stats["string"]                 = this->stringDictionary.size();
-      stats["sx"]                     = this->sxDictionary.size();
-      stats["variable"]               = this->variableDictionary.size();
-      stats["zx"]                     = this->zxDictionary.size();
+      std::map<triton::uint32, triton::usize> kinds;
+
+      static const std::pair<triton::uint32, const char*> names[] = {
+        {triton::ast::ASSERT_NODE,            "assert"},
+        {triton::ast::BVADD_NODE,             "bvadd"},
+        {triton::ast::BVAND_NODE,             "bvand"},
+        {triton::ast::BVASHR_NODE,            "bvashr"},
+        {triton::ast::BVDECL_NODE,            "bvdecl"},
+        {triton::ast::BVLSHR_NODE,            "bvlshr"},
+        {triton::ast::BVMUL_NODE,             "bvmul"},
+        {triton::ast::BVNAND_NODE,            "bvnand"},
+        {triton::ast::BVNEG_NODE,             "bvneg"},
+        {triton::ast::BVNOR_NODE,             "bvnor"},
+        {triton::ast::BVNOT_NODE,             "bvnot"},
+        {triton::ast::BVOR_NODE,              "bvor"},
+        {triton::ast::BVROL_NODE,             "bvrol"},
+        {triton::ast::BVROR_NODE,             "bvror"},
+        {triton::ast::BVSDIV_NODE,            "bvsdiv"},
+        {triton::ast::BVSGE_NODE,             "bvsge"},
+        {triton::ast::BVSGT_NODE,             "bvsgt"},
+        {triton::ast::BVSHL_NODE,             "bvshl"},
+        {triton::ast::BVSLE_NODE,             "bvsle"},
+        {triton::ast::BVSLT_NODE,             "bvslt"},
+        {triton::ast::BVSMOD_NODE,            "bvsmod"},
+        {triton::ast::BVSREM_NODE,            "bvsrem"},
+        {triton::ast::BVSUB_NODE,             "bvsub"},
+        {triton::ast::BVUDIV_NODE,            "bvudiv"},
+        {triton::ast::BVUGE_NODE,             "bvuge"},
+        {triton::ast::BVUGT_NODE,             "bvugt"},
+        {triton::ast::BVULE_NODE,             "bvule"},
+        {triton::ast::BVULT_NODE,             "bvult"},
+        {triton::ast::BVUREM_NODE,            "bvurem"},
+        {triton::ast::BVXNOR_NODE,            "bvxnor"},
+        {triton::ast::BVXOR_NODE,             "bvxor"},
+        {triton::ast::BV_NODE,                "bv"},
+        {triton::ast::COMPOUND_NODE,          "compound"},
+        {triton::ast::CONCAT_NODE,            "concat"},
+        {triton::ast::DECIMAL_NODE,           "decimal"},
+        {triton::ast::DECLARE_FUNCTION_NODE,  "declareFunction"},
+        {triton::ast::DISTINCT_NODE,          "distinct"},
+        {triton::ast::EQUAL_NODE,             "equal"},
+        {triton::ast::EXTRACT_NODE,           "extract"},
+        {triton::ast::ITE_NODE,               "ite"},
+        {triton::ast::LAND_NODE,              "land"},
+        {triton::ast::LET_NODE,               "let"},
+        {triton::ast::LNOT_NODE,              "lnot"},
+        {triton::ast::LOR_NODE,               "lor"},
+        {triton::ast::REFERENCE_NODE,         "reference"},
+        {triton::ast::STRING_NODE,            "string"},
+        {triton::ast::SX_NODE,                "sx"},
+        {triton::ast::VARIABLE_NODE,          "variable"},
+        {triton::ast::ZX_NODE,                "zx"},
+      };
+
+      for (auto it = this->dictionaries.begin(); it != this->dictionaries.end(); it++) {
+        if (it->node != nullptr)
+          kinds[it->node->getKind()]++;
+      }
+
+      for (triton::uint32 index = 0; index < sizeof(names) / sizeof(names[0]); index++)
+        stats[names[index].second] = kinds[names[index].first];
+
       stats["allocatedDictionaries"]  = this->allocatedDictionaries;
       stats["allocatedNodes"]         = this->allocatedNodes;
+      stats["capacity"]               = this->dictionaries.size();
+      stats["loadFactor"]             = (this->allocatedDictionaries * 100) / this->dictionaries.size();
+      stats["totalProbes"]            = this->totalProbes;
+      stats["maxProbeLength"]         = this->maxProbeLength;
       return stats;
     }
 
@@ -369,4 +281,3 @@ namespace triton {
 
   }; /* ast namespace */
 }; /*triton namespace */
-
@@ -14,31 +14,266 @@ namespace triton {
   namespace ast {
 
     AstGarbageCollector::AstGarbageCollector() {
+      this->allocatedSinceCollection = 0;
+      this->epoch                    = 0;
+      this->liveAfterCollection      = 0;
+      this->parentIndexed            = false;
+      this->templateHoles            = 0;
     }
 
 
     AstGarbageCollector::~AstGarbageCollector() {
-      this->freeAllAstNodes();
+      /* Every node has been carved from our slabs, so we free all of them whoever owns them */
+      for (triton::uint32 index = 0; index < this->pools.size(); index++) {
+        AstSlabPool& pool = this->pools[index];
+        for (triton::usize slab = 0; slab < pool.slabs.size(); slab++) {
+          for (triton::usize cell = 0; cell < this->getSlabCells(pool, slab); cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if ((header->flags & AST_CELL_FREE) == 0)
+              reinterpret_cast<triton::ast::AbstractNode*>(header + 1)->~AbstractNode();
+          }
+          delete[] pool.slabs[slab];
+        }
+      }
     }
 
 
-    void AstGarbageCollector::freeAllAstNodes(void) {
-      std::set<triton::ast::AbstractNode*>::iterator it;
+    AstCellHeader* AstGarbageCollector::getCellHeader(triton::ast::AbstractNode* node) {
+      return reinterpret_cast<AstCellHeader*>(node) - 1;
+    }
 
-      for (it = this->allocatedNodes.begin(); it != this->allocatedNodes.end(); it++)
-        delete *it;
 
+    triton::usize AstGarbageCollector::getSlabCells(const AstSlabPool& pool, triton::usize slab) const {
+      /* Only the last slab may be partially carved */
+      if (slab + 1 == pool.slabs.size())
+        return pool.used;
+      return triton::ast::AST_SLAB_CELLS;
+    }
+
+
+    void* AstGarbageCollector::allocateAstNode(triton::usize size) {
+      triton::uint32 index  = static_cast<triton::uint32>((size + sizeof(AstCellHeader) - 1) / sizeof(AstCellHeader));
+      AstCellHeader* header = nullptr;
+
+      /* Create the pools up to this size class */
+      while (this->pools.size() <= index) {
+        AstSlabPool pool;
+        pool.cellSize = (this->pools.size() + 1) * sizeof(AstCellHeader);
+        pool.used     = 0;
+        pool.freeList = nullptr;
+        this->pools.push_back(pool);
+      }
+
+      AstSlabPool& pool = this->pools[index];
+
+      /* Reuse a freed cell if there is one */
+      if (pool.freeList != nullptr) {
+        header = pool.freeList;
+        pool.freeList = *reinterpret_cast<AstCellHeader**>(header + 1);
+      }
+
+      /* Otherwise, carve a new cell */
+      else {
+        if (pool.slabs.empty() || pool.used == triton::ast::AST_SLAB_CELLS) {
+          pool.slabs.push_back(new triton::uint8[pool.cellSize * triton::ast::AST_SLAB_CELLS]);
+          pool.used = 0;
+        }
+        header = reinterpret_cast<AstCellHeader*>(pool.slabs.back() + pool.used * pool.cellSize);
+        pool.used++;
+      }
+
+      /* Every node is recorded, only the roots and the pinned nodes keep it alive across a collection */
+      header->epoch = this->epoch;
+      header->flags = AST_CELL_RECORDED;
+      header->pool  = index;
+
+      this->allocatedSinceCollection++;
+
+      return header + 1;
+    }
+
+
+    void AstGarbageCollector::deallocateAstNode(void* ptr) {
+      AstCellHeader* header = reinterpret_cast<AstCellHeader*>(ptr) - 1;
+      AstSlabPool& pool     = this->pools[header->pool];
+
+      if (!this->pinnedNodes.empty())
+        this->pinnedNodes.erase(reinterpret_cast<triton::ast::AbstractNode*>(ptr));
+
+      if (this->parentIndexed)
+        this->parentIndex.erase(reinterpret_cast<triton::ast::AbstractNode*>(ptr));
+
+      header->flags = AST_CELL_FREE;
+      *reinterpret_cast<AstCellHeader**>(header + 1) = pool.freeList;
+      pool.freeList = header;
+    }
+
+
+    void AstGarbageCollector::spareDoomedAstNodes(void) {
+      std::vector<triton::ast::AbstractNode*> worklist;
+
+      for (std::map<triton::ast::AbstractNode*, triton::usize>::const_iterator it = this->pinnedNodes.begin(); it != this->pinnedNodes.end(); it++)
+        worklist.push_back(it->first);
+
+      /* A spared node is not doomed anymore, so each node is visited once */
+      while (!worklist.empty()) {
+        triton::ast::AbstractNode* node = worklist.back();
+
+        worklist.pop_back();
+        AstCellHeader* header = AstGarbageCollector::getCellHeader(node);
+        if ((header->flags & AST_CELL_DOOMED) == 0)
+          continue;
+
+        header->flags &= ~AST_CELL_DOOMED;
+        const triton::ast::AstChilds& childs = node->getChilds();
+        for (triton::uint32 i = 0; i < childs.size(); i++)
+          worklist.push_back(childs[i]);
+      }
+    }
+
+
+    void AstGarbageCollector::freeDoomedAstNodes(void) {
+      std::set<triton::ast::AbstractNode*> doomed;
+
+      /* Drop doomed and freed nodes from the parent index before their slabs are given back */
+      if (this->parentIndexed) {
+        std::map<triton::ast::AbstractNode*, std::set<triton::ast::AbstractNode*>>::iterator it;
+
+        this->flushParentIndex();
+        for (it = this->parentIndex.begin(); it != this->parentIndex.end();) {
+          if (AstGarbageCollector::getCellHeader(it->first)->flags & (AST_CELL_DOOMED | AST_CELL_FREE)) {
+            this->parentIndex.erase(it++);
+            continue;
+          }
+          for (std::set<triton::ast::AbstractNode*>::iterator parent = it->second.begin(); parent != it->second.end();) {
+            if (AstGarbageCollector::getCellHeader(*parent)->flags & (AST_CELL_DOOMED | AST_CELL_FREE))
+              it->second.erase(parent++);
+            else
+              parent++;
+          }
+          it++;
+        }
+      }
+
+      /* Unlink doomed nodes from their surviving childs and from the variables map */
+      for (triton::uint32 index = 0; index < this->pools.size(); index++) {
+        AstSlabPool& pool = this->pools[index];
+        for (triton::usize slab = 0; slab < pool.slabs.size(); slab++) {
+          for (triton::usize cell = 0; cell < this->getSlabCells(pool, slab); cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if ((header->flags & AST_CELL_DOOMED) == 0)
+              continue;
+
+            triton::ast::AbstractNode* node = reinterpret_cast<triton::ast::AbstractNode*>(header + 1);
+            triton::ast::AstChilds& childs = node->getChilds();
+            for (triton::uint32 i = 0; i < childs.size(); i++) {
+              if ((AstGarbageCollector::getCellHeader(childs[i])->flags & (AST_CELL_DOOMED | AST_CELL_FREE)) == 0)
+                childs[i]->removeParent(node);
+            }
+
+            if (node->getKind() == triton::ast::REFERENCE_NODE) {
+              triton::usize id = reinterpret_cast<triton::ast::ReferenceNode*>(node)->getValue();
+              if (triton::api.isSymbolicExpressionIdExists(id)) {
+                triton::ast::AbstractNode* ast = triton::api.getAstFromId(id);
+                if ((AstGarbageCollector::getCellHeader(ast)->flags & (AST_CELL_DOOMED | AST_CELL_FREE)) == 0)
+                  ast->removeParent(node);
+              }
+            }
+
+            if (node->getKind() == triton::ast::VARIABLE_NODE)
+              this->variableNodes.erase(reinterpret_cast<triton::ast::VariableNode*>(node)->getValue());
+
+            if (!this->pinnedNodes.empty())
+              this->pinnedNodes.erase(node);
+
+            doomed.insert(node);
+          }
+        }
+      }
+
+      /* The rewrites of the doomed nodes do not need to be restored */
+      for (triton::usize index = 0; index < this->undoChilds.size();) {
+        if (AstGarbageCollector::getCellHeader(std::get<0>(this->undoChilds[index]))->flags & AST_CELL_DOOMED) {
+          this->undoChilds[index] = this->undoChilds.back();
+          this->undoChilds.pop_back();
+        }
+        else
+          index++;
+      }
+
+      /* The dictionaries do not own their nodes, drop the doomed ones before they are freed */
+      triton::api.removeAstDictionariesNodes(doomed);
+
+      /* Free doomed nodes and give back the slabs which became empty */
+      for (triton::uint32 index = 0; index < this->pools.size(); index++) {
+        AstSlabPool& pool = this->pools[index];
+        std::vector<triton::uint8*> slabs;
+        triton::usize used = triton::ast::AST_SLAB_CELLS;
+
+        pool.freeList = nullptr;
+
+        for (triton::usize slab = 0; slab < pool.slabs.size(); slab++) {
+          triton::usize cells = this->getSlabCells(pool, slab);
+          triton::usize live  = 0;
+
+          for (triton::usize cell = 0; cell < cells; cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if (header->flags & AST_CELL_DOOMED) {
+              reinterpret_cast<triton::ast::AbstractNode*>(header + 1)->~AbstractNode();
+              header->flags = AST_CELL_FREE;
+            }
+            if ((header->flags & AST_CELL_FREE) == 0)
+              live++;
+          }
+
+          if (live == 0) {
+            delete[] pool.slabs[slab];
+            continue;
+          }
+
+          /* Rebuild the free list with the cells of the kept slabs */
+          for (triton::usize cell = 0; cell < cells; cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if (header->flags & AST_CELL_FREE) {
+              *reinterpret_cast<AstCellHeader**>(header + 1) = pool.freeList;
+              pool.freeList = header;
+            }
+          }
+
+          slabs.push_back(pool.slabs[slab]);
+          used = cells;
+        }
+
+        pool.slabs.swap(slabs);
+        pool.used = used;
+      }
+    }
+
+
+    void AstGarbageCollector::freeAllAstNodes(void) {
+      for (triton::uint32 index = 0; index < this->pools.size(); index++) {
+        AstSlabPool& pool = this->pools[index];
+        for (triton::usize slab = 0; slab < pool.slabs.size(); slab++) {
+          for (triton::usize cell = 0; cell < this->getSlabCells(pool, slab); cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if (header->flags & AST_CELL_RECORDED)
+              header->flags |= AST_CELL_DOOMED;
+          }
+        }
+      }
+
+      this->spareDoomedAstNodes();
+      this->clearAstTemplates();
+      this->freeDoomedAstNodes();
       this->variableNodes.clear();
-      this->allocatedNodes.clear();
     }
 
 
     void AstGarbageCollector::freeAstNodes(std::set<triton::ast::AbstractNode*>& nodes) {
       std::set<triton::ast::AbstractNode*>::iterator it;
-      for (it = nodes.begin(); it != nodes.end(); it++) {
-        /* Remove the node from the global set */
-        this->allocatedNodes.erase(*it);
 
+      triton::api.removeAstDictionariesNodes(nodes);
+      for (it = nodes.begin(); it != nodes.end(); it++) {
         /* Remove the node from the global variables map */
         if ((*it)->getKind() == triton::ast::VARIABLE_NODE)
           this->variableNodes.erase(reinterpret_cast<triton::ast::VariableNode*>(*it)->getValue());
@@ -51,24 +286,281 @@ namespace triton {
 
 
     void AstGarbageCollector::extractUniqueAstNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, triton::ast::AbstractNode* root) const {
-      std::vector<triton::ast::AbstractNode*>::const_iterator it;
+      triton::ast::AstChilds::const_iterator it;
       uniqueNodes.insert(root);
       for (it = root->getChilds().begin(); it != root->getChilds().end(); it++)
         this->extractUniqueAstNodes(uniqueNodes, *it);
     }
 
 
+    triton::usize AstGarbageCollector::markAstNodes(void) {
+      this->undoChilds.clear();
+      return ++this->epoch;
+    }
+
+
+    void AstGarbageCollector::logChildAstNode(triton::ast::AbstractNode* node, triton::uint32 index) {
+      if (AstGarbageCollector::getCellHeader(node)->epoch < this->epoch)
+        this->undoChilds.push_back(std::make_tuple(node, index, node->getChilds()[index]));
+    }
+
+
+    void AstGarbageCollector::freeAstNodesSinceMark(triton::usize mark) {
+      /* Older nodes must not point to the nodes of the mark anymore, replay the undo log backward */
+      for (triton::usize index = this->undoChilds.size(); index > 0; index--) {
+        triton::ast::AbstractNode* node  = std::get<0>(this->undoChilds[index - 1]);
+        triton::ast::AbstractNode* child = std::get<2>(this->undoChilds[index - 1]);
+        triton::ast::AbstractNode*& slot = node->getChilds()[std::get<1>(this->undoChilds[index - 1])];
+        slot->removeParent(node);
+        slot = child;
+        child->setParent(node);
+      }
+      this->undoChilds.clear();
+
+      for (triton::uint32 index = 0; index < this->pools.size(); index++) {
+        AstSlabPool& pool = this->pools[index];
+        for (triton::usize slab = 0; slab < pool.slabs.size(); slab++) {
+          for (triton::usize cell = 0; cell < this->getSlabCells(pool, slab); cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if ((header->flags & AST_CELL_RECORDED) && header->epoch >= mark)
+              header->flags |= AST_CELL_DOOMED;
+          }
+        }
+      }
+
+      this->spareDoomedAstNodes();
+      this->clearAstTemplates();
+      this->freeDoomedAstNodes();
+    }
+
+
+    bool AstGarbageCollector::isParentAstNode(triton::ast::AbstractNode* parent, triton::ast::AbstractNode* node) const {
+      if (AstGarbageCollector::getCellHeader(parent)->flags & (AST_CELL_DOOMED | AST_CELL_FREE))
+        return false;
+
+      const triton::ast::AstChilds& childs = parent->getChilds();
+      for (triton::uint32 index = 0; index < childs.size(); index++) {
+        if (childs[index] == node)
+          return true;
+      }
+
+      if (parent->getKind() == triton::ast::REFERENCE_NODE) {
+        triton::usize id = reinterpret_cast<triton::ast::ReferenceNode*>(parent)->getValue();
+        if (triton::api.isSymbolicExpressionIdExists(id) && triton::api.getAstFromId(id) == node)
+          return true;
+      }
+
+      return false;
+    }
+
+
+    void AstGarbageCollector::buildParentIndex(void) {
+      this->parentIndex.clear();
+      this->unindexedParents.clear();
+
+      for (triton::uint32 index = 0; index < this->pools.size(); index++) {
+        AstSlabPool& pool = this->pools[index];
+        for (triton::usize slab = 0; slab < pool.slabs.size(); slab++) {
+          for (triton::usize cell = 0; cell < this->getSlabCells(pool, slab); cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if (header->flags & (AST_CELL_DOOMED | AST_CELL_FREE))
+              continue;
+
+            triton::ast::AbstractNode* node = reinterpret_cast<triton::ast::AbstractNode*>(header + 1);
+            const triton::ast::AstChilds& childs = node->getChilds();
+            for (triton::uint32 i = 0; i < childs.size(); i++)
+              this->parentIndex[childs[i]].insert(node);
+
+            if (node->getKind() == triton::ast::REFERENCE_NODE) {
+              triton::usize id = reinterpret_cast<triton::ast::ReferenceNode*>(node)->getValue();
+              if (triton::api.isSymbolicExpressionIdExists(id))
+                this->parentIndex[triton::api.getAstFromId(id)].insert(node);
+            }
+          }
+        }
+      }
+
+      this->parentIndexed = true;
+    }
+
+
+    void AstGarbageCollector::flushParentIndex(void) {
+      for (triton::usize index = 0; index < this->unindexedParents.size(); index++) {
+        triton::ast::AbstractNode* node   = this->unindexedParents[index].first;
+        triton::ast::AbstractNode* parent = this->unindexedParents[index].second;
+
+        if ((AstGarbageCollector::getCellHeader(node)->flags & (AST_CELL_DOOMED | AST_CELL_FREE)) == 0 &&
+            (AstGarbageCollector::getCellHeader(parent)->flags & (AST_CELL_DOOMED | AST_CELL_FREE)) == 0)
+          this->parentIndex[node].insert(parent);
+      }
+
+      this->unindexedParents.clear();
+    }
+
+
+    void AstGarbageCollector::linkParentAstNode(triton::ast::AbstractNode* node, triton::ast::AbstractNode* parent) {
+      AstGarbageCollector::getCellHeader(node)->flags |= AST_CELL_PARENTED;
+
+      if (!this->parentIndexed)
+        return;
+
+      this->unindexedParents.push_back(std::make_pair(node, parent));
+
+      /* Once the log outgrows the index, rebuilding it on the next lookup is cheaper than folding the log */
+      if (this->unindexedParents.size() > (2 * this->parentIndex.size()) + triton::ast::AST_SLAB_CELLS) {
+        this->parentIndex.clear();
+        this->unindexedParents.clear();
+        this->parentIndexed = false;
+      }
+    }
+
+
+    void AstGarbageCollector::unlinkParentAstNode(triton::ast::AbstractNode* node, triton::ast::AbstractNode* parent) {
+      if (!this->parentIndexed)
+        return;
+
+      std::map<triton::ast::AbstractNode*, std::set<triton::ast::AbstractNode*>>::iterator it = this->parentIndex.find(node);
+      if (it != this->parentIndex.end())
+        it->second.erase(parent);
+    }
+
+
+    std::set<triton::ast::AbstractNode*> AstGarbageCollector::getParentAstNodes(triton::ast::AbstractNode* node) {
+      std::set<triton::ast::AbstractNode*> parents;
+
+      /* A node which has never been linked has no parent, this is the case of all new nodes */
+      if ((AstGarbageCollector::getCellHeader(node)->flags & AST_CELL_PARENTED) == 0)
+        return parents;
+
+      if (!this->parentIndexed)
+        this->buildParentIndex();
+      else
+        this->flushParentIndex();
+
+      std::map<triton::ast::AbstractNode*, std::set<triton::ast::AbstractNode*>>::iterator it = this->parentIndex.find(node);
+      if (it == this->parentIndex.end())
+        return parents;
+
+      /* Drop the parents which do not point to the node anymore */
+      for (std::set<triton::ast::AbstractNode*>::iterator parent = it->second.begin(); parent != it->second.end();) {
+        if (this->isParentAstNode(*parent, node)) {
+          parents.insert(*parent);
+          parent++;
+        }
+        else
+          it->second.erase(parent++);
+      }
+
+      return parents;
+    }
+
+
+    void AstGarbageCollector::pinAstNode(triton::ast::AbstractNode* node) {
+      if (node != nullptr)
+        this->pinnedNodes[node]++;
+    }
+
+
+    void AstGarbageCollector::unpinAstNode(triton::ast::AbstractNode* node) {
+      std::map<triton::ast::AbstractNode*, triton::usize>::iterator it = this->pinnedNodes.find(node);
+
+      if (it == this->pinnedNodes.end())
+        return;
+
+      if (--it->second == 0)
+        this->pinnedNodes.erase(it);
+    }
+
+
+    triton::usize AstGarbageCollector::collectAstNodes(void) {
+      std::vector<triton::ast::AbstractNode*> worklist;
+      triton::usize freed = 0;
+      triton::usize live  = 0;
+
+      /* Roots from the symbolic engine */
+      triton::api.extractAstRoots(worklist);
+
+      /* Roots from the variables and the pinned nodes */
+      for (std::map<std::string, triton::ast::AbstractNode*>::const_iterator it = this->variableNodes.begin(); it != this->variableNodes.end(); it++)
+        worklist.push_back(it->second);
+
+      for (std::map<triton::ast::AbstractNode*, triton::usize>::const_iterator it = this->pinnedNodes.begin(); it != this->pinnedNodes.end(); it++)
+        worklist.push_back(it->first);
+
+      /* Roots from the templates */
+      for (std::map<triton::uint64, triton::ast::AstTemplate>::const_iterator it = this->templates.begin(); it != this->templates.end(); it++)
+        it->second.extractRoots(worklist);
+
+      /* Roots from the undo log, the previous childs are restored by freeAstNodesSinceMark() */
+      for (triton::usize index = 0; index < this->undoChilds.size(); index++)
+        worklist.push_back(std::get<2>(this->undoChilds[index]));
+
+      /* Mark every node reachable from the roots */
+      while (!worklist.empty()) {
+        triton::ast::AbstractNode* node = worklist.back();
+
+        worklist.pop_back();
+        if (node == nullptr)
+          continue;
+
+        AstCellHeader* header = AstGarbageCollector::getCellHeader(node);
+        if (header->flags & (AST_CELL_FREE | AST_CELL_MARKED))
+          continue;
+
+        header->flags |= AST_CELL_MARKED;
+        const triton::ast::AstChilds& childs = node->getChilds();
+        for (triton::uint32 i = 0; i < childs.size(); i++)
+          worklist.push_back(childs[i]);
+      }
+
+      /* Sweep the recorded nodes which have not been reached */
+      for (triton::uint32 index = 0; index < this->pools.size(); index++) {
+        AstSlabPool& pool = this->pools[index];
+        for (triton::usize slab = 0; slab < pool.slabs.size(); slab++) {
+          for (triton::usize cell = 0; cell < this->getSlabCells(pool, slab); cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if (header->flags & AST_CELL_FREE)
+              continue;
+            if ((header->flags & (AST_CELL_RECORDED | AST_CELL_MARKED)) == AST_CELL_RECORDED) {
+              header->flags |= AST_CELL_DOOMED;
+              freed++;
+            }
+            else
+              live++;
+            header->flags &= ~AST_CELL_MARKED;
+          }
+        }
+      }
+
+      if (freed)
+        this->freeDoomedAstNodes();
+
+      this->allocatedSinceCollection = 0;
+      this->liveAfterCollection      = live;
+
+      return freed;
+    }
+
+
+    void AstGarbageCollector::collectAstNodesIfNeeded(void) {
+      /* Amortize the cost of a collection over as many allocations as there are live nodes */
+      if (this->allocatedSinceCollection < triton::ast::AST_COLLECTION_THRESHOLD)
+        return;
+
+      if (this->allocatedSinceCollection < this->liveAfterCollection)
+        return;
+
+      this->collectAstNodes();
+    }
+
+
     triton::ast::AbstractNode* AstGarbageCollector::recordAstNode(triton::ast::AbstractNode* node) {
-      /* Check if the AST_DICTIONARIES is enabled. */
+      /* The node has been recorded by allocateAstNode(), only look for an existing one if the AST_DICTIONARIES is enabled */
       if (triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::AST_DICTIONARIES)) {
         triton::ast::AbstractNode* ret = triton::api.browseAstDictionaries(node);
         if (ret != nullptr)
           return ret;
       }
-      else {
-        /* Record the node */
-        this->allocatedNodes.insert(node);
-      }
       return node;
     }
 
@@ -78,8 +570,21 @@ namespace triton {
     }
 
 
-    const std::set<triton::ast::AbstractNode*>& AstGarbageCollector::getAllocatedAstNodes(void) const {
-      return this->allocatedNodes;
+    std::set<triton::ast::AbstractNode*> AstGarbageCollector::getAllocatedAstNodes(void) const {
+      std::set<triton::ast::AbstractNode*> nodes;
+
+      for (triton::uint32 index = 0; index < this->pools.size(); index++) {
+        const AstSlabPool& pool = this->pools[index];
+        for (triton::usize slab = 0; slab < pool.slabs.size(); slab++) {
+          for (triton::usize cell = 0; cell < this->getSlabCells(pool, slab); cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if (header->flags & AST_CELL_RECORDED)
+              nodes.insert(reinterpret_cast<triton::ast::AbstractNode*>(header + 1));
+          }
+        }
+      }
+
+      return nodes;
     }
 
 
@@ -97,11 +602,22 @@ namespace triton {
 
     void AstGarbageCollector::setAllocatedAstNodes(const std::set<triton::ast::AbstractNode*>& nodes) {
       /* Remove unused nodes before the assignation */
-      for (std::set<triton::ast::AbstractNode*>::iterator it = this->allocatedNodes.begin(); it != this->allocatedNodes.end(); it++) {
-        if (nodes.find(*it) == nodes.end())
-          delete *it;
+      for (triton::uint32 index = 0; index < this->pools.size(); index++) {
+        AstSlabPool& pool = this->pools[index];
+        for (triton::usize slab = 0; slab < pool.slabs.size(); slab++) {
+          for (triton::usize cell = 0; cell < this->getSlabCells(pool, slab); cell++) {
+            AstCellHeader* header = reinterpret_cast<AstCellHeader*>(pool.slabs[slab] + cell * pool.cellSize);
+            if (header->flags & AST_CELL_FREE)
+              continue;
+            if (nodes.find(reinterpret_cast<triton::ast::AbstractNode*>(header + 1)) == nodes.end())
+              header->flags |= AST_CELL_DOOMED;
+          }
+        }
       }
-      this->allocatedNodes = nodes;
+
+      this->spareDoomedAstNodes();
+      this->clearAstTemplates();
+      this->freeDoomedAstNodes();
     }
 
 
@@ -109,6 +625,32 @@ namespace triton {
       this->variableNodes = nodes;
     }
 
+
+    triton::ast::AbstractNode* AstGarbageCollector::newAstTemplateHole(triton::uint32 size) {
+      /* A reference to an id which does not exist has no size, the hole gets the size of the values it stands for */
+      triton::ast::AbstractNode* node = triton::ast::reference(triton::ast::AST_TEMPLATE_HOLE_ID - this->templateHoles++);
+      node->setBitvectorSize(size);
+      return node;
+    }
+
+
+    const triton::ast::AstTemplate* AstGarbageCollector::getAstTemplate(triton::uint64 key) const {
+      std::map<triton::uint64, triton::ast::AstTemplate>::const_iterator it = this->templates.find(key);
+      if (it == this->templates.end())
+        return nullptr;
+      return &it->second;
+    }
+
+
+    const triton::ast::AstTemplate* AstGarbageCollector::recordAstTemplate(triton::uint64 key, const triton::ast::AstTemplate& tpl) {
+      this->templates.erase(key);
+      return &this->templates.insert(std::make_pair(key, tpl)).first->second;
+    }
+
+
+    void AstGarbageCollector::clearAstTemplates(void) {
+      this->templates.clear();
+    }
+
   }; /* ast namespace */
 }; /*triton namespace */
-
@@ -0,0 +1,140 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <stdexcept>
+
+#include <api.hpp>
+#include <astTemplate.hpp>
+
+
+
+namespace triton {
+  namespace ast {
+
+    AstTemplate::AstTemplate(AbstractNode* root, const std::vector<AbstractNode*>& holes) {
+      std::map<AbstractNode*, triton::sint32> visited;
+
+      if (root == nullptr)
+        throw std::invalid_argument("AstTemplate::AstTemplate(): root cannot be null.");
+
+      this->root  = root;
+      this->holes = holes;
+
+      for (triton::uint32 index = 0; index < holes.size(); index++)
+        visited[holes[index]] = index;
+
+      this->rootSource = this->extractNodes(root, visited);
+    }
+
+
+    AstTemplate::AstTemplate(const AstTemplate& copy) {
+      this->root       = copy.root;
+      this->rootSource = copy.rootSource;
+      this->holes      = copy.holes;
+      this->nodes      = copy.nodes;
+      this->sources    = copy.sources;
+    }
+
+
+    AstTemplate::~AstTemplate() {
+      /* Nodes are carved from the slabs of the AST garbage collector which frees them */
+    }
+
+
+    triton::sint32 AstTemplate::extractNodes(AbstractNode* node, std::map<AbstractNode*, triton::sint32>& visited) {
+      std::map<AbstractNode*, triton::sint32>::iterator it = visited.find(node);
+      std::vector<triton::sint32> childs;
+      triton::sint32 source = -1;
+
+      if (it != visited.end())
+        return it->second;
+
+      for (triton::uint32 index = 0; index < node->getChilds().size(); index++) {
+        childs.push_back(this->extractNodes(node->getChilds()[index], visited));
+        if (childs.back() != -1)
+          source = 0;
+      }
+
+      /* The node depends on a hole, it will be duplicated by the instances */
+      if (source != -1) {
+        this->nodes.push_back(node);
+        this->sources.push_back(childs);
+        source = static_cast<triton::sint32>(this->holes.size() + this->nodes.size() - 1);
+      }
+
+      visited[node] = source;
+      return source;
+    }
+
+
+    triton::usize AstTemplate::getNumberOfHoles(void) const {
+      return this->holes.size();
+    }
+
+
+    void AstTemplate::extractRoots(std::vector<AbstractNode*>& roots) const {
+      roots.push_back(this->root);
+      roots.insert(roots.end(), this->holes.begin(), this->holes.end());
+    }
+
+
+    AbstractNode* AstTemplate::instantiate(const std::vector<AbstractNode*>& values) const {
+      std::vector<AbstractNode*> instances = values;
+
+      if (values.size() != this->holes.size())
+        throw std::invalid_argument("AstTemplate::instantiate(): Wrong number of values.");
+
+      if (this->rootSource == -1)
+        return this->root;
+
+      instances.reserve(this->holes.size() + this->nodes.size());
+      for (triton::usize index = 0; index < this->nodes.size(); index++) {
+        AbstractNode* node = triton::ast::newShallowInstance(this->nodes[index]);
+        AstChilds& childs  = node->getChilds();
+        const std::vector<triton::sint32>& sources = this->sources[index];
+
+        for (triton::uint32 child = 0; child < childs.size(); child++) {
+          if (sources[child] != -1)
+            childs[child] = instances[sources[child]];
+        }
+
+        /* Same as the node builders */
+        node->init();
+        instances.push_back(triton::api.recordAstNode(node));
+      }
+
+      return instances[this->rootSource];
+    }
+
+
+    triton::uint512 AstTemplate::evaluate(const std::vector<triton::uint512>& values) const {
+      std::vector<triton::uint512> results = values;
+      std::vector<triton::uint512> operands;
+
+      if (values.size() != this->holes.size())
+        throw std::invalid_argument("AstTemplate::evaluate(): Wrong number of values.");
+
+      if (this->rootSource == -1)
+        return this->root->evaluate();
+
+      results.reserve(this->holes.size() + this->nodes.size());
+      for (triton::usize index = 0; index < this->nodes.size(); index++) {
+        const AstChilds& childs = this->nodes[index]->getChilds();
+        const std::vector<triton::sint32>& sources = this->sources[index];
+
+        operands.clear();
+        for (triton::uint32 child = 0; child < childs.size(); child++)
+          operands.push_back(sources[child] == -1 ? childs[child]->evaluate() : results[sources[child]]);
+
+        results.push_back(triton::ast::evaluateOperation(this->nodes[index], operands));
+      }
+
+      return results[this->rootSource];
+    }
+
+  }; /* ast namespace */
+}; /* triton namespace */
@@ -315,7 +315,7 @@ namespace triton {
 
       /* concat representation */
       std::ostream& AstSmtRepresentation::print(std::ostream& stream, triton::ast::ConcatNode* node) {
-        std::vector<triton::ast::AbstractNode*> childs = node->getChilds();
+        triton::ast::AstChilds& childs = node->getChilds();
         triton::usize size = childs.size();
 
         if (size < 2)
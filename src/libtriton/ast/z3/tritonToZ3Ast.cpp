@@ -24,47 +24,169 @@ namespace triton {
 
 
     TritonToZ3Ast::~TritonToZ3Ast() {
+      /* The cached expressions must be released before the context of the result */
+      this->cache.clear();
+      this->variables.clear();
     }
 
 
+    /*
+     * Converts an AST in post-order with an explicit worklist, so deep
+     * ASTs do not exhaust the native stack. Each node is converted once
+     * and its Z3 expression is cached, shared sub-DAGs and references are
+     * thus translated once per context.
+     */
     Z3Result& TritonToZ3Ast::eval(triton::ast::AbstractNode& e) {
-      e.accept(*this);
+      std::vector<std::pair<triton::ast::AbstractNode*, bool>> worklist;
+
+      worklist.push_back(std::make_pair(&e, false));
+      while (!worklist.empty()) {
+        triton::ast::AbstractNode* node = worklist.back().first;
+
+        /* Already converted */
+        if (this->isCached(node)) {
+          worklist.pop_back();
+          continue;
+        }
+
+        /* First visit, convert the operands before the node */
+        if (worklist.back().second == false) {
+          std::vector<triton::ast::AbstractNode*> operands = this->getOperands(node);
+          worklist.back().second = true;
+          for (triton::uint32 index = 0; index < operands.size(); index++) {
+            if (!this->isCached(operands[index]))
+              worklist.push_back(std::make_pair(operands[index], false));
+          }
+          continue;
+        }
+
+        /* Second visit, all operands are in the cache */
+        worklist.pop_back();
+        node->accept(*this);
+        this->cache.insert(std::make_pair(node, std::make_pair(node->getHash(), this->result.getExpr())));
+      }
+
+      z3::expr expr = this->cache.at(&e).second;
+      this->result.setExpr(expr);
+
       return this->result;
     }
 
 
+    z3::expr TritonToZ3Ast::convert(triton::ast::AbstractNode* node) {
+      if (this->isCached(node))
+        return this->cache.at(node).second;
+      return this->eval(*node).getExpr();
+    }
+
+
+    /*
+     * A cached entry is only trusted if the node still has the same
+     * structural hash. A long-lived converter may outlive a node and
+     * meet another node allocated at the same address.
+     */
+    bool TritonToZ3Ast::isCached(triton::ast::AbstractNode* node) {
+      std::map<triton::ast::AbstractNode*, std::pair<triton::uint64, z3::expr>>::iterator it = this->cache.find(node);
+
+      if (it == this->cache.end())
+        return false;
+
+      if (it->second.first != node->getHash()) {
+        this->cache.erase(it);
+        return false;
+      }
+
+      return true;
+    }
+
+
+    z3::context& TritonToZ3Ast::getContext(void) {
+      return this->result.getContext();
+    }
+
+
+    std::vector<triton::ast::AbstractNode*> TritonToZ3Ast::getOperands(triton::ast::AbstractNode* node) {
+      std::vector<triton::ast::AbstractNode*> operands;
+      triton::ast::AstChilds& childs = node->getChilds();
+
+      switch (node->getKind()) {
+        /* A reference is converted through the AST of its symbolic expression */
+        case REFERENCE_NODE: {
+          triton::engines::symbolic::SymbolicExpression* refNode = triton::api.getSymbolicExpressionFromId(reinterpret_cast<triton::ast::ReferenceNode*>(node)->getValue());
+          if (refNode != nullptr)
+            operands.push_back(refNode->getAst());
+          break;
+        }
+
+        /* The symbol must be bound before its uses in the body are reached */
+        case LET_NODE: {
+          std::string symbol    = reinterpret_cast<triton::ast::StringNode*>(childs[0])->getValue();
+          this->symbols[symbol] = childs[1];
+          operands.push_back(childs[1]);
+          operands.push_back(childs[2]);
+          break;
+        }
+
+        case STRING_NODE: {
+          std::map<std::string, triton::ast::AbstractNode*>::iterator it = this->symbols.find(reinterpret_cast<triton::ast::StringNode*>(node)->getValue());
+          if (it != this->symbols.end())
+            operands.push_back(it->second);
+          break;
+        }
+
+        default:
+          for (triton::uint32 index = 0; index < childs.size(); index++)
+            operands.push_back(childs[index]);
+          break;
+      }
+
+      return operands;
+    }
+
+
+    triton::usize TritonToZ3Ast::getNumberOfConvertedNodes(void) const {
+      return this->cache.size();
+    }
+
+
+    const std::map<triton::usize, z3::expr>& TritonToZ3Ast::getVariables(void) const {
+      return this->variables;
+    }
+
+
     void TritonToZ3Ast::operator()(triton::ast::AbstractNode& e) {
       e.accept(*this);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::AssertNode& e) {
-      throw std::runtime_error("TritonToZ3Ast::AssertNode(): Not implemented.");
+      z3::expr op1 = this->convert(e.getChilds()[0]);
+      this->result.setExpr(op1);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvaddNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvadd(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvadd(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvandNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvand(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvand(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvashrNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvashr(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvashr(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
@@ -76,18 +198,18 @@ namespace triton {
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvlshrNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvlshr(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvlshr(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvmulNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvmul(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvmul(this->result.getContext(), op1, op2));
 
 
       this->result.setExpr(newexpr);
@@ -95,52 +217,52 @@ namespace triton {
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvsmodNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsmod(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsmod(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvnandNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvnand(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvnand(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvnegNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvneg(this->result.getContext(), op1.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvneg(this->result.getContext(), op1));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvnorNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvnor(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvnor(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvnotNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvnot(this->result.getContext(), op1.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvnot(this->result.getContext(), op1));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvorNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvor(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvor(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
@@ -148,8 +270,8 @@ namespace triton {
 
     void TritonToZ3Ast::operator()(triton::ast::BvrolNode& e) {
       triton::uint32 op1  = reinterpret_cast<triton::ast::DecimalNode*>(e.getChilds()[0])->getValue().convert_to<triton::uint32>();
-      Z3Result op2        = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr    = to_expr(this->result.getContext(), Z3_mk_rotate_left(this->result.getContext(), op1, op2.getExpr()));
+      z3::expr op2        = this->convert(e.getChilds()[1]);
+      z3::expr newexpr    = to_expr(this->result.getContext(), Z3_mk_rotate_left(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
@@ -157,163 +279,161 @@ namespace triton {
 
     void TritonToZ3Ast::operator()(triton::ast::BvrorNode& e) {
       triton::uint32 op1  = reinterpret_cast<triton::ast::DecimalNode*>(e.getChilds()[0])->getValue().convert_to<triton::uint32>();
-      Z3Result op2        = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr    = to_expr(this->result.getContext(), Z3_mk_rotate_right(this->result.getContext(), op1, op2.getExpr()));
+      z3::expr op2        = this->convert(e.getChilds()[1]);
+      z3::expr newexpr    = to_expr(this->result.getContext(), Z3_mk_rotate_right(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvsdivNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsdiv(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsdiv(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvsgeNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsge(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsge(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvsgtNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsgt(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsgt(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvshlNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvshl(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvshl(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvsleNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsle(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsle(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvsltNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvslt(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvslt(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvsremNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsrem(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsrem(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvsubNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsub(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvsub(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvudivNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvudiv(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvudiv(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvugeNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvuge(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvuge(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvugtNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvugt(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvugt(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvuleNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvule(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvule(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvultNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvult(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvult(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvuremNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvurem(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvurem(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvxnorNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvxnor(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvxnor(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvxorNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvxor(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_bvxor(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::BvNode& e) {
-      Z3Result value        = this->eval(*e.getChilds()[0]);
-      Z3Result size         = this->eval(*e.getChilds()[1]);
-      triton::uint32 bvsize = static_cast<triton::uint32>(size.getUintValue());
-
-      z3::expr newexpr = this->result.getContext().bv_val(value.getStringValue().c_str(), bvsize);
+      triton::uint512 value = reinterpret_cast<triton::ast::DecimalNode*>(e.getChilds()[0])->getValue();
+      triton::uint32 bvsize = reinterpret_cast<triton::ast::DecimalNode*>(e.getChilds()[1])->getValue().convert_to<triton::uint32>();
+      z3::expr newexpr      = this->result.getContext().bv_val(value.str().c_str(), bvsize);
 
       this->result.setExpr(newexpr);
     }
@@ -325,16 +445,16 @@ namespace triton {
 
 
     void TritonToZ3Ast::operator()(triton::ast::ConcatNode& e) {
-      std::vector<triton::ast::AbstractNode*> childs = e.getChilds();
+      triton::ast::AstChilds& childs = e.getChilds();
 
       triton::uint32 idx;
 
       z3::expr nextValue(this->result.getContext());
-      z3::expr currentValue = eval(*childs[0]).getExpr();
+      z3::expr currentValue = this->convert(childs[0]);
 
       //Child[0] is the LSB
       for (idx = 1; idx < childs.size(); idx++) {
-          nextValue = eval(*childs[idx]).getExpr();
+          nextValue = this->convert(childs[idx]);
           currentValue = to_expr(this->result.getContext(), Z3_mk_concat(this->result.getContext(), currentValue, nextValue));
       }
 
@@ -355,9 +475,9 @@ namespace triton {
 
 
     void TritonToZ3Ast::operator()(triton::ast::DistinctNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      Z3_ast ops[]      = {op1.getExpr(), op2.getExpr()};
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      Z3_ast ops[]      = {op1, op2};
       z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_distinct(this->result.getContext(), 2, ops));
 
       this->result.setExpr(newexpr);
@@ -365,40 +485,38 @@ namespace triton {
 
 
     void TritonToZ3Ast::operator()(triton::ast::EqualNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_eq(this->result.getContext(), op1.getExpr(), op2.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_eq(this->result.getContext(), op1, op2));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::ExtractNode& e) {
-      Z3Result high     = this->eval(*e.getChilds()[0]);
-      Z3Result low      = this->eval(*e.getChilds()[1]);
-      Z3Result value    = this->eval(*e.getChilds()[2]);
-      triton::uint32 hv = static_cast<triton::uint32>(high.getUintValue());
-      triton::uint32 lv = static_cast<triton::uint32>(low.getUintValue());
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_extract(this->result.getContext(), hv, lv, value.getExpr()));
+      triton::uint32 hv = reinterpret_cast<triton::ast::DecimalNode*>(e.getChilds()[0])->getValue().convert_to<triton::uint32>();
+      triton::uint32 lv = reinterpret_cast<triton::ast::DecimalNode*>(e.getChilds()[1])->getValue().convert_to<triton::uint32>();
+      z3::expr value    = this->convert(e.getChilds()[2]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_extract(this->result.getContext(), hv, lv, value));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::IteNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]); // condition
-      Z3Result op2      = this->eval(*e.getChilds()[1]); // if true
-      Z3Result op3      = this->eval(*e.getChilds()[2]); // if false
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_ite(this->result.getContext(), op1.getExpr(), op2.getExpr(), op3.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]); // condition
+      z3::expr op2      = this->convert(e.getChilds()[1]); // if true
+      z3::expr op3      = this->convert(e.getChilds()[2]); // if false
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_ite(this->result.getContext(), op1, op2, op3));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::LandNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      Z3_ast ops[]      = {op1.getExpr(), op2.getExpr()};
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      Z3_ast ops[]      = {op1, op2};
       z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_and(this->result.getContext(), 2, ops));
 
       this->result.setExpr(newexpr);
@@ -408,24 +526,24 @@ namespace triton {
     void TritonToZ3Ast::operator()(triton::ast::LetNode& e) {
       std::string symbol    = reinterpret_cast<triton::ast::StringNode*>(e.getChilds()[0])->getValue();
       this->symbols[symbol] = e.getChilds()[1];
-      Z3Result op2          = this->eval(*e.getChilds()[2]);
+      z3::expr op2          = this->convert(e.getChilds()[2]);
 
-      this->result.setExpr(op2.getExpr());
+      this->result.setExpr(op2);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::LnotNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_not(this->result.getContext(), op1.getExpr()));
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_not(this->result.getContext(), op1));
 
       this->result.setExpr(newexpr);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::LorNode& e) {
-      Z3Result op1      = this->eval(*e.getChilds()[0]);
-      Z3Result op2      = this->eval(*e.getChilds()[1]);
-      Z3_ast ops[]      = {op1.getExpr(), op2.getExpr()};
+      z3::expr op1      = this->convert(e.getChilds()[0]);
+      z3::expr op2      = this->convert(e.getChilds()[1]);
+      Z3_ast ops[]      = {op1, op2};
       z3::expr newexpr  = to_expr(this->result.getContext(), Z3_mk_or(this->result.getContext(), 2, ops));
 
       this->result.setExpr(newexpr);
@@ -436,24 +554,23 @@ namespace triton {
       triton::engines::symbolic::SymbolicExpression* refNode = triton::api.getSymbolicExpressionFromId(e.getValue());
       if (refNode == nullptr)
         throw std::runtime_error("TritonToZ3Ast::ReferenceNode(): Reference node not found.");
-      Z3Result op1 = this->eval(*(refNode->getAst()));
-      this->result.setExpr(op1.getExpr());
+      z3::expr op1 = this->convert(refNode->getAst());
+      this->result.setExpr(op1);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::StringNode& e) {
       if (this->symbols.find(e.getValue()) == this->symbols.end())
         throw std::runtime_error("TritonToZ3Ast::StringNode(): Symbols not found.");
-      Z3Result op1 = this->eval(*(this->symbols[e.getValue()]));
-      this->result.setExpr(op1.getExpr());
+      z3::expr op1 = this->convert(this->symbols[e.getValue()]);
+      this->result.setExpr(op1);
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::SxNode& e) {
-      Z3Result ext        = this->eval(*e.getChilds()[0]);
-      Z3Result value      = this->eval(*e.getChilds()[1]);
-      triton::uint32 extv = static_cast<triton::uint32>(ext.getUintValue());
-      z3::expr newexpr    = to_expr(this->result.getContext(), Z3_mk_sign_ext(this->result.getContext(), extv, value.getExpr()));
+      triton::uint32 extv = reinterpret_cast<triton::ast::DecimalNode*>(e.getChilds()[0])->getValue().convert_to<triton::uint32>();
+      z3::expr value      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr    = to_expr(this->result.getContext(), Z3_mk_sign_ext(this->result.getContext(), extv, value));
 
       this->result.setExpr(newexpr);
     }
@@ -466,11 +583,11 @@ namespace triton {
       if (symVar == nullptr)
         throw std::runtime_error("TritonToZ3Ast::VariableNode(): Can't get the symbolic variable (nullptr).");
 
-      if (symVar->getSize() > QWORD_SIZE_BIT)
-        throw std::runtime_error("TritonToZ3Ast::VariableNode(): Size above 64 bits is not supported yet.");
-
       /* If the conversion is used to evaluate a node, we concretize symbolic variables */
       if (this->isEval) {
+        if (symVar->getSize() > QWORD_SIZE_BIT)
+          throw std::runtime_error("TritonToZ3Ast::VariableNode(): Size above 64 bits is not supported yet.");
+
         if (symVar->getKind() == triton::engines::symbolic::MEM) {
           triton::uint32 memSize   = symVar->getSize();
           triton::uint512 memValue = symVar->getConcreteValue();
@@ -491,16 +608,16 @@ namespace triton {
       else {
         //z3::expr newexpr = to_expr(this->result.getContext(), Z3_mk_const(this->result.getContext(), Z3_mk_string_symbol(this->result.getContext(), symVar->getName().c_str()), Z3_mk_bv_sort(this->result.getContext(), symVar->getSize())));
         z3::expr newexpr = this->result.getContext().bv_const(symVar->getName().c_str(), symVar->getSize());
+        this->variables.insert(std::make_pair(symVar->getId(), newexpr));
         this->result.setExpr(newexpr);
       }
     }
 
 
     void TritonToZ3Ast::operator()(triton::ast::ZxNode& e) {
-      Z3Result ext        = this->eval(*e.getChilds()[0]);
-      Z3Result value      = this->eval(*e.getChilds()[1]);
-      triton::uint32 extv = static_cast<triton::uint32>(ext.getUintValue());
-      z3::expr newexpr    = to_expr(this->result.getContext(), Z3_mk_zero_ext(this->result.getContext(), extv, value.getExpr()));
+      triton::uint32 extv = reinterpret_cast<triton::ast::DecimalNode*>(e.getChilds()[0])->getValue().convert_to<triton::uint32>();
+      z3::expr value      = this->convert(e.getChilds()[1]);
+      z3::expr newexpr    = to_expr(this->result.getContext(), Z3_mk_zero_ext(this->result.getContext(), extv, value));
 
       this->result.setExpr(newexpr);
     }
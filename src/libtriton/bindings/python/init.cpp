@@ -107,6 +107,12 @@ namespace triton {
         triton::bindings::python::registersDict = xPyDict_New();
         PyObject* idRegClass = xPyClass_New(nullptr, triton::bindings::python::registersDict, xPyString_FromString("REG"));
 
+        /* Create the SOLVER_STATUS namespace ======================================================== */
+
+        PyObject* solverStatusDict = xPyDict_New();
+        initSolverStatusNamespace(solverStatusDict);
+        PyObject* idSolverStatusClass = xPyClass_New(nullptr, solverStatusDict, xPyString_FromString("SOLVER_STATUS"));
+
         /* Create the SYMEXPR namespace ============================================================== */
 
         PyObject* symExprDict = xPyDict_New();
@@ -139,6 +145,7 @@ namespace triton {
         PyModule_AddObject(triton::bindings::python::tritonModule, "OPTIMIZATION",        idSymOptiClass);
         PyModule_AddObject(triton::bindings::python::tritonModule, "PREFIX",              idPrefixesClass);           /* Empty: filled on the fly */
         PyModule_AddObject(triton::bindings::python::tritonModule, "REG",                 idRegClass);                /* Empty: filled on the fly */
+        PyModule_AddObject(triton::bindings::python::tritonModule, "SOLVER_STATUS",       idSolverStatusClass);
         PyModule_AddObject(triton::bindings::python::tritonModule, "SYMEXPR",             idSymExprClass);
         PyModule_AddObject(triton::bindings::python::tritonModule, "VERSION",             idVersionClass);
         #if defined(__unix__) || defined(__APPLE__)
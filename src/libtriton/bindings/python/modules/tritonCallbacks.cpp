@@ -88,6 +88,15 @@ Builds a symbolic \ref py_REG_page and returns a \ref py_AstNode_page.
 - **clearPathConstraints(void)**<br>
 Clears the logical conjunction vector of path constraints.
 
+- **clearSolverQueryCache(void)**<br>
+Clears the answers and the models kept by the solver query cache.
+
+- **clearSolverQueryStats(void)**<br>
+Clears the statistics of the queries sent to the solver.
+
+- **collectAstNodes(void)**<br>
+Frees every AST node which is not reachable anymore from the symbolic expressions, the path constraints or a python object. Returns the number of freed nodes as integer.
+
 - **concretizeAllMemory(void)**<br>
 Concretizes all symbolic memory references.
 
@@ -148,6 +157,24 @@ Enabled, Triton will use the simplification passes of z3 before to call its reco
 - **enableTaintEngine(bool flag)**<br>
 Enables or disables the taint engine.
 
+- **enableTaintLabels(bool flag)**<br>
+Enables or disables the taint labels. Enabled, each byte tainted with `taintMemory()` or `taintRegister()` and a label holds the
+set of labels which reach it, and the taint rules propagate these sets. Disabling the labels drops them all.
+
+- **enumerateModels(\ref py_AstNode_page node, [\ref py_SymbolicVariable_page or integer symVarId, ...], function callback, integer limit=0, integer timeout=0)**<br>
+Enumerates the models of a symbolic constraint which differ on the given symbolic variables and returns the number of models found.
+Each model is given to `callback` as a dictionary of {integer symVarId : \ref py_SolverModel_page model} as soon as it is found. The enumeration
+stops when the callback returns False, when `limit` models have been found (0 means no limit) or when there is no other model. Models which
+only differ on the other variables are not enumerated. If the list of variables is empty, all the variables are used.
+
+~~~~~~~~~~~~~{.py}
+>>> def onModel(model):
+...     print model
+...     return True
+...
+>>> enumerateModels(ast.assert_(ast.bvult(x + y, ast.bv(4, 8))), [symVarX], onModel)
+~~~~~~~~~~~~~
+
 - **evaluateAstViaZ3(\ref py_AstNode_page node)**<br>
 Evaluates an AST via Z3 and returns the symbolic value as integer.
 
@@ -158,7 +185,8 @@ Returns the list of all registers. Each item of this list is a \ref py_Register_
 Returns the architecture which has been initialized as \ref py_ARCH_page.
 
 - **getAstDictionariesStats(void)**<br>
-Returns a dictionary which contains all information about number of nodes allocated via AST dictionaries.
+Returns a dictionary which contains all information about number of nodes allocated via AST dictionaries. It also
+contains stats about the underlying hash table: `capacity`, `loadFactor` (in percent), `totalProbes` and `maxProbeLength`.
 
 - **getAstFromId(integer symExprId)**<br>
 Returns the partial AST as \ref py_AstNode_page from a symbolic expression id.
@@ -178,17 +206,31 @@ Returns the concrete value of memory cells.
 - **getConcreteRegisterValue(\ref py_REG_page reg)**<br>
 Returns the concrete value of a register.
 
-- **getFullAst(\ref py_AstNode_page node)**<br>
-Returns the full AST of a root node as \ref py_AstNode_page.
+- **getFullAst(\ref py_AstNode_page node, bool inplace=True)**<br>
+Returns the full AST of a root node as \ref py_AstNode_page. If `inplace` is False, the stored symbolic expressions are not modified and a new AST is returned.
 
-- **getFullAstFromId(integer symExprId)**<br>
-Returns the full AST as \ref py_AstNode_page from a symbolic expression id.
+- **getFullAstFromId(integer symExprId, bool inplace=True)**<br>
+Returns the full AST as \ref py_AstNode_page from a symbolic expression id. If `inplace` is False, the stored symbolic expressions are not modified and a new AST is returned.
 
-- **getModel(\ref py_AstNode_page node)**<br>
+- **getModel(\ref py_AstNode_page node, bool status=False, integer timeout=0)**<br>
 Computes and returns a model as a dictionary of {integer symVarId : \ref py_SolverModel_page model} from a symbolic constraint.
+If `status` is True, returns a tuple `(model, status)` where `status` is a \ref py_SOLVER_STATUS_page. If `timeout` (in milliseconds)
+is 0, the default timeout of the solver is used (see `setSolverTimeout()`).
+
+- **getModels(\ref py_AstNode_page node, integer limit, bool status=False, integer timeout=0)**<br>
+Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned. If `status` is True,
+returns a tuple `([model, ...], status)` where `status` is the \ref py_SOLVER_STATUS_page of the last check.
+
+- **getModels([\ref py_AstNode_page, ...], bool status=False, integer timeout=0)**<br>
+Computes a model for each symbolic constraint of the list and returns a list of dictionaries of {integer symVarId : \ref py_SolverModel_page model},
+in the same order. An empty dictionary means that the constraint has no model. The constraints are solved in parallel by the worker threads
+of the solver (see `setSolverThreads()`). If `status` is True, returns a tuple `([model, ...], [status, ...])`.
 
-- **getModels(\ref py_AstNode_page node)**<br>
-Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned.
+- **getNegatedBranchModel(integer index, bool status=False, integer timeout=0)**<br>
+Computes and returns a model as a dictionary of {integer symVarId : \ref py_SolverModel_page model} which follows the path constraints before `index` and takes another branch at `index`. The path constraints are asserted once in an incremental solver session and are reused by the next queries. Returns an empty dictionary if there is no such model.
+
+- **getNegatedBranchesModels(void)**<br>
+Computes the models of `getNegatedBranchModel()` for every path constraint in one pass and returns them as a list of dictionaries, one per path constraint.
 
 - **getParentRegisters(void)**<br>
 Returns the list of parent registers. Each item of this list is a \ref py_Register_page.
@@ -199,6 +241,29 @@ Returns the logical conjunction vector of path constraints as list of \ref py_Pa
 - **getPathConstraintsAst(void)**<br>
 Returns the logical conjunction AST of path constraints as \ref py_AstNode_page.
 
+- **getRelevantPathConstraintsAst(\ref py_AstNode_page node)**<br>
+Returns the logical conjunction AST of the path constraints which share symbolic variables with `node`, directly or through other
+path constraints, as \ref py_AstNode_page. The other path constraints are independent and still satisfied by the concrete values
+of their variables, so `getModel(assert_(land(getRelevantPathConstraintsAst(node), node)))` sends a smaller query to the solver.
+
+- **getSolverMemoryLimit(void)**<br>
+Returns the memory limit of the solver in megabytes (0 means no limit).
+
+- **getSolverQueryCacheStats(void)**<br>
+Returns a dictionary which contains stats about the solver query cache (see \ref py_OPTIMIZATION_page): `entries`, `hits`
+(same query asked again), `modelHits` (query satisfied by a recent model without calling the solver) and `misses`.
+
+- **getSolverQueryStats(void)**<br>
+Returns the statistics of the last queries sent to the solver, most recent last, as a list of dictionaries. Each query is described by
+`id`, `hash` (structural hash of the constraint), `nodes` (number of nodes translated), `variables` (number of symbolic variables),
+`translationTime` and `solveTime` (in microseconds) and `status` (\ref py_SOLVER_STATUS_page).
+
+- **getSolverThreads(void)**<br>
+Returns the number of worker threads used to solve a list of constraints given to `getModels()`.
+
+- **getSolverTimeout(void)**<br>
+Returns the default timeout of a query in milliseconds (0 means no timeout).
+
 - **getSymbolicExpressionFromId(intger symExprId)**<br>
 Returns the symbolic expression as \ref py_SymbolicExpression_page corresponding to the id.
 
@@ -238,6 +303,15 @@ Returns all symbolic variable as a dictionary of {integer SymVarId : \ref py_Sym
 - **getTaintedSymbolicExpressions(void)**<br>
 Returns the list of all tainted \ref py_SymbolicExpression_page.
 
+- **getTaintLabels(integer addr, integer size=1)**<br>
+Returns the sorted list of the labels which reach the memory area `[addr:size]`.
+
+- **getTaintLabels(\ref py_Memory_page mem)**<br>
+Returns the sorted list of the labels which reach the memory.
+
+- **getTaintLabels(\ref py_REG_page reg)**<br>
+Returns the sorted list of the labels which reach the register.
+
 - **isArchitectureValid(void)**<br>
 Returns true if the architecture is valid.
 
@@ -268,18 +342,32 @@ Returns true if Triton can use the simplification passes of z3.
 - **isTaintEngineEnabled(void)**<br>
 Returns true if the taint engine is enabled.
 
+- **isTaintLabelsEnabled(void)**<br>
+Returns true if the taint labels are enabled.
+
 - **newSymbolicExpression(\ref py_AstNode_page node, string comment="")**<br>
 Returns a new symbolic expression. Note that if there are simplification passes recorded, simplification will be applied.
 
 - **newSymbolicVariable(intger varSize, string comment="")**<br>
 Returns a new symbolic variable.
 
+- **processBasicBlock(integer addr, bytes opcodes)**<br>
+Processes the basic block starting at `addr` and returns the list of its \ref py_Instruction_page. The instructions are processed until the first
+control flow instruction or the end of `opcodes`. The register and flag expressions overwritten inside the block before being used are removed.
+With `OPTIMIZATION.AST_GARBAGE_COLLECTION`, their AST nodes are reclaimed by the collections, except the ones held by the returned instructions.
+
 - **processing(\ref py_Instruction_page inst)**<br>
 The main function. This function processes everything (engine, IR, optimization, state, ...) from a given instruction.
 
 - **recordSimplificationCallback(function cb)**<br>
 Records a simplification callback. The callback will be called before every symbolic assignments.
 
+- **removeDeadSymbolicExpressions(void)**<br>
+Removes the symbolic expressions which are not live anymore (not assigned to a register or to the memory, and not referenced by a path
+constraint or another live expression). Returns the number of expressions removed. With `OPTIMIZATION.AST_GARBAGE_COLLECTION`, their AST nodes
+are collected. The \ref py_SymbolicExpression_page and the \ref py_Instruction_page objects keep their expressions and AST nodes alive, a removed
+expression can still be read through them but cannot be assigned to a register anymore.
+
 - **removeSimplificationCallback(function cb)**<br>
 Removes a simplification callback.
 
@@ -312,6 +400,17 @@ the symbolic state (if it exists). You should probably use the concretize functi
 Sets the concrete value of a register. Note that by setting a concrete value will probably imply a desynchronization with
 the symbolic state (if it exists). You should probably use the concretize functions after this.
 
+- **setSolverMemoryLimit(integer limit)**<br>
+Sets the memory limit of the solver in megabytes (0 means no limit). The limit is applied to each query, a query which reaches it returns
+the `SOLVER_STATUS.OUTOFMEM` status.
+
+- **setSolverThreads(integer threads)**<br>
+Sets the number of worker threads used to solve a list of constraints given to `getModels()`. By default, one per core.
+
+- **setSolverTimeout(integer timeout)**<br>
+Sets the default timeout of a query in milliseconds (0 means no timeout). A query stopped by the timeout returns the
+`SOLVER_STATUS.TIMEOUT` status and no model.
+
 - **setTaintMemory(\ref py_Memory_page mem, bool flag)**<br>
 Sets the targeted memory as tainted or not.
 
@@ -340,14 +439,14 @@ Taints `regDst` from `MemSrc` with an assignment - `regDst` is tainted if `memSr
 - <b>taintAssignmentRegisterRegister(\ref py_REG_page regDst, \ref py_REG_page regSrc)</b><br>
 Taints `regDst` from `regSrc` with an assignment - `regDst` is tainted if `regSrc` is tainted, otherwise `regDst` is untained.
 
-- **taintMemory(intger addr)**<br>
-Taints an address.
+- **taintMemory(intger addr, integer label)**<br>
+Taints an address. If `label` is given and the taint labels are enabled, the address is tainted with this label.
 
-- **taintMemory(\ref py_Memory_page mem)**<br>
-Taints a memory.
+- **taintMemory(\ref py_Memory_page mem, integer label)**<br>
+Taints a memory. If `label` is given and the taint labels are enabled, each byte of the memory is tainted with this label.
 
-- **taintRegister(\ref py_REG_page reg)**<br>
-Taints a register.
+- **taintRegister(\ref py_REG_page reg, integer label)**<br>
+Taints a register. If `label` is given and the taint labels are enabled, each byte of the register is tainted with this label.
 
 - <b>taintUnionMemoryImmediate(\ref py_Memory_page memDst)</b><br>
 Taints `memDst` with an union - `memDst` does not changes.
@@ -390,6 +489,7 @@ Untaints a register.
 - \ref py_OPERAND_page
 - \ref py_OPTIMIZATION_page
 - \ref py_REG_page
+- \ref py_SOLVER_STATUS_page
 - \ref py_SYMEXPR_page
 - \ref py_SYSCALL_page
 - \ref py_VERSION_page
@@ -669,10 +769,9 @@ namespace triton {
         if (mem == nullptr || (!PyMemoryOperand_Check(mem)))
           return PyErr_Format(PyExc_TypeError, "assignSymbolicExpressionToMemory(): Expects a Memory as second argument.");
 
-        triton::engines::symbolic::SymbolicExpression* arg1 = PySymbolicExpression_AsSymbolicExpression(se);
-        triton::arch::MemoryOperand arg2 = *PyMemoryOperand_AsMemoryOperand(mem);
-
         try {
+          triton::engines::symbolic::SymbolicExpression* arg1 = PySymbolicExpression_AsSymbolicExpression(se);
+          triton::arch::MemoryOperand arg2 = *PyMemoryOperand_AsMemoryOperand(mem);
           triton::api.assignSymbolicExpressionToMemory(arg1, arg2);
         }
         catch (const std::exception& e) {
@@ -701,10 +800,9 @@ namespace triton {
         if (reg == nullptr || (!PyRegisterOperand_Check(reg)))
           return PyErr_Format(PyExc_TypeError, "assignSymbolicExpressionToRegister(): Expects a REG as second argument.");
 
-        triton::engines::symbolic::SymbolicExpression* arg1 = PySymbolicExpression_AsSymbolicExpression(se);
-        triton::arch::RegisterOperand arg2 = *PyRegisterOperand_AsRegisterOperand(reg);
-
         try {
+          triton::engines::symbolic::SymbolicExpression* arg1 = PySymbolicExpression_AsSymbolicExpression(se);
+          triton::arch::RegisterOperand arg2 = *PyRegisterOperand_AsRegisterOperand(reg);
           triton::api.assignSymbolicExpressionToRegister(arg1, arg2);
         }
         catch (const std::exception& e) {
@@ -726,6 +824,7 @@ namespace triton {
 
         try {
           triton::api.buildSemantics(*PyInstruction_AsInstruction(inst));
+          recordInstructionExpressions(inst);
         }
         catch (const std::exception& e) {
           return PyErr_Format(PyExc_TypeError, "%s", e.what());
@@ -797,6 +896,54 @@ namespace triton {
       }
 
 
+      static PyObject* triton_clearSolverQueryStats(PyObject* self, PyObject* noarg) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "clearSolverQueryStats(): Architecture is not defined.");
+
+        try {
+          triton::api.clearSolverQueryStats();
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* triton_clearSolverQueryCache(PyObject* self, PyObject* noarg) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "clearSolverQueryCache(): Architecture is not defined.");
+
+        try {
+          triton::api.clearSolverQueryCache();
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* triton_collectAstNodes(PyObject* self, PyObject* noarg) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "collectAstNodes(): Architecture is not defined.");
+
+        try {
+          return PyLong_FromUsize(triton::api.collectAstNodes());
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* triton_concretizeAllMemory(PyObject* self, PyObject* noarg) {
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
@@ -1010,11 +1157,10 @@ namespace triton {
         if (comment != nullptr)
           ccomment = PyString_AsString(comment);
 
-        triton::arch::Instruction arg1 = *PyInstruction_AsInstruction(inst);
-        triton::ast::AbstractNode *arg2 = PyAstNode_AsAstNode(node);
-        triton::arch::RegisterOperand arg3 = *PyRegisterOperand_AsRegisterOperand(flag);
-
         try {
+          triton::arch::Instruction arg1 = *PyInstruction_AsInstruction(inst);
+          triton::ast::AbstractNode *arg2 = PyAstNode_AsAstNode(node);
+          triton::arch::RegisterOperand arg3 = *PyRegisterOperand_AsRegisterOperand(flag);
           return PySymbolicExpression(triton::api.createSymbolicFlagExpression(arg1, arg2, arg3, ccomment));
         }
         catch (const std::exception& e) {
@@ -1052,11 +1198,10 @@ namespace triton {
         if (comment != nullptr)
           ccomment = PyString_AsString(comment);
 
-        triton::arch::Instruction arg1 = *PyInstruction_AsInstruction(inst);
-        triton::ast::AbstractNode *arg2 = PyAstNode_AsAstNode(node);
-        triton::arch::MemoryOperand arg3 = *PyMemoryOperand_AsMemoryOperand(mem);
-
         try {
+          triton::arch::Instruction arg1 = *PyInstruction_AsInstruction(inst);
+          triton::ast::AbstractNode *arg2 = PyAstNode_AsAstNode(node);
+          triton::arch::MemoryOperand arg3 = *PyMemoryOperand_AsMemoryOperand(mem);
           return PySymbolicExpression(triton::api.createSymbolicMemoryExpression(arg1, arg2, arg3, ccomment));
         }
         catch (const std::exception& e) {
@@ -1094,11 +1239,10 @@ namespace triton {
         if (comment != nullptr)
           ccomment = PyString_AsString(comment);
 
-        triton::arch::Instruction arg1 = *PyInstruction_AsInstruction(inst);
-        triton::ast::AbstractNode *arg2 = PyAstNode_AsAstNode(node);
-        triton::arch::RegisterOperand arg3 = *PyRegisterOperand_AsRegisterOperand(reg);
-
         try {
+          triton::arch::Instruction arg1 = *PyInstruction_AsInstruction(inst);
+          triton::ast::AbstractNode *arg2 = PyAstNode_AsAstNode(node);
+          triton::arch::RegisterOperand arg3 = *PyRegisterOperand_AsRegisterOperand(reg);
           return PySymbolicExpression(triton::api.createSymbolicRegisterExpression(arg1, arg2, arg3, ccomment));
         }
         catch (const std::exception& e) {
@@ -1132,10 +1276,9 @@ namespace triton {
         if (comment != nullptr)
           ccomment = PyString_AsString(comment);
 
-        triton::arch::Instruction arg1 = *PyInstruction_AsInstruction(inst);
-        triton::ast::AbstractNode *arg2 = PyAstNode_AsAstNode(node);
-
         try {
+          triton::arch::Instruction arg1 = *PyInstruction_AsInstruction(inst);
+          triton::ast::AbstractNode *arg2 = PyAstNode_AsAstNode(node);
           return PySymbolicExpression(triton::api.createSymbolicVolatileExpression(arg1, arg2, ccomment));
         }
         catch (const std::exception& e) {
@@ -1253,6 +1396,99 @@ namespace triton {
       }
 
 
+      static PyObject* triton_enableTaintLabels(PyObject* self, PyObject* flag) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "enableTaintLabels(): Architecture is not defined.");
+
+        if (!PyBool_Check(flag))
+          return PyErr_Format(PyExc_TypeError, "enableTaintLabels(): Expects an boolean as argument.");
+
+        try {
+          triton::api.enableTaintLabels(PyLong_AsBool(flag));
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* triton_enumerateModels(PyObject* self, PyObject* args) {
+        PyObject* node      = nullptr;
+        PyObject* vars      = nullptr;
+        PyObject* callback  = nullptr;
+        PyObject* limit     = nullptr;
+        PyObject* timeout   = nullptr;
+        bool failed         = false;
+        std::set<triton::usize> variables;
+        triton::usize count = 0;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OOOOO", &node, &vars, &callback, &limit, &timeout);
+
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "enumerateModels(): Architecture is not defined.");
+
+        if (node == nullptr || !PyAstNode_Check(node))
+          return PyErr_Format(PyExc_TypeError, "enumerateModels(): Expects a AstNode as first argument.");
+
+        if (vars == nullptr || !PyList_Check(vars))
+          return PyErr_Format(PyExc_TypeError, "enumerateModels(): Expects a list of SymbolicVariable or integer as second argument.");
+
+        if (callback == nullptr || !PyCallable_Check(callback))
+          return PyErr_Format(PyExc_TypeError, "enumerateModels(): Expects a function as third argument.");
+
+        if (limit != nullptr && !PyLong_Check(limit) && !PyInt_Check(limit))
+          return PyErr_Format(PyExc_TypeError, "enumerateModels(): Expects an integer as fourth argument.");
+
+        if (timeout != nullptr && !PyLong_Check(timeout) && !PyInt_Check(timeout))
+          return PyErr_Format(PyExc_TypeError, "enumerateModels(): Expects an integer as fifth argument.");
+
+        for (Py_ssize_t i = 0; i < PyList_Size(vars); i++) {
+          PyObject* item = PyList_GetItem(vars, i);
+          if (PySymbolicVariable_Check(item))
+            variables.insert(PySymbolicVariable_AsSymbolicVariable(item)->getId());
+          else if (PyLong_Check(item) || PyInt_Check(item))
+            variables.insert(PyLong_AsUsize(item));
+          else
+            return PyErr_Format(PyExc_TypeError, "enumerateModels(): Expects a list of SymbolicVariable or integer as second argument.");
+        }
+
+        try {
+          count = triton::api.enumerateModels(PyAstNode_AsAstNode(node), variables, [&](const std::map<triton::uint32, triton::engines::solver::SolverModel>& model) {
+            PyObject* mdict = xPyDict_New();
+            for (auto it = model.begin(); it != model.end(); it++)
+              PyDict_SetItem(mdict, PyLong_FromUint32(it->first), PySolverModel(it->second));
+
+            /* The enumeration continues unless the callback returns False or raises an exception */
+            PyObject* ret = PyObject_CallFunctionObjArgs(callback, mdict, nullptr);
+            Py_DECREF(mdict);
+            if (ret == nullptr) {
+              failed = true;
+              return false;
+            }
+
+            bool next = (ret != Py_False);
+            Py_DECREF(ret);
+            return next;
+          }, (limit != nullptr) ? PyLong_AsUint32(limit) : 0, nullptr, (timeout != nullptr) ? PyLong_AsUint32(timeout) : 0);
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        /* The exception raised by the callback is propagated */
+        if (failed)
+          return nullptr;
+
+        return PyLong_FromUsize(count);
+      }
+
+
       static PyObject* triton_evaluateAstViaZ3(PyObject* self, PyObject* node) {
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
@@ -1423,16 +1659,28 @@ namespace triton {
       }
 
 
-      static PyObject* triton_getFullAst(PyObject* self, PyObject* node) {
+      static PyObject* triton_getFullAst(PyObject* self, PyObject* args) {
+        PyObject* node        = nullptr;
+        PyObject* inplace     = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &node, &inplace);
+
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
           return PyErr_Format(PyExc_TypeError, "getFullAst(): Architecture is not defined.");
 
-        if (!PyAstNode_Check(node))
-          return PyErr_Format(PyExc_TypeError, "getFullAst(): Expects a AstNode as argument.");
+        if (node == nullptr || !PyAstNode_Check(node))
+          return PyErr_Format(PyExc_TypeError, "getFullAst(): Expects a AstNode as first argument.");
+
+        if (inplace != nullptr && !PyBool_Check(inplace))
+          return PyErr_Format(PyExc_TypeError, "getFullAst(): Expects a boolean as second argument.");
+
+        if (inplace == nullptr)
+          inplace = Py_True;
 
         try {
-          return PyAstNode(triton::api.getFullAst(PyAstNode_AsAstNode(node)));
+          return PyAstNode(triton::api.getFullAst(PyAstNode_AsAstNode(node), PyLong_AsBool(inplace)));
         }
         catch (const std::exception& e) {
           return PyErr_Format(PyExc_TypeError, "%s", e.what());
@@ -1440,16 +1688,28 @@ namespace triton {
       }
 
 
-      static PyObject* triton_getFullAstFromId(PyObject* self, PyObject* symExprId) {
+      static PyObject* triton_getFullAstFromId(PyObject* self, PyObject* args) {
+        PyObject* symExprId   = nullptr;
+        PyObject* inplace     = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &symExprId, &inplace);
+
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
           return PyErr_Format(PyExc_TypeError, "getFullAstFromId(): Architecture is not defined.");
 
-        if (!PyLong_Check(symExprId) && !PyInt_Check(symExprId))
-          return PyErr_Format(PyExc_TypeError, "getFullAstFromId(): Expects an integer as argument.");
+        if (symExprId == nullptr || (!PyLong_Check(symExprId) && !PyInt_Check(symExprId)))
+          return PyErr_Format(PyExc_TypeError, "getFullAstFromId(): Expects an integer as first argument.");
+
+        if (inplace != nullptr && !PyBool_Check(inplace))
+          return PyErr_Format(PyExc_TypeError, "getFullAstFromId(): Expects a boolean as second argument.");
+
+        if (inplace == nullptr)
+          inplace = Py_True;
 
         try {
-          return PyAstNode(triton::api.getFullAstFromId(PyLong_AsUsize(symExprId)));
+          return PyAstNode(triton::api.getFullAstFromId(PyLong_AsUsize(symExprId), PyLong_AsBool(inplace)));
         }
         catch (const std::exception& e) {
           return PyErr_Format(PyExc_TypeError, "%s", e.what());
@@ -1457,21 +1717,34 @@ namespace triton {
       }
 
 
-      static PyObject* triton_getModel(PyObject* self, PyObject* node) {
-        PyObject* ret = nullptr;
+      static PyObject* triton_getModel(PyObject* self, PyObject* args) {
+        PyObject* ret     = nullptr;
+        PyObject* node    = nullptr;
+        PyObject* wstatus = nullptr;
+        PyObject* timeout = nullptr;
+        triton::engines::solver::status_e status = triton::engines::solver::UNKNOWN;
         std::map<triton::uint32, triton::engines::solver::SolverModel> model;
         std::map<triton::uint32, triton::engines::solver::SolverModel>::iterator it;
 
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OOO", &node, &wstatus, &timeout);
+
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
           return PyErr_Format(PyExc_TypeError, "getModel(): Architecture is not defined.");
 
-        if (!PyAstNode_Check(node))
-          return PyErr_Format(PyExc_TypeError, "getModel(): Expects a AstNode as argument.");
+        if (node == nullptr || !PyAstNode_Check(node))
+          return PyErr_Format(PyExc_TypeError, "getModel(): Expects a AstNode as first argument.");
+
+        if (wstatus != nullptr && !PyBool_Check(wstatus))
+          return PyErr_Format(PyExc_TypeError, "getModel(): Expects a boolean as second argument.");
+
+        if (timeout != nullptr && !PyLong_Check(timeout) && !PyInt_Check(timeout))
+          return PyErr_Format(PyExc_TypeError, "getModel(): Expects an integer as third argument.");
 
         try {
           ret = xPyDict_New();
-          model = triton::api.getModel(PyAstNode_AsAstNode(node));
+          model = triton::api.getModel(PyAstNode_AsAstNode(node), &status, (timeout != nullptr) ? PyLong_AsUint32(timeout) : 0);
           for (it = model.begin(); it != model.end(); it++) {
             PyDict_SetItem(ret, PyLong_FromUint32(it->first), PySolverModel(it->second));
           }
@@ -1480,33 +1753,176 @@ namespace triton {
           return PyErr_Format(PyExc_TypeError, "%s", e.what());
         }
 
+        /* Returns (model, status) */
+        if (wstatus != nullptr && PyLong_AsBool(wstatus)) {
+          PyObject* tuple = xPyTuple_New(2);
+          PyTuple_SetItem(tuple, 0, ret);
+          PyTuple_SetItem(tuple, 1, PyLong_FromUint32(status));
+          return tuple;
+        }
+
+        return ret;
+      }
+
+
+      static PyObject* triton_getNegatedBranchModel(PyObject* self, PyObject* args) {
+        PyObject* ret     = nullptr;
+        PyObject* index   = nullptr;
+        PyObject* wstatus = nullptr;
+        PyObject* timeout = nullptr;
+        triton::engines::solver::status_e status = triton::engines::solver::UNKNOWN;
+        std::map<triton::uint32, triton::engines::solver::SolverModel> model;
+        std::map<triton::uint32, triton::engines::solver::SolverModel>::iterator it;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OOO", &index, &wstatus, &timeout);
+
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "getNegatedBranchModel(): Architecture is not defined.");
+
+        if (index == nullptr || (!PyLong_Check(index) && !PyInt_Check(index)))
+          return PyErr_Format(PyExc_TypeError, "getNegatedBranchModel(): Expects an integer as first argument.");
+
+        if (wstatus != nullptr && !PyBool_Check(wstatus))
+          return PyErr_Format(PyExc_TypeError, "getNegatedBranchModel(): Expects a boolean as second argument.");
+
+        if (timeout != nullptr && !PyLong_Check(timeout) && !PyInt_Check(timeout))
+          return PyErr_Format(PyExc_TypeError, "getNegatedBranchModel(): Expects an integer as third argument.");
+
+        try {
+          ret = xPyDict_New();
+          model = triton::api.getNegatedBranchModel(PyLong_AsUsize(index), &status, (timeout != nullptr) ? PyLong_AsUint32(timeout) : 0);
+          for (it = model.begin(); it != model.end(); it++) {
+            PyDict_SetItem(ret, PyLong_FromUint32(it->first), PySolverModel(it->second));
+          }
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        /* Returns (model, status) */
+        if (wstatus != nullptr && PyLong_AsBool(wstatus)) {
+          PyObject* tuple = xPyTuple_New(2);
+          PyTuple_SetItem(tuple, 0, ret);
+          PyTuple_SetItem(tuple, 1, PyLong_FromUint32(status));
+          return tuple;
+        }
+
+        return ret;
+      }
+
+
+      static PyObject* triton_getNegatedBranchesModels(PyObject* self, PyObject* noarg) {
+        PyObject* ret = nullptr;
+        std::vector<std::map<triton::uint32, triton::engines::solver::SolverModel>> models;
+
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "getNegatedBranchesModels(): Architecture is not defined.");
+
+        try {
+          models = triton::api.getNegatedBranchesModels();
+          ret = xPyList_New(models.size());
+          for (triton::usize index = 0; index < models.size(); index++) {
+            PyObject* mdict = xPyDict_New();
+            for (auto it = models[index].begin(); it != models[index].end(); it++) {
+              PyDict_SetItem(mdict, PyLong_FromUint32(it->first), PySolverModel(it->second));
+            }
+            PyList_SetItem(ret, index, mdict);
+          }
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
         return ret;
       }
 
 
       static PyObject* triton_getModels(PyObject* self, PyObject* args) {
-        PyObject* ret   = nullptr;
-        PyObject* node  = nullptr;
-        PyObject* limit = nullptr;
+        PyObject* ret     = nullptr;
+        PyObject* node    = nullptr;
+        PyObject* limit   = nullptr;
+        PyObject* wstatus = nullptr;
+        PyObject* timeout = nullptr;
         triton::uint32 index = 0;
+        triton::engines::solver::status_e status = triton::engines::solver::UNKNOWN;
         std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>> models;
         std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>>::iterator it;
 
         /* Extract arguments */
-        PyArg_ParseTuple(args, "|OO", &node, &limit);
+        PyArg_ParseTuple(args, "|OOOO", &node, &limit, &wstatus, &timeout);
 
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
           return PyErr_Format(PyExc_TypeError, "getModels(): Architecture is not defined.");
 
+        /* A batch of constraints: getModels([node, ...], status, timeout) */
+        if (node != nullptr && PyList_Check(node)) {
+          std::vector<triton::ast::AbstractNode*> nodes;
+          std::vector<triton::engines::solver::status_e> batchStatus;
+          std::vector<std::map<triton::uint32, triton::engines::solver::SolverModel>> batch;
+
+          /* The limit is not used by a batch, the arguments are shifted */
+          timeout = wstatus;
+          wstatus = limit;
+
+          for (Py_ssize_t i = 0; i < PyList_Size(node); i++) {
+            PyObject* item = PyList_GetItem(node, i);
+            if (!PyAstNode_Check(item))
+              return PyErr_Format(PyExc_TypeError, "getModels(): Expects a list of AstNode as first argument.");
+            nodes.push_back(PyAstNode_AsAstNode(item));
+          }
+
+          if (wstatus != nullptr && !PyBool_Check(wstatus))
+            return PyErr_Format(PyExc_TypeError, "getModels(): Expects a boolean as second argument.");
+
+          if (timeout != nullptr && !PyLong_Check(timeout) && !PyInt_Check(timeout))
+            return PyErr_Format(PyExc_TypeError, "getModels(): Expects an integer as third argument.");
+
+          try {
+            batch = triton::api.getModels(nodes, &batchStatus, (timeout != nullptr) ? PyLong_AsUint32(timeout) : 0);
+            ret = xPyList_New(batch.size());
+            for (triton::usize i = 0; i < batch.size(); i++) {
+              PyObject* mdict = xPyDict_New();
+              for (auto it2 = batch[i].begin(); it2 != batch[i].end(); it2++)
+                PyDict_SetItem(mdict, PyLong_FromUint32(it2->first), PySolverModel(it2->second));
+              PyList_SetItem(ret, i, mdict);
+            }
+          }
+          catch (const std::exception& e) {
+            return PyErr_Format(PyExc_TypeError, "%s", e.what());
+          }
+
+          /* Returns ([model, ...], [status, ...]) */
+          if (wstatus != nullptr && PyLong_AsBool(wstatus)) {
+            PyObject* tuple  = xPyTuple_New(2);
+            PyObject* slist  = xPyList_New(batchStatus.size());
+            for (triton::usize i = 0; i < batchStatus.size(); i++)
+              PyList_SetItem(slist, i, PyLong_FromUint32(batchStatus[i]));
+            PyTuple_SetItem(tuple, 0, ret);
+            PyTuple_SetItem(tuple, 1, slist);
+            return tuple;
+          }
+
+          return ret;
+        }
+
         if (node == nullptr || !PyAstNode_Check(node))
           return PyErr_Format(PyExc_TypeError, "getModels(): Expects a AstNode as first argument.");
 
         if (limit == nullptr || (!PyLong_Check(limit) && !PyInt_Check(limit)))
           return PyErr_Format(PyExc_TypeError, "getModels(): Expects an integer as second argument.");
 
+        if (wstatus != nullptr && !PyBool_Check(wstatus))
+          return PyErr_Format(PyExc_TypeError, "getModels(): Expects a boolean as third argument.");
+
+        if (timeout != nullptr && !PyLong_Check(timeout) && !PyInt_Check(timeout))
+          return PyErr_Format(PyExc_TypeError, "getModels(): Expects an integer as fourth argument.");
+
         try {
-          models = triton::api.getModels(PyAstNode_AsAstNode(node), PyLong_AsUint32(limit));
+          models = triton::api.getModels(PyAstNode_AsAstNode(node), PyLong_AsUint32(limit), &status, (timeout != nullptr) ? PyLong_AsUint32(timeout) : 0);
           ret = xPyList_New(models.size());
           for (it = models.begin(); it != models.end(); it++) {
             PyObject* mdict = xPyDict_New();
@@ -1522,6 +1938,14 @@ namespace triton {
           return PyErr_Format(PyExc_TypeError, "%s", e.what());
         }
 
+        /* Returns ([model, ...], status) */
+        if (wstatus != nullptr && PyLong_AsBool(wstatus)) {
+          PyObject* tuple = xPyTuple_New(2);
+          PyTuple_SetItem(tuple, 0, ret);
+          PyTuple_SetItem(tuple, 1, PyLong_FromUint32(status));
+          return tuple;
+        }
+
         return ret;
       }
 
@@ -1573,6 +1997,116 @@ namespace triton {
       }
 
 
+      static PyObject* triton_getRelevantPathConstraintsAst(PyObject* self, PyObject* node) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "getRelevantPathConstraintsAst(): Architecture is not defined.");
+
+        if (!PyAstNode_Check(node))
+          return PyErr_Format(PyExc_TypeError, "getRelevantPathConstraintsAst(): Expects a AstNode as argument.");
+
+        try {
+          return PyAstNode(triton::api.getRelevantPathConstraintsAst(PyAstNode_AsAstNode(node)));
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* triton_getSolverMemoryLimit(PyObject* self, PyObject* noarg) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "getSolverMemoryLimit(): Architecture is not defined.");
+
+        try {
+          return PyLong_FromUint32(triton::api.getSolverMemoryLimit());
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* triton_getSolverQueryStats(PyObject* self, PyObject* noarg) {
+        PyObject* ret = nullptr;
+        std::list<std::map<std::string, triton::uint64>>::const_iterator it;
+        std::map<std::string, triton::uint64>::const_iterator it2;
+        triton::uint32 index = 0;
+
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "getSolverQueryStats(): Architecture is not defined.");
+
+        try {
+          const std::list<std::map<std::string, triton::uint64>>& stats = triton::api.getSolverQueryStats();
+          ret = xPyList_New(stats.size());
+          for (it = stats.begin(); it != stats.end(); it++) {
+            PyObject* sdict = xPyDict_New();
+            for (it2 = it->begin(); it2 != it->end(); it2++)
+              PyDict_SetItem(sdict, PyString_FromString(it2->first.c_str()), PyLong_FromUint64(it2->second));
+            PyList_SetItem(ret, index++, sdict);
+          }
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
+      static PyObject* triton_getSolverTimeout(PyObject* self, PyObject* noarg) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "getSolverTimeout(): Architecture is not defined.");
+
+        try {
+          return PyLong_FromUint32(triton::api.getSolverTimeout());
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* triton_getSolverThreads(PyObject* self, PyObject* noarg) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "getSolverThreads(): Architecture is not defined.");
+
+        try {
+          return PyLong_FromUint32(triton::api.getSolverThreads());
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
+      static PyObject* triton_getSolverQueryCacheStats(PyObject* self, PyObject* noarg) {
+        PyObject* ret = nullptr;
+        std::map<std::string, triton::usize> stats;
+        std::map<std::string, triton::usize>::iterator it;
+
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "getSolverQueryCacheStats(): Architecture is not defined.");
+
+        try {
+          stats = triton::api.getSolverQueryCacheStats();
+          ret   = xPyDict_New();
+          for (it = stats.begin(); it != stats.end(); it++)
+            PyDict_SetItem(ret, PyString_FromString(it->first.c_str()), PyLong_FromUsize(it->second));
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
       static PyObject* triton_getPathConstraintsAst(PyObject* self, PyObject* noarg) {
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
@@ -1827,6 +2361,54 @@ namespace triton {
       }
 
 
+      static PyObject* triton_getTaintLabels(PyObject* self, PyObject* args) {
+        PyObject* ret     = nullptr;
+        PyObject* target  = nullptr;
+        PyObject* size    = nullptr;
+        triton::usize index = 0;
+        std::set<triton::uint32> labels;
+        std::set<triton::uint32>::iterator it;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &target, &size);
+
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "getTaintLabels(): Architecture is not defined.");
+
+        if (target == nullptr)
+          return PyErr_Format(PyExc_TypeError, "getTaintLabels(): Expects a Memory, a Register or an integer as first argument.");
+
+        if (size != nullptr && (!PyLong_Check(size) && !PyInt_Check(size)))
+          return PyErr_Format(PyExc_TypeError, "getTaintLabels(): Expects an integer as second argument.");
+
+        try {
+          if (PyMemoryOperand_Check(target))
+            labels = triton::api.getTaintLabels(*PyMemoryOperand_AsMemoryOperand(target));
+
+          else if (PyRegisterOperand_Check(target))
+            labels = triton::api.getTaintLabels(*PyRegisterOperand_AsRegisterOperand(target));
+
+          else if (PyLong_Check(target) || PyInt_Check(target))
+            labels = triton::api.getTaintLabels(PyLong_AsUint64(target), (size != nullptr) ? PyLong_AsUint32(size) : 1);
+
+          else
+            return PyErr_Format(PyExc_TypeError, "getTaintLabels(): Expects a Memory, a Register or an integer as first argument.");
+
+          ret = xPyList_New(labels.size());
+          for (it = labels.begin(); it != labels.end(); it++) {
+            PyList_SetItem(ret, index, PyLong_FromUint32(*it));
+            index++;
+          }
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        return ret;
+      }
+
+
       static PyObject* triton_isArchitectureValid(PyObject* self, PyObject* noarg) {
         if (triton::api.isArchitectureValid() == true)
           Py_RETURN_TRUE;
@@ -1959,6 +2541,16 @@ namespace triton {
       }
 
 
+      static PyObject* triton_isTaintLabelsEnabled(PyObject* self, PyObject* noarg) {
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "isTaintLabelsEnabled(): Architecture is not defined.");
+
+        if (triton::api.isTaintLabelsEnabled() == true)
+          Py_RETURN_TRUE;
+        Py_RETURN_FALSE;
+      }
+
+
       static PyObject* triton_newSymbolicExpression(PyObject* self, PyObject* args) {
         PyObject* node          = nullptr;
         PyObject* comment       = nullptr;
@@ -2019,6 +2611,42 @@ namespace triton {
       }
 
 
+      static PyObject* triton_processBasicBlock(PyObject* self, PyObject* args) {
+        std::vector<triton::arch::Instruction> block;
+        PyObject* addr    = nullptr;
+        PyObject* opcodes = nullptr;
+        PyObject* ret     = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &addr, &opcodes);
+
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "processBasicBlock(): Architecture is not defined.");
+
+        if (addr == nullptr || (!PyLong_Check(addr) && !PyInt_Check(addr)))
+          return PyErr_Format(PyExc_TypeError, "processBasicBlock(): Expects an integer as first argument.");
+
+        if (opcodes == nullptr || !PyBytes_Check(opcodes))
+          return PyErr_Format(PyExc_TypeError, "processBasicBlock(): Expects a bytes as second argument.");
+
+        try {
+          triton::uint8* area = reinterpret_cast<triton::uint8*>(PyBytes_AsString(opcodes));
+          triton::usize  size = static_cast<triton::usize>(PyBytes_Size(opcodes));
+          block = triton::api.processBasicBlock(area, size, PyLong_AsUint64(addr));
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        ret = xPyList_New(block.size());
+        for (triton::usize index = 0; index < block.size(); index++)
+          PyList_SetItem(ret, index, PyInstruction(block[index]));
+
+        return ret;
+      }
+
+
       static PyObject* triton_processing(PyObject* self, PyObject* inst) {
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
@@ -2029,6 +2657,7 @@ namespace triton {
 
         try {
           triton::api.processing(*PyInstruction_AsInstruction(inst));
+          recordInstructionExpressions(inst);
         }
         catch (const std::exception& e) {
           return PyErr_Format(PyExc_TypeError, "%s", e.what());
@@ -2059,6 +2688,20 @@ namespace triton {
       }
 
 
+      static PyObject* triton_removeDeadSymbolicExpressions(PyObject* self, PyObject* noarg) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "removeDeadSymbolicExpressions(): Architecture is not defined.");
+
+        try {
+          return PyLong_FromUsize(triton::api.removeDeadSymbolicExpressions());
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+      }
+
+
       static PyObject* triton_removeSimplificationCallback(PyObject* self, PyObject* cb) {
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
@@ -2272,6 +2915,66 @@ namespace triton {
       }
 
 
+      static PyObject* triton_setSolverMemoryLimit(PyObject* self, PyObject* limit) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "setSolverMemoryLimit(): Architecture is not defined.");
+
+        if (!PyLong_Check(limit) && !PyInt_Check(limit))
+          return PyErr_Format(PyExc_TypeError, "setSolverMemoryLimit(): Expects an integer as argument.");
+
+        try {
+          triton::api.setSolverMemoryLimit(PyLong_AsUint32(limit));
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* triton_setSolverThreads(PyObject* self, PyObject* threads) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "setSolverThreads(): Architecture is not defined.");
+
+        if (!PyLong_Check(threads) && !PyInt_Check(threads))
+          return PyErr_Format(PyExc_TypeError, "setSolverThreads(): Expects an integer as argument.");
+
+        try {
+          triton::api.setSolverThreads(PyLong_AsUint32(threads));
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
+      static PyObject* triton_setSolverTimeout(PyObject* self, PyObject* timeout) {
+        /* Check if the architecture is definied */
+        if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
+          return PyErr_Format(PyExc_TypeError, "setSolverTimeout(): Architecture is not defined.");
+
+        if (!PyLong_Check(timeout) && !PyInt_Check(timeout))
+          return PyErr_Format(PyExc_TypeError, "setSolverTimeout(): Expects an integer as argument.");
+
+        try {
+          triton::api.setSolverTimeout(PyLong_AsUint32(timeout));
+        }
+        catch (const std::exception& e) {
+          return PyErr_Format(PyExc_TypeError, "%s", e.what());
+        }
+
+        Py_INCREF(Py_None);
+        return Py_None;
+      }
+
+
       static PyObject* triton_setTaintMemory(PyObject* self, PyObject* args) {
         PyObject* mem    = nullptr;
         PyObject* flag   = nullptr;
@@ -2507,24 +3210,44 @@ namespace triton {
       }
 
 
-      static PyObject* triton_taintMemory(PyObject* self, PyObject* mem) {
+      static PyObject* triton_taintMemory(PyObject* self, PyObject* args) {
+        PyObject* mem    = nullptr;
+        PyObject* label  = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &mem, &label);
+
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
           return PyErr_Format(PyExc_TypeError, "taintMemory(): Architecture is not defined.");
 
+        if (mem == nullptr)
+          return PyErr_Format(PyExc_TypeError, "taintMemory(): Expects a Memory or an integer as first argument.");
+
+        if (label != nullptr && (!PyLong_Check(label) && !PyInt_Check(label)))
+          return PyErr_Format(PyExc_TypeError, "taintMemory(): Expects an integer as second argument.");
+
         try {
           if (PyMemoryOperand_Check(mem)) {
-            if (triton::api.taintMemory(*PyMemoryOperand_AsMemoryOperand(mem)) == true)
+            if (label != nullptr) {
+              if (triton::api.taintMemory(*PyMemoryOperand_AsMemoryOperand(mem), PyLong_AsUint32(label)) == true)
+                Py_RETURN_TRUE;
+            }
+            else if (triton::api.taintMemory(*PyMemoryOperand_AsMemoryOperand(mem)) == true)
               Py_RETURN_TRUE;
           }
 
           else if (PyLong_Check(mem) || PyInt_Check(mem)) {
-            if (triton::api.taintMemory(PyLong_AsUint64(mem)) == true)
+            if (label != nullptr) {
+              if (triton::api.taintMemory(PyLong_AsUint64(mem), PyLong_AsUint32(label)) == true)
+                Py_RETURN_TRUE;
+            }
+            else if (triton::api.taintMemory(PyLong_AsUint64(mem)) == true)
               Py_RETURN_TRUE;
           }
 
           else
-            return PyErr_Format(PyExc_TypeError, "taintMemory(): Expects a Memory or an integer as argument.");
+            return PyErr_Format(PyExc_TypeError, "taintMemory(): Expects a Memory or an integer as first argument.");
         }
         catch (const std::exception& e) {
           return PyErr_Format(PyExc_TypeError, "%s", e.what());
@@ -2533,15 +3256,29 @@ namespace triton {
       }
 
 
-      static PyObject* triton_taintRegister(PyObject* self, PyObject* reg) {
+      static PyObject* triton_taintRegister(PyObject* self, PyObject* args) {
+        PyObject* reg    = nullptr;
+        PyObject* label  = nullptr;
+
+        /* Extract arguments */
+        PyArg_ParseTuple(args, "|OO", &reg, &label);
+
         /* Check if the architecture is definied */
         if (triton::api.getArchitecture() == triton::arch::ARCH_INVALID)
           return PyErr_Format(PyExc_TypeError, "taintRegister(): Architecture is not defined.");
 
-        if (!PyRegisterOperand_Check(reg))
-          return PyErr_Format(PyExc_TypeError, "taintRegister(): Expects a Memory as argument.");
+        if (reg == nullptr || !PyRegisterOperand_Check(reg))
+          return PyErr_Format(PyExc_TypeError, "taintRegister(): Expects a Register as first argument.");
+
+        if (label != nullptr && (!PyLong_Check(label) && !PyInt_Check(label)))
+          return PyErr_Format(PyExc_TypeError, "taintRegister(): Expects an integer as second argument.");
 
         try {
+          if (label != nullptr) {
+            if (triton::api.taintRegister(*PyRegisterOperand_AsRegisterOperand(reg), PyLong_AsUint32(label)) == true)
+              Py_RETURN_TRUE;
+            Py_RETURN_FALSE;
+          }
           if (triton::api.taintRegister(*PyRegisterOperand_AsRegisterOperand(reg)) == true)
             Py_RETURN_TRUE;
           Py_RETURN_FALSE;
@@ -2794,6 +3531,9 @@ namespace triton {
         {"buildSymbolicMemory",                 (PyCFunction)triton_buildSymbolicMemory,                    METH_O,             ""},
         {"buildSymbolicRegister",               (PyCFunction)triton_buildSymbolicRegister,                  METH_O,             ""},
         {"clearPathConstraints",                (PyCFunction)triton_clearPathConstraints,                   METH_NOARGS,        ""},
+        {"clearSolverQueryCache",               (PyCFunction)triton_clearSolverQueryCache,                  METH_NOARGS,        ""},
+        {"clearSolverQueryStats",               (PyCFunction)triton_clearSolverQueryStats,                  METH_NOARGS,        ""},
+        {"collectAstNodes",                     (PyCFunction)triton_collectAstNodes,                        METH_NOARGS,        ""},
         {"concretizeAllMemory",                 (PyCFunction)triton_concretizeAllMemory,                    METH_NOARGS,        ""},
         {"concretizeAllRegister",               (PyCFunction)triton_concretizeAllRegister,                  METH_NOARGS,        ""},
         {"concretizeMemory",                    (PyCFunction)triton_concretizeMemory,                       METH_O,             ""},
@@ -2813,6 +3553,8 @@ namespace triton {
         {"enableSymbolicOptimization",          (PyCFunction)triton_enableSymbolicOptimization,             METH_VARARGS,       ""},
         {"enableSymbolicZ3Simplification",      (PyCFunction)triton_enableSymbolicZ3Simplification,         METH_O,             ""},
         {"enableTaintEngine",                   (PyCFunction)triton_enableTaintEngine,                      METH_O,             ""},
+        {"enableTaintLabels",                   (PyCFunction)triton_enableTaintLabels,                      METH_O,             ""},
+        {"enumerateModels",                     (PyCFunction)triton_enumerateModels,                        METH_VARARGS,       ""},
         {"evaluateAstViaZ3",                    (PyCFunction)triton_evaluateAstViaZ3,                       METH_O,             ""},
         {"getAllRegisters",                     (PyCFunction)triton_getAllRegisters,                        METH_NOARGS,        ""},
         {"getArchitecture",                     (PyCFunction)triton_getArchitecture,                        METH_NOARGS,        ""},
@@ -2822,13 +3564,21 @@ namespace triton {
         {"getConcreteMemoryAreaValue",          (PyCFunction)triton_getConcreteMemoryAreaValue,             METH_VARARGS,       ""},
         {"getConcreteMemoryValue",              (PyCFunction)triton_getConcreteMemoryValue,                 METH_O,             ""},
         {"getConcreteRegisterValue",            (PyCFunction)triton_getConcreteRegisterValue,               METH_O,             ""},
-        {"getFullAst",                          (PyCFunction)triton_getFullAst,                             METH_O,             ""},
-        {"getFullAstFromId",                    (PyCFunction)triton_getFullAstFromId,                       METH_O,             ""},
-        {"getModel",                            (PyCFunction)triton_getModel,                               METH_O,             ""},
+        {"getFullAst",                          (PyCFunction)triton_getFullAst,                             METH_VARARGS,       ""},
+        {"getFullAstFromId",                    (PyCFunction)triton_getFullAstFromId,                       METH_VARARGS,       ""},
+        {"getModel",                            (PyCFunction)triton_getModel,                               METH_VARARGS,       ""},
         {"getModels",                           (PyCFunction)triton_getModels,                              METH_VARARGS,       ""},
+        {"getNegatedBranchModel",               (PyCFunction)triton_getNegatedBranchModel,                  METH_VARARGS,       ""},
+        {"getNegatedBranchesModels",            (PyCFunction)triton_getNegatedBranchesModels,               METH_NOARGS,        ""},
         {"getParentRegisters",                  (PyCFunction)triton_getParentRegisters,                     METH_NOARGS,        ""},
         {"getPathConstraints",                  (PyCFunction)triton_getPathConstraints,                     METH_NOARGS,        ""},
         {"getPathConstraintsAst",               (PyCFunction)triton_getPathConstraintsAst,                  METH_NOARGS,        ""},
+        {"getRelevantPathConstraintsAst",       (PyCFunction)triton_getRelevantPathConstraintsAst,          METH_O,             ""},
+        {"getSolverMemoryLimit",                (PyCFunction)triton_getSolverMemoryLimit,                   METH_NOARGS,        ""},
+        {"getSolverQueryCacheStats",            (PyCFunction)triton_getSolverQueryCacheStats,               METH_NOARGS,        ""},
+        {"getSolverQueryStats",                 (PyCFunction)triton_getSolverQueryStats,                    METH_NOARGS,        ""},
+        {"getSolverThreads",                    (PyCFunction)triton_getSolverThreads,                       METH_NOARGS,        ""},
+        {"getSolverTimeout",                    (PyCFunction)triton_getSolverTimeout,                       METH_NOARGS,        ""},
         {"getSymbolicExpressionFromId",         (PyCFunction)triton_getSymbolicExpressionFromId,            METH_O,             ""},
         {"getSymbolicExpressions",              (PyCFunction)triton_getSymbolicExpressions,                 METH_NOARGS,        ""},
         {"getSymbolicMemory",                   (PyCFunction)triton_getSymbolicMemory,                      METH_NOARGS,        ""},
@@ -2841,6 +3591,7 @@ namespace triton {
         {"getSymbolicVariableFromName",         (PyCFunction)triton_getSymbolicVariableFromName,            METH_O,             ""},
         {"getSymbolicVariables",                (PyCFunction)triton_getSymbolicVariables,                   METH_NOARGS,        ""},
         {"getTaintedSymbolicExpressions",       (PyCFunction)triton_getTaintedSymbolicExpressions,          METH_NOARGS,        ""},
+        {"getTaintLabels",                      (PyCFunction)triton_getTaintLabels,                         METH_VARARGS,       ""},
         {"isArchitectureValid",                 (PyCFunction)triton_isArchitectureValid,                    METH_NOARGS,        ""},
         {"isMemoryMapped",                      (PyCFunction)triton_isMemoryMapped,                         METH_VARARGS,       ""},
         {"isMemoryTainted",                     (PyCFunction)triton_isMemoryTainted,                        METH_O,             ""},
@@ -2850,10 +3601,13 @@ namespace triton {
         {"isSymbolicOptimizationEnabled",       (PyCFunction)triton_isSymbolicOptimizationEnabled,          METH_O,             ""},
         {"isSymbolicZ3SimplificationEnabled",   (PyCFunction)triton_isSymbolicZ3SimplificationEnabled,      METH_NOARGS,        ""},
         {"isTaintEngineEnabled",                (PyCFunction)triton_isTaintEngineEnabled,                   METH_NOARGS,        ""},
+        {"isTaintLabelsEnabled",                (PyCFunction)triton_isTaintLabelsEnabled,                   METH_NOARGS,        ""},
         {"newSymbolicExpression",               (PyCFunction)triton_newSymbolicExpression,                  METH_VARARGS,       ""},
         {"newSymbolicVariable",                 (PyCFunction)triton_newSymbolicVariable,                    METH_VARARGS,       ""},
+        {"processBasicBlock",                   (PyCFunction)triton_processBasicBlock,                      METH_VARARGS,       ""},
         {"processing",                          (PyCFunction)triton_processing,                             METH_O,             ""},
         {"recordSimplificationCallback",        (PyCFunction)triton_recordSimplificationCallback,           METH_O,             ""},
+        {"removeDeadSymbolicExpressions",       (PyCFunction)triton_removeDeadSymbolicExpressions,          METH_NOARGS,        ""},
         {"removeSimplificationCallback",        (PyCFunction)triton_removeSimplificationCallback,           METH_O,             ""},
         {"resetEngines",                        (PyCFunction)triton_resetEngines,                           METH_NOARGS,        ""},
         {"setArchitecture",                     (PyCFunction)triton_setArchitecture,                        METH_O,             ""},
@@ -2861,6 +3615,9 @@ namespace triton {
         {"setConcreteMemoryAreaValue",          (PyCFunction)triton_setConcreteMemoryAreaValue,             METH_VARARGS,       ""},
         {"setConcreteMemoryValue",              (PyCFunction)triton_setConcreteMemoryValue,                 METH_VARARGS,       ""},
         {"setConcreteRegisterValue",            (PyCFunction)triton_setConcreteRegisterValue,               METH_O,             ""},
+        {"setSolverMemoryLimit",                (PyCFunction)triton_setSolverMemoryLimit,                   METH_O,             ""},
+        {"setSolverThreads",                    (PyCFunction)triton_setSolverThreads,                       METH_O,             ""},
+        {"setSolverTimeout",                    (PyCFunction)triton_setSolverTimeout,                       METH_O,             ""},
         {"setTaintMemory",                      (PyCFunction)triton_setTaintMemory,                         METH_VARARGS,       ""},
         {"setTaintRegister",                    (PyCFunction)triton_setTaintRegister,                       METH_VARARGS,       ""},
         {"simplify",                            (PyCFunction)triton_simplify,                               METH_VARARGS,       ""},
@@ -2870,8 +3627,8 @@ namespace triton {
         {"taintAssignmentRegisterImmediate",    (PyCFunction)triton_taintAssignmentRegisterImmediate,       METH_O,             ""},
         {"taintAssignmentRegisterMemory",       (PyCFunction)triton_taintAssignmentRegisterMemory,          METH_VARARGS,       ""},
         {"taintAssignmentRegisterRegister",     (PyCFunction)triton_taintAssignmentRegisterRegister,        METH_VARARGS,       ""},
-        {"taintMemory",                         (PyCFunction)triton_taintMemory,                            METH_O,             ""},
-        {"taintRegister",                       (PyCFunction)triton_taintRegister,                          METH_O,             ""},
+        {"taintMemory",                         (PyCFunction)triton_taintMemory,                            METH_VARARGS,       ""},
+        {"taintRegister",                       (PyCFunction)triton_taintRegister,                          METH_VARARGS,       ""},
         {"taintUnionMemoryImmediate",           (PyCFunction)triton_taintUnionMemoryImmediate,              METH_O,             ""},
         {"taintUnionMemoryMemory",              (PyCFunction)triton_taintUnionMemoryMemory,                 METH_VARARGS,       ""},
         {"taintUnionMemoryRegister",            (PyCFunction)triton_taintUnionMemoryRegister,               METH_VARARGS,       ""},
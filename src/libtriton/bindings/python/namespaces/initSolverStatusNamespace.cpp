@@ -0,0 +1,72 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifdef TRITON_PYTHON_BINDINGS
+
+#include <pythonBindings.hpp>
+#include <pythonUtils.hpp>
+#include <solverEnums.hpp>
+
+
+
+/*! \page py_SOLVER_STATUS_page SOLVER_STATUS
+    \brief [**python api**] All information about the SOLVER_STATUS python namespace.
+
+\tableofcontents
+
+\section SOLVER_STATUS_py_description Description
+<hr>
+
+The SOLVER_STATUS namespace contains all status of a solver query.
+
+\subsection SOLVER_STATUS_py_example Example
+
+~~~~~~~~~~~~~{.py}
+>>> model, status = getModel(node, True, 1000)
+>>> if status == SOLVER_STATUS.TIMEOUT:
+...     print 'Too hard'
+~~~~~~~~~~~~~
+
+\section SOLVER_STATUS_py_api Python API - Items of the SOLVER_STATUS namespace
+<hr>
+
+- **SOLVER_STATUS.SAT**<br>
+The query has a model.
+
+- **SOLVER_STATUS.UNSAT**<br>
+The query has no model.
+
+- **SOLVER_STATUS.TIMEOUT**<br>
+The solver has been stopped by the timeout before finding an answer.
+
+- **SOLVER_STATUS.OUTOFMEM**<br>
+The solver has reached the memory limit before finding an answer.
+
+- **SOLVER_STATUS.UNKNOWN**<br>
+The solver has given up for another reason.
+
+*/
+
+
+
+namespace triton {
+  namespace bindings {
+    namespace python {
+
+      void initSolverStatusNamespace(PyObject* solverStatusDict) {
+        PyDict_SetItemString(solverStatusDict, "SAT",       PyLong_FromUint32(triton::engines::solver::SAT));
+        PyDict_SetItemString(solverStatusDict, "UNSAT",     PyLong_FromUint32(triton::engines::solver::UNSAT));
+        PyDict_SetItemString(solverStatusDict, "TIMEOUT",   PyLong_FromUint32(triton::engines::solver::TIMEOUT));
+        PyDict_SetItemString(solverStatusDict, "OUTOFMEM",  PyLong_FromUint32(triton::engines::solver::OUTOFMEM));
+        PyDict_SetItemString(solverStatusDict, "UNKNOWN",   PyLong_FromUint32(triton::engines::solver::UNKNOWN));
+      }
+
+    }; /* python namespace */
+  }; /* bindings namespace */
+}; /* triton namespace */
+
+#endif /* TRITON_PYTHON_BINDINGS */
@@ -39,15 +39,43 @@ Enabled, Triton will keep a map of aligned memory to reduce the symbolic memory
 - **OPTIMIZATION.AST_DICTIONARIES**<br>
 Enabled, Triton will record all AST nodes into several dictionaries and try to return node already allocated instead of allocate twice the same node.
 
+- **OPTIMIZATION.AST_GARBAGE_COLLECTION**<br>
+Enabled, Triton will periodically free the AST nodes which are not reachable anymore from the symbolic expressions, the path constraints or a python object.
+As every symbolic expression keeps its AST alive, the nodes of a trace are only freed once their symbolic expressions are removed.
+
+- **OPTIMIZATION.DEAD_EXPRESSIONS_ELIMINATION**<br>
+Enabled, `processBasicBlock()` periodically removes the symbolic expressions which are not live anymore: the ones which are not
+assigned to a register or to the memory and which are not referenced by a path constraint or another live expression. The memory
+used by the symbolic engine follows the live state instead of the length of the trace. The \ref py_Instruction_page and
+\ref py_SymbolicExpression_page objects keep the removed expressions they reference alive. See also `removeDeadSymbolicExpressions()`.
+
+- **OPTIMIZATION.LAZY_FLAGS**<br>
+Enabled, the x86 flag semantics handled by `SEMANTICS_TEMPLATES` only compute the concrete value of the flag. The AST of the flag
+expression is built the first time it is used: when the flag is read by another instruction or when the AST is requested through the API.
+Flags overwritten before being read never get an AST. Their AST is also built when the written registers of the instruction are read.
+
 - **OPTIMIZATION.ONLY_ON_SYMBOLIZED**<br>
 Enabled, Triton will perform symbolic execution only on symbolized expressions.
 
 - **OPTIMIZATION.ONLY_ON_TAINTED**<br>
 Enabled, Triton will perform symbolic execution only on tainted instructions.
 
+- **OPTIMIZATION.PC_INDEPENDENCE**<br>
+Enabled, `getNegatedBranchModel()` only sends to the solver the path constraints which share symbolic variables, directly or through
+other path constraints, with the negated branch. `getModel()` drops the path constraints of its conjunction which do not share
+symbolic variables with the rest of the query. The others are satisfied by the concrete values of the variables which are not
+part of the model.
+
 - **OPTIMIZATION.PC_TRACKING_SYMBOLIC**<br>
 Enabled, Triton will track path constraints only if they are symbolized. This optimization is enabled by default.
 
+- **OPTIMIZATION.SEMANTICS_TEMPLATES**<br>
+Enabled, the x86 flag semantics (`af`, `cf`, `of`, `pf`, `sf` and `zf` of the arithmetic and logical instructions) are built once per
+operand size as AST templates. Next executions only duplicate the nodes which depend on the operands, the constants are shared.
+
+- **OPTIMIZATION.SOLVER_QUERY_CACHE**<br>
+Enabled, Triton will remember the answers of the solver and reuse them for the same queries. Before asking the solver, the last models found are also evaluated against the new query and returned if one of them satisfies it.
+
 */
 
 
@@ -57,11 +85,17 @@ namespace triton {
     namespace python {
 
       void initSymOptiNamespace(PyObject* symOptiDict) {
-        PyDict_SetItemString(symOptiDict, "ALIGNED_MEMORY",         PyLong_FromUint32(triton::engines::symbolic::ALIGNED_MEMORY));
-        PyDict_SetItemString(symOptiDict, "AST_DICTIONARIES",       PyLong_FromUint32(triton::engines::symbolic::AST_DICTIONARIES));
-        PyDict_SetItemString(symOptiDict, "ONLY_ON_SYMBOLIZED",     PyLong_FromUint32(triton::engines::symbolic::ONLY_ON_SYMBOLIZED));
-        PyDict_SetItemString(symOptiDict, "ONLY_ON_TAINTED",        PyLong_FromUint32(triton::engines::symbolic::ONLY_ON_TAINTED));
-        PyDict_SetItemString(symOptiDict, "PC_TRACKING_SYMBOLIC",   PyLong_FromUint32(triton::engines::symbolic::PC_TRACKING_SYMBOLIC));
+        PyDict_SetItemString(symOptiDict, "ALIGNED_MEMORY",               PyLong_FromUint32(triton::engines::symbolic::ALIGNED_MEMORY));
+        PyDict_SetItemString(symOptiDict, "AST_DICTIONARIES",             PyLong_FromUint32(triton::engines::symbolic::AST_DICTIONARIES));
+        PyDict_SetItemString(symOptiDict, "AST_GARBAGE_COLLECTION",       PyLong_FromUint32(triton::engines::symbolic::AST_GARBAGE_COLLECTION));
+        PyDict_SetItemString(symOptiDict, "DEAD_EXPRESSIONS_ELIMINATION", PyLong_FromUint32(triton::engines::symbolic::DEAD_EXPRESSIONS_ELIMINATION));
+        PyDict_SetItemString(symOptiDict, "LAZY_FLAGS",                   PyLong_FromUint32(triton::engines::symbolic::LAZY_FLAGS));
+        PyDict_SetItemString(symOptiDict, "ONLY_ON_SYMBOLIZED",           PyLong_FromUint32(triton::engines::symbolic::ONLY_ON_SYMBOLIZED));
+        PyDict_SetItemString(symOptiDict, "ONLY_ON_TAINTED",              PyLong_FromUint32(triton::engines::symbolic::ONLY_ON_TAINTED));
+        PyDict_SetItemString(symOptiDict, "PC_INDEPENDENCE",              PyLong_FromUint32(triton::engines::symbolic::PC_INDEPENDENCE));
+        PyDict_SetItemString(symOptiDict, "PC_TRACKING_SYMBOLIC",         PyLong_FromUint32(triton::engines::symbolic::PC_TRACKING_SYMBOLIC));
+        PyDict_SetItemString(symOptiDict, "SEMANTICS_TEMPLATES",          PyLong_FromUint32(triton::engines::symbolic::SEMANTICS_TEMPLATES));
+        PyDict_SetItemString(symOptiDict, "SOLVER_QUERY_CACHE",           PyLong_FromUint32(triton::engines::symbolic::SOLVER_QUERY_CACHE));
       }
 
     }; /* python namespace */
@@ -9,6 +9,7 @@
 
 #include <z3++.h>
 
+#include <api.hpp>
 #include <ast.hpp>
 #include <pythonObjects.hpp>
 #include <pythonUtils.hpp>
@@ -60,7 +61,7 @@ Returns the node vector size.
 Returns the list of child nodes as \ref py_AstNode_page.
 
 - **getHash(void)**<br>
-Returns the hash (signature) of the AST as float.
+Returns the structural hash (signature) of the AST as integer. The hash is computed once when the node is built.
 
 - **getKind(void)**<br>
 Returns the kind of the node as \ref py_AST_NODE_page.<br>
@@ -92,7 +93,8 @@ namespace triton {
       //! AstNode destructor.
       void AstNode_dealloc(PyObject* self) {
         std::cout << std::flush;
-        Py_DECREF(self);
+        triton::api.unpinAstNode(PyAstNode_AsAstNode(self));
+        PyObject_Del(self);
       }
 
 
@@ -146,7 +148,7 @@ namespace triton {
 
       static PyObject* AstNode_getHash(PyObject* self, PyObject* noarg) {
         try {
-          return PyLong_FromUint512(PyAstNode_AsAstNode(self)->hash(1));
+          return PyLong_FromUint64(PyAstNode_AsAstNode(self)->getHash());
         }
         catch (const std::exception& e) {
           return PyErr_Format(PyExc_TypeError, "%s", e.what());
@@ -167,7 +169,7 @@ namespace triton {
       static PyObject* AstNode_getParents(PyObject* self, PyObject* noarg) {
         try {
           PyObject* ret = nullptr;
-          std::set<triton::ast::AbstractNode*>& parents = PyAstNode_AsAstNode(self)->getParents();
+          std::set<triton::ast::AbstractNode*> parents = PyAstNode_AsAstNode(self)->getParents();
           ret = xPyList_New(parents.size());
           triton::uint32 index = 0;
           for (std::set<triton::ast::AbstractNode*>::iterator it = parents.begin(); it != parents.end(); it++)
@@ -264,7 +266,7 @@ namespace triton {
 
 
       static int AstNode_cmp(AstNode_Object* a, AstNode_Object* b) {
-        return !(a->node->hash(1) == b->node->hash(1));
+        return !(a->node->getHash() == b->node->getHash());
       }
 
 
@@ -571,8 +573,11 @@ namespace triton {
 
         PyType_Ready(&AstNode_Type);
         object = PyObject_NEW(AstNode_Object, &AstNode_Type);
-        if (object != NULL)
+        if (object != NULL) {
           object->node = node;
+          /* The node must survive the collections as long as the python object lives */
+          triton::api.pinAstNode(node);
+        }
 
         return (PyObject*)object;
       }
@@ -180,10 +180,28 @@ namespace triton {
   namespace bindings {
     namespace python {
 
+      //! Releases the symbolic expressions and unpins the AST nodes of a pyInstruction.
+      static void releaseInstructionExpressions(PyObject* obj) {
+        Instruction_Object* object = reinterpret_cast<Instruction_Object*>(obj);
+
+        for (triton::usize index = 0; index < object->symExprs->size(); index++)
+          triton::api.releaseSymbolicExpression((*object->symExprs)[index]);
+
+        for (triton::usize index = 0; index < object->nodes->size(); index++)
+          triton::api.unpinAstNode((*object->nodes)[index]);
+
+        object->symExprs->clear();
+        object->nodes->clear();
+      }
+
+
       //! Instruction destructor.
       void Instruction_dealloc(PyObject* self) {
         std::cout << std::flush;
-        delete PyInstruction_AsInstruction(self);
+        releaseInstructionExpressions(self);
+        delete reinterpret_cast<Instruction_Object*>(self)->inst;
+        delete reinterpret_cast<Instruction_Object*>(self)->symExprs;
+        delete reinterpret_cast<Instruction_Object*>(self)->nodes;
         Py_DECREF(self);
       }
 
@@ -721,7 +739,13 @@ namespace triton {
 
 
       static int Instruction_print(PyObject* self) {
-        std::cout << PyInstruction_AsInstruction(self);
+        try {
+          std::cout << PyInstruction_AsInstruction(self);
+        }
+        catch (const std::exception& e) {
+          PyErr_Format(PyExc_TypeError, "%s", e.what());
+          return -1;
+        }
         return 0;
       }
 
@@ -830,8 +854,11 @@ namespace triton {
 
         PyType_Ready(&Instruction_Type);
         object = PyObject_NEW(Instruction_Object, &Instruction_Type);
-        if (object != NULL)
-          object->inst = new triton::arch::Instruction();
+        if (object != NULL) {
+          object->inst     = new triton::arch::Instruction();
+          object->symExprs = new std::vector<triton::engines::symbolic::SymbolicExpression*>();
+          object->nodes    = new std::vector<triton::ast::AbstractNode*>();
+        }
 
         return (PyObject* )object;
       }
@@ -842,12 +869,39 @@ namespace triton {
 
         PyType_Ready(&Instruction_Type);
         object = PyObject_NEW(Instruction_Object, &Instruction_Type);
-        if (object != NULL)
-          object->inst = new triton::arch::Instruction(inst);
+        if (object != NULL) {
+          object->inst     = new triton::arch::Instruction(inst);
+          object->symExprs = new std::vector<triton::engines::symbolic::SymbolicExpression*>();
+          object->nodes    = new std::vector<triton::ast::AbstractNode*>();
+          recordInstructionExpressions((PyObject*)object);
+        }
 
         return (PyObject*)object;
       }
 
+
+      /*
+       * The symbolic expressions of an instruction may be removed by the
+       * symbolic engine (e.g. dead expressions elimination) while the python
+       * object lives. They are held, so they are only detached from the engine,
+       * and the nodes of the instruction are pinned.
+       */
+      void recordInstructionExpressions(PyObject* obj) {
+        Instruction_Object* object = reinterpret_cast<Instruction_Object*>(obj);
+        const std::vector<triton::engines::symbolic::SymbolicExpression*>& exprs = object->inst->symbolicExpressions;
+
+        releaseInstructionExpressions(obj);
+
+        for (triton::usize index = 0; index < exprs.size(); index++) {
+          triton::api.holdSymbolicExpression(exprs[index]);
+          object->symExprs->push_back(exprs[index]);
+        }
+
+        object->inst->extractAstNodes(*object->nodes);
+        for (triton::usize index = 0; index < object->nodes->size(); index++)
+          triton::api.pinAstNode((*object->nodes)[index]);
+      }
+
     }; /* python namespace */
   }; /* bindings namespace */
 }; /* triton namespace */
@@ -7,6 +7,7 @@
 
 #ifdef TRITON_PYTHON_BINDINGS
 
+#include <api.hpp>
 #include <pathConstraint.hpp>
 #include <pythonObjects.hpp>
 #include <pythonUtils.hpp>
@@ -85,6 +86,9 @@ namespace triton {
       //! PathConstraint destructor.
       void PathConstraint_dealloc(PyObject* self) {
         std::cout << std::flush;
+        const std::vector<std::tuple<bool, triton::uint64, triton::uint64, triton::ast::AbstractNode*>>& branches = PyPathConstraint_AsPathConstraint(self)->getBranchConstraints();
+        for (triton::usize index = 0; index < branches.size(); index++)
+          triton::api.unpinAstNode(std::get<3>(branches[index]));
         delete PyPathConstraint_AsPathConstraint(self);
         Py_DECREF(self);
       }
@@ -212,8 +216,12 @@ namespace triton {
 
         PyType_Ready(&PathConstraint_Type);
         object = PyObject_NEW(PathConstraint_Object, &PathConstraint_Type);
-        if (object != NULL)
+        if (object != NULL) {
           object->pc = new triton::engines::symbolic::PathConstraint(pc);
+          /* The branches must survive the collections as long as the python object lives */
+          for (triton::usize index = 0; index < pc.getBranchConstraints().size(); index++)
+            triton::api.pinAstNode(std::get<3>(pc.getBranchConstraints()[index]));
+        }
 
         return (PyObject*)object;
       }
@@ -128,6 +128,7 @@ namespace triton {
       //! SymbolicExpression destructor.
       void SymbolicExpression_dealloc(PyObject* self) {
         std::cout << std::flush;
+        triton::api.releaseSymbolicExpression(PySymbolicExpression_AsSymbolicExpression(self));
         Py_DECREF(self);
       }
 
@@ -347,8 +348,11 @@ namespace triton {
 
         PyType_Ready(&SymbolicExpression_Type);
         object = PyObject_NEW(SymbolicExpression_Object, &SymbolicExpression_Type);
-        if (object != NULL)
+        if (object != NULL) {
+          /* The expression stays valid if it is removed from the symbolic engine */
+          triton::api.holdSymbolicExpression(symExpr);
           object->symExpr = symExpr;
+        }
 
         return (PyObject*)object;
       }
@@ -5,7 +5,11 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
+#include <chrono>
+#include <iterator>
 #include <stdexcept>
+#include <thread>
 
 #include <api.hpp>
 #include <ast.hpp>
@@ -107,94 +111,885 @@ namespace triton {
 
 
       SolverEngine::SolverEngine() {
+        this->session         = nullptr;
+        this->sessionSolver   = nullptr;
+        this->cacheHits       = 0;
+        this->cacheModelHits  = 0;
+        this->cacheMisses     = 0;
+        this->threads         = std::thread::hardware_concurrency();
+        this->timeout         = 0;
+        this->memoryLimit     = 0;
+        this->queryCount      = 0;
+
+        if (this->threads == 0)
+          this->threads = 1;
       }
 
 
       SolverEngine::~SolverEngine() {
+        /* Unpin the nodes of the query cache */
+        this->clearQueryCache();
+
+        /* The solver must be released before the context owned by the converter */
+        delete this->sessionSolver;
+        delete this->session;
+      }
+
+
+      /* Returns the microseconds elapsed since a time point */
+      static triton::uint64 elapsedSince(const std::chrono::steady_clock::time_point& start) {
+        return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+      }
+
+
+      /* Releases the solvers, then the contexts owned by their converters */
+      static void releaseSolvers(std::vector<z3::solver*>& solvers, std::vector<triton::ast::TritonToZ3Ast*>& converters) {
+        for (triton::usize i = 0; i < solvers.size(); i++)
+          delete solvers[i];
+        for (triton::usize i = 0; i < converters.size(); i++)
+          delete converters[i];
+        solvers.clear();
+        converters.clear();
+      }
+
+
+      void SolverEngine::setLimits(z3::solver& solver, triton::uint32 timeout) const {
+        z3::params p(solver.ctx());
+
+        if (timeout == 0)
+          timeout = this->timeout;
+
+        /* 0 lets Z3 run without timeout or memory limit */
+        p.set("timeout", (timeout != 0) ? timeout : static_cast<triton::uint32>(-1));
+        p.set("max_memory", (this->memoryLimit != 0) ? this->memoryLimit : static_cast<triton::uint32>(-1));
+        solver.set(p);
+      }
+
+
+      /* Z3 only explains an unknown answer through a message */
+      triton::engines::solver::status_e SolverEngine::check(z3::solver& solver) const {
+        std::string reason;
+
+        try {
+          switch (solver.check()) {
+            case z3::sat:
+              return triton::engines::solver::SAT;
+            case z3::unsat:
+              return triton::engines::solver::UNSAT;
+            default:
+              reason = solver.reason_unknown();
+              break;
+          }
+        }
+        catch (const z3::exception& e) {
+          reason = e.msg();
+        }
+
+        if (reason.find("timeout") != std::string::npos || reason.find("canceled") != std::string::npos)
+          return triton::engines::solver::TIMEOUT;
+
+        if (reason.find("memory") != std::string::npos || reason.find("memout") != std::string::npos)
+          return triton::engines::solver::OUTOFMEM;
+
+        return triton::engines::solver::UNKNOWN;
+      }
+
+
+      void SolverEngine::recordQueryStats(triton::uint64 hash, triton::usize nodes, triton::usize variables, triton::uint64 translationTime, triton::uint64 solveTime, triton::engines::solver::status_e status) {
+        std::map<std::string, triton::uint64> stats;
+
+        stats["id"]               = this->queryCount++;
+        stats["hash"]             = hash;
+        stats["nodes"]            = nodes;
+        stats["variables"]        = variables;
+        stats["translationTime"]  = translationTime;
+        stats["solveTime"]        = solveTime;
+        stats["status"]           = status;
+
+        this->queryStats.push_back(stats);
+        if (this->queryStats.size() > SOLVER_QUERY_STATS)
+          this->queryStats.pop_front();
+      }
+
+
+      triton::uint32 SolverEngine::getTimeout(void) const {
+        return this->timeout;
+      }
+
+
+      void SolverEngine::setTimeout(triton::uint32 timeout) {
+        this->timeout = timeout;
+      }
+
+
+      triton::uint32 SolverEngine::getMemoryLimit(void) const {
+        return this->memoryLimit;
+      }
+
+
+      void SolverEngine::setMemoryLimit(triton::uint32 limit) {
+        /* Applied to each solver by setLimits(), other users of Z3 are not affected */
+        this->memoryLimit = limit;
+      }
+
+
+      const std::list<std::map<std::string, triton::uint64>>& SolverEngine::getQueryStats(void) const {
+        return this->queryStats;
+      }
+
+
+      void SolverEngine::clearQueryStats(void) {
+        this->queryStats.clear();
+      }
+
+
+      /*
+       * The hash of a query does not depend on the order of its constraints
+       * nor on an assert node at their root, so equivalent questions asked
+       * from different places share the same entry.
+       */
+      triton::uint64 SolverEngine::getQueryHash(const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query) const {
+        triton::uint64 hash = 0;
+
+        for (triton::usize index = 0; index < query.size(); index++) {
+          triton::ast::AbstractNode* node = query[index].first;
+          if (node->getKind() == triton::ast::ASSERT_NODE)
+            node = node->getChilds()[0];
+          hash += triton::ast::hashMix(node->getHash() ^ static_cast<triton::uint64>(query[index].second));
+        }
+
+        return hash;
+      }
+
+
+      std::vector<std::pair<triton::ast::AbstractNode*, bool>> SolverEngine::normalizeQuery(const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query) const {
+        std::vector<std::pair<triton::ast::AbstractNode*, bool>> ret;
+
+        for (triton::usize index = 0; index < query.size(); index++) {
+          triton::ast::AbstractNode* node = query[index].first;
+          if (node->getKind() == triton::ast::ASSERT_NODE)
+            node = node->getChilds()[0];
+          ret.push_back(std::make_pair(node, query[index].second));
+        }
+
+        std::sort(ret.begin(), ret.end(), [](const std::pair<triton::ast::AbstractNode*, bool>& a, const std::pair<triton::ast::AbstractNode*, bool>& b) {
+          if (a.first->getHash() != b.first->getHash())
+            return a.first->getHash() < b.first->getHash();
+          return a.second < b.second;
+        });
+
+        return ret;
+      }
+
+
+      bool SolverEngine::isSameQueryNode(triton::ast::AbstractNode* node1, triton::ast::AbstractNode* node2) const {
+        std::vector<std::pair<triton::ast::AbstractNode*, triton::ast::AbstractNode*>> worklist(1, std::make_pair(node1, node2));
+        std::set<std::pair<triton::ast::AbstractNode*, triton::ast::AbstractNode*>> visited;
+
+        while (!worklist.empty()) {
+          triton::ast::AbstractNode* a = worklist.back().first;
+          triton::ast::AbstractNode* b = worklist.back().second;
+
+          worklist.pop_back();
+          if (a == b || !visited.insert(std::make_pair(a, b)).second)
+            continue;
+
+          if (a->getKind() != b->getKind() || a->getBitvectorSize() != b->getBitvectorSize())
+            return false;
+
+          switch (a->getKind()) {
+            case triton::ast::DECIMAL_NODE:
+              if (static_cast<triton::ast::DecimalNode*>(a)->getValue() != static_cast<triton::ast::DecimalNode*>(b)->getValue())
+                return false;
+              continue;
+
+            case triton::ast::REFERENCE_NODE:
+              if (static_cast<triton::ast::ReferenceNode*>(a)->getValue() != static_cast<triton::ast::ReferenceNode*>(b)->getValue())
+                return false;
+              continue;
+
+            case triton::ast::STRING_NODE:
+              if (static_cast<triton::ast::StringNode*>(a)->getValue() != static_cast<triton::ast::StringNode*>(b)->getValue())
+                return false;
+              continue;
+
+            case triton::ast::VARIABLE_NODE:
+              if (static_cast<triton::ast::VariableNode*>(a)->getValue() != static_cast<triton::ast::VariableNode*>(b)->getValue())
+                return false;
+              continue;
+
+            default:
+              break;
+          }
+
+          const triton::ast::AstChilds& childs1 = a->getChilds();
+          const triton::ast::AstChilds& childs2 = b->getChilds();
+          if (childs1.size() != childs2.size())
+            return false;
+
+          for (triton::usize index = 0; index < childs1.size(); index++)
+            worklist.push_back(std::make_pair(childs1[index], childs2[index]));
+        }
+
+        return true;
+      }
+
+
+      /*
+       * The hash of a query only selects the candidates, an answer is returned
+       * if the query has the same structure and if the symbolic expressions it
+       * references still have the ASTs they had when it has been answered.
+       */
+      bool SolverEngine::isSameQuery(const SolverCacheEntry& entry, const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query) const {
+        if (entry.query.size() != query.size())
+          return false;
+
+        for (auto it = entry.references.begin(); it != entry.references.end(); it++) {
+          if (!triton::api.isSymbolicExpressionIdExists(it->first) || triton::api.getAstFromId(it->first) != it->second)
+            return false;
+        }
+
+        for (triton::usize index = 0; index < query.size(); index++) {
+          if (entry.query[index].second != query[index].second)
+            return false;
+          if (!this->isSameQueryNode(entry.query[index].first, query[index].first))
+            return false;
+        }
+
+        return true;
+      }
+
+
+      /* Collects the symbolic variables of a query, references included */
+      static void collectQueryVariables(const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query, std::map<triton::uint32, triton::engines::symbolic::SymbolicVariable*>& variables) {
+        std::vector<triton::ast::AbstractNode*> worklist;
+        std::set<triton::ast::AbstractNode*> visited;
+
+        for (triton::usize index = 0; index < query.size(); index++)
+          worklist.push_back(query[index].first);
+
+        while (!worklist.empty()) {
+          triton::ast::AbstractNode* node = worklist.back();
+          worklist.pop_back();
+
+          if (node->isSymbolized() == false || visited.insert(node).second == false)
+            continue;
+
+          switch (node->getKind()) {
+            case triton::ast::VARIABLE_NODE: {
+              triton::engines::symbolic::SymbolicVariable* symVar = triton::api.getSymbolicVariableFromName(reinterpret_cast<triton::ast::VariableNode*>(node)->getValue());
+              variables[symVar->getId()] = symVar;
+              break;
+            }
+
+            case triton::ast::REFERENCE_NODE:
+              worklist.push_back(triton::api.getAstFromId(reinterpret_cast<triton::ast::ReferenceNode*>(node)->getValue()));
+              break;
+
+            default:
+              for (triton::uint32 index = 0; index < node->getChilds().size(); index++)
+                worklist.push_back(node->getChilds()[index]);
+              break;
+          }
+        }
+      }
+
+
+      bool SolverEngine::lookupQueryCache(triton::uint64 hash, const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query, std::map<triton::uint32, SolverModel>& model, triton::engines::solver::status_e& status) {
+        std::vector<std::pair<triton::ast::AbstractNode*, bool>> normalized = this->normalizeQuery(query);
+        auto range = this->queryCache.equal_range(hash);
+
+        /* Same query */
+        for (auto it = range.first; it != range.second; it++) {
+          if (!this->isSameQuery(*it->second, normalized))
+            continue;
+          this->cacheHits++;
+          this->cacheEntries.splice(this->cacheEntries.begin(), this->cacheEntries, it->second);
+          status = it->second->status;
+          model  = it->second->model;
+          return true;
+        }
+
+        /* Counterexample reuse, a recent model may satisfy the new query as well */
+        for (auto m = this->recentModels.begin(); m != this->recentModels.end(); m++) {
+          std::map<triton::usize, triton::uint512> assignment;
+          std::map<triton::ast::AbstractNode*, triton::uint512> values;
+          bool satisfied = true;
+
+          for (auto v = m->begin(); v != m->end(); v++)
+            assignment[v->first] = v->second.getValue();
+
+          try {
+            for (triton::usize index = 0; index < query.size() && satisfied; index++)
+              satisfied = ((triton::ast::evaluateWithModel(query[index].first, assignment, values) != 0) == query[index].second);
+          }
+          catch (const std::exception&) {
+            satisfied = false;
+          }
+
+          if (satisfied) {
+            std::map<triton::uint32, triton::engines::symbolic::SymbolicVariable*> variables;
+
+            /* The model was found for another query, the variables it does not assign were evaluated with their concrete value */
+            model = *m;
+            collectQueryVariables(query, variables);
+            for (auto v = variables.begin(); v != variables.end(); v++) {
+              if (model.find(v->first) == model.end())
+                model[v->first] = SolverModel(v->second->getName(), v->first, v->second->getConcreteValue());
+            }
+
+            this->cacheModelHits++;
+            status = triton::engines::solver::SAT;
+            this->insertQueryCache(hash, query, model, status);
+            return true;
+          }
+        }
+
+        this->cacheMisses++;
+        return false;
+      }
+
+
+      void SolverEngine::recordQueryCache(triton::uint64 hash, const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query, const std::map<triton::uint32, SolverModel>& model, triton::engines::solver::status_e status) {
+        /* A query stopped by a limit may be answered next time */
+        if (status != triton::engines::solver::SAT && status != triton::engines::solver::UNSAT)
+          return;
+
+        this->insertQueryCache(hash, query, model, status);
+
+        if (model.empty())
+          return;
+
+        this->recentModels.push_front(model);
+        if (this->recentModels.size() > SOLVER_CACHE_MODELS)
+          this->recentModels.pop_back();
+      }
+
+
+      void SolverEngine::insertQueryCache(triton::uint64 hash, const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query, const std::map<triton::uint32, SolverModel>& model, triton::engines::solver::status_e status) {
+        std::vector<triton::ast::AbstractNode*> worklist;
+        std::set<triton::ast::AbstractNode*> visited;
+        SolverCacheEntry entry;
+
+        entry.hash   = hash;
+        entry.query  = this->normalizeQuery(query);
+        entry.status = status;
+        entry.model  = model;
+
+        /* Remember the ASTs the references stand for, an expression may be given another AST later (see SymbolicExpression::setAst()) */
+        for (triton::usize index = 0; index < entry.query.size(); index++)
+          worklist.push_back(entry.query[index].first);
+
+        while (!worklist.empty()) {
+          triton::ast::AbstractNode* node = worklist.back();
+
+          worklist.pop_back();
+          if (!visited.insert(node).second)
+            continue;
+
+          if (node->getKind() == triton::ast::REFERENCE_NODE) {
+            triton::usize id = static_cast<triton::ast::ReferenceNode*>(node)->getValue();
+            if (triton::api.isSymbolicExpressionIdExists(id)) {
+              triton::ast::AbstractNode* ast = triton::api.getAstFromId(id);
+              entry.references[id] = ast;
+              worklist.push_back(ast);
+            }
+          }
+
+          const triton::ast::AstChilds& childs = node->getChilds();
+          for (triton::usize index = 0; index < childs.size(); index++)
+            worklist.push_back(childs[index]);
+        }
+
+        /* The nodes are compared with the next queries, they must survive the collections */
+        for (triton::usize index = 0; index < entry.query.size(); index++)
+          triton::api.pinAstNode(entry.query[index].first);
+        for (auto it = entry.references.begin(); it != entry.references.end(); it++)
+          triton::api.pinAstNode(it->second);
+
+        this->cacheEntries.push_front(entry);
+        this->queryCache.insert(std::make_pair(hash, this->cacheEntries.begin()));
+
+        if (this->cacheEntries.size() > SOLVER_CACHE_ENTRIES)
+          this->evictQueryCache(std::prev(this->cacheEntries.end()));
+      }
+
+
+      void SolverEngine::evictQueryCache(std::list<SolverCacheEntry>::iterator entry) {
+        auto range = this->queryCache.equal_range(entry->hash);
+
+        for (auto it = range.first; it != range.second; it++) {
+          if (it->second == entry) {
+            this->queryCache.erase(it);
+            break;
+          }
+        }
+
+        for (triton::usize index = 0; index < entry->query.size(); index++)
+          triton::api.unpinAstNode(entry->query[index].first);
+        for (auto it = entry->references.begin(); it != entry->references.end(); it++)
+          triton::api.unpinAstNode(it->second);
+
+        this->cacheEntries.erase(entry);
       }
 
 
-      std::list<std::map<triton::uint32, SolverModel>> SolverEngine::getModels(triton::ast::AbstractNode *node, triton::uint32 limit) const {
-        std::list<std::map<triton::uint32, SolverModel>>  ret;
-        std::stringstream                                 formula;
-        z3::context                                       ctx;
-        z3::solver                                        solver(ctx);
-        triton::uint32                                    representationMode = triton::api.getAstRepresentationMode();
+      std::map<std::string, triton::usize> SolverEngine::getQueryCacheStats(void) const {
+        std::map<std::string, triton::usize> stats;
+
+        stats["entries"]    = this->cacheEntries.size();
+        stats["hits"]       = this->cacheHits;
+        stats["modelHits"]  = this->cacheModelHits;
+        stats["misses"]     = this->cacheMisses;
+
+        return stats;
+      }
+
+
+      void SolverEngine::clearQueryCache(void) {
+        while (!this->cacheEntries.empty())
+          this->evictQueryCache(this->cacheEntries.begin());
+        this->recentModels.clear();
+        this->cacheHits       = 0;
+        this->cacheModelHits  = 0;
+        this->cacheMisses     = 0;
+      }
+
+
+      std::map<triton::uint32, SolverModel> SolverEngine::extractModel(z3::model& model, const triton::ast::TritonToZ3Ast& converter, z3::expr_vector& blocking, const std::set<triton::usize>* projection) const {
+        std::map<triton::uint32, SolverModel> ret;
+        z3::context& ctx = blocking.ctx();
+
+        /* Traversing the symbolic variables of the expression */
+        for (auto it = converter.getVariables().begin(); it != converter.getVariables().end(); it++) {
+          const z3::expr& variable = it->second;
+          z3::expr exp             = model.eval(variable, false);
+
+          /* The variable has no interpretation in this model */
+          if (!exp.is_numeral())
+            continue;
+
+          triton::engines::symbolic::SymbolicVariable* symVar = triton::api.getSymbolicVariableFromId(it->first);
+          triton::uint512 value = 0;
+          triton::uint64 narrow = 0;
+
+          if (Z3_get_numeral_uint64(ctx, exp, &narrow))
+            value = narrow;
+          else
+            value = triton::uint512{Z3_get_numeral_string(ctx, exp)};
+
+          SolverModel trionModel{symVar->getName(), static_cast<triton::uint32>(symVar->getId()), value};
+          ret[trionModel.getId()] = trionModel;
+
+          if (projection == nullptr || projection->find(it->first) != projection->end())
+            blocking.push_back(variable != exp);
+        }
+
+        return ret;
+      }
+
+
+      std::list<std::map<triton::uint32, SolverModel>> SolverEngine::getModels(triton::ast::AbstractNode *node, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout) {
+        std::list<std::map<triton::uint32, SolverModel>> ret;
 
         if (node == nullptr)
           throw std::runtime_error("SolverEngine::getModels(): node cannot be null.");
 
-        /* Switch into the SMT mode */
-        triton::api.setAstRepresentationMode(triton::ast::representations::SMT_REPRESENTATION);
+        if (limit == 0) {
+          if (status)
+            *status = triton::engines::solver::UNKNOWN;
+          return ret;
+        }
 
-        /* First, set the QF_AUFBV flag  */
-        formula << "(set-logic QF_AUFBV)";
+        this->enumerateModels(node, std::set<triton::usize>(), [&](const std::map<triton::uint32, SolverModel>& model) {
+          if (model.size() > 0)
+            ret.push_back(model);
+          return true;
+        }, limit, status, timeout);
+
+        return ret;
+      }
 
-        /* Then, delcare all symbolic variables */
-        formula << triton::api.getVariablesDeclaration();
 
-        /* And concat the user expression */
-        formula << triton::api.getFullAst(node);
+      /*
+       * The models are enumerated in the same solver, each one only adds its
+       * blocking clause. The clause only speaks about the projected
+       * variables, so the solver has to find a new assignment of them.
+       */
+      triton::usize SolverEngine::enumerateModels(triton::ast::AbstractNode *node, const std::set<triton::usize>& variables, const std::function<bool(const std::map<triton::uint32, SolverModel>&)>& callback, triton::uint32 limit, triton::engines::solver::status_e* status, triton::uint32 timeout) {
+        triton::ast::TritonToZ3Ast                        z3Ast{false};
+        triton::engines::solver::status_e                 st = triton::engines::solver::UNKNOWN;
+        triton::usize                                     count = 0;
 
-        /* Create the context and AST */
-        Z3_ast ast = Z3_parse_smtlib2_string(ctx, formula.str().c_str(), 0, 0, 0, 0, 0, 0);
-        z3::expr eq(ctx, ast);
+        if (node == nullptr)
+          throw std::runtime_error("SolverEngine::enumerateModels(): node cannot be null.");
 
-        /* Create a solver and add the expression */
-        solver.add(eq);
+        /* Convert the Triton AST directly into a Z3 expression, references are followed by the converter */
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        triton::ast::Z3Result& result = z3Ast.eval(*node);
+        triton::uint64 translationTime = elapsedSince(start);
+        z3::context& ctx              = result.getContext();
+        z3::solver solver(ctx);
+
+        /* Add the expression */
+        this->setLimits(solver, timeout);
+        solver.add(result.getExpr());
 
         /* Check if it is sat */
-        while (solver.check() == z3::sat && limit >= 1) {
+        start = std::chrono::steady_clock::now();
+        while ((st = this->check(solver)) == triton::engines::solver::SAT) {
 
           /* Get model */
           z3::model m = solver.get_model();
-
-          /* Traversing the model */
-          std::map<triton::uint32, SolverModel> smodel;
           z3::expr_vector args(ctx);
-          for (triton::uint32 i = 0; i < m.size(); i++) {
+          std::map<triton::uint32, SolverModel> smodel = this->extractModel(m, z3Ast, args, (variables.empty() ? nullptr : &variables));
+          count++;
+
+          /* The caller may stop the enumeration */
+          if (callback(smodel) == false || count == limit)
+            break;
+
+          /* No projected variable is constrained, every other model is the same */
+          if (args.size() == 0)
+            break;
+
+          /* Escape last models */
+          solver.add(triton::engines::solver::mk_or(args));
+        }
+
+        this->recordQueryStats(node->getHash(), z3Ast.getNumberOfConvertedNodes(), z3Ast.getVariables().size(), translationTime, elapsedSince(start), st);
 
-            z3::func_decl variable  = m[i];
-            std::string varName     = variable.name().str();
-            z3::expr exp            = m.get_const_interp(variable);
-            triton::uint32 bvSize   = exp.get_sort().bv_size();
-            std::string svalue      = Z3_get_numeral_string(ctx, exp);
+        if (status)
+          *status = st;
+
+        return count;
+      }
 
-            triton::uint512         value{svalue};
-            SolverModel             trionModel{varName, value};
-            smodel[trionModel.getId()] = trionModel;
 
-            if (exp.get_sort().is_bv())
-              args.push_back(ctx.bv_const(varName.c_str(), bvSize) != ctx.bv_val(svalue.c_str(), bvSize));
+      /*
+       * Keeps the incremental session in sync with the path constraints of
+       * the symbolic engine. Each path constraint lives in its own solver
+       * scope, so only the scopes which are no longer a prefix of the path
+       * are popped. If nothing is kept, the session starts again from a
+       * fresh context to drop the translations of the previous path.
+       */
+      void SolverEngine::syncSession(triton::usize depth) {
+        const std::vector<triton::engines::symbolic::PathConstraint>& pathConstraints = triton::api.getPathConstraints();
+        triton::usize kept = 0;
+
+        if (depth > pathConstraints.size())
+          throw std::runtime_error("SolverEngine::syncSession(): Invalid path constraint index.");
+
+        while (kept < this->sessionConstraints.size() && kept < depth) {
+          triton::ast::AbstractNode* pc = pathConstraints[kept].getTakenPathConstraintAst();
+          if (this->sessionConstraints[kept].first != pc || this->sessionConstraints[kept].second != pc->getHash())
+            break;
+          kept++;
+        }
+
+        if (kept == 0 && !this->sessionConstraints.empty()) {
+          delete this->sessionSolver;
+          delete this->session;
+          this->sessionSolver = nullptr;
+          this->session       = nullptr;
+          this->sessionConstraints.clear();
+        }
 
+        if (this->session == nullptr) {
+          this->session       = new triton::ast::TritonToZ3Ast(false);
+          this->sessionSolver = new z3::solver(this->session->getContext());
+        }
+
+        if (kept < this->sessionConstraints.size()) {
+          this->sessionSolver->pop(static_cast<triton::uint32>(this->sessionConstraints.size() - kept));
+          this->sessionConstraints.resize(kept);
+        }
+
+        for (triton::usize index = kept; index < depth; index++) {
+          triton::ast::AbstractNode* pc = pathConstraints[index].getTakenPathConstraintAst();
+          this->sessionSolver->push();
+          this->sessionSolver->add(this->session->convert(pc));
+          this->sessionConstraints.push_back(std::make_pair(pc, pc->getHash()));
+        }
+      }
+
+
+      /*
+       * The conversion of the queries needs the symbolic engine, so it is
+       * done by the caller. Only the checks run on the worker threads, each
+       * query owns its Z3 context so they do not share any state.
+       */
+      std::vector<std::map<triton::uint32, SolverModel>> SolverEngine::getModels(const std::vector<triton::ast::AbstractNode*>& nodes, std::vector<triton::engines::solver::status_e>* status, triton::uint32 timeout) {
+        std::vector<std::map<triton::uint32, SolverModel>> ret(nodes.size());
+        std::vector<triton::engines::solver::status_e> st(nodes.size(), triton::engines::solver::UNKNOWN);
+        std::vector<triton::ast::TritonToZ3Ast*> converters;
+        std::vector<z3::solver*> solvers;
+        std::map<triton::ast::AbstractNode*, triton::usize> distinct;
+        std::vector<triton::usize> pending;
+        std::vector<triton::uint64> hashes(nodes.size(), 0);
+        std::vector<triton::uint64> translationTimes;
+        std::vector<triton::uint64> solveTimes;
+        std::vector<std::thread> workers;
+
+        bool cached = triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::SOLVER_QUERY_CACHE);
+
+        for (triton::usize index = 0; index < nodes.size(); index++) {
+          if (nodes[index] == nullptr)
+            throw std::runtime_error("SolverEngine::getModels(): node cannot be null.");
+
+          /* The same constraint is only solved once */
+          if (distinct.find(nodes[index]) != distinct.end())
+            continue;
+          distinct[nodes[index]] = index;
+
+          /* Look for a previous answer */
+          if (cached) {
+            std::vector<std::pair<triton::ast::AbstractNode*, bool>> query(1, std::make_pair(nodes[index], true));
+            hashes[index] = this->getQueryHash(query);
+            if (this->lookupQueryCache(hashes[index], query, ret[index], st[index]))
+              continue;
           }
 
-          /* Escape last models */
-          solver.add(triton::engines::solver::mk_or(args));
+          pending.push_back(index);
+        }
+
+        try {
+          /* One query per worker at a time, so a large batch never keeps more Z3 contexts alive than there are workers */
+          for (triton::usize first = 0; first < pending.size(); first += this->threads) {
+            triton::usize count = std::min<triton::usize>(this->threads, pending.size() - first);
+
+            /* Convert each query of the chunk into its own context */
+            translationTimes.assign(count, 0);
+            solveTimes.assign(count, 0);
+            for (triton::usize i = 0; i < count; i++) {
+              std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+              converters.push_back(new triton::ast::TritonToZ3Ast(false));
+              solvers.push_back(new z3::solver(converters.back()->getContext()));
+              this->setLimits(*solvers.back(), timeout);
+              solvers.back()->add(converters.back()->convert(nodes[pending[first + i]]));
+              translationTimes[i] = elapsedSince(start);
+            }
+
+            /* Solve them in parallel */
+            for (triton::usize i = 0; i < count; i++) {
+              workers.push_back(std::thread([&, i]() {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+                st[pending[first + i]] = this->check(*solvers[i]);
+                solveTimes[i] = elapsedSince(start);
+              }));
+            }
+
+            for (triton::usize i = 0; i < workers.size(); i++)
+              workers[i].join();
+            workers.clear();
+
+            /* Extract the models */
+            for (triton::usize i = 0; i < count; i++) {
+              triton::usize index = pending[first + i];
+              if (st[index] == triton::engines::solver::SAT) {
+                z3::model m = solvers[i]->get_model();
+                z3::expr_vector args(converters[i]->getContext());
+                ret[index] = this->extractModel(m, *converters[i], args);
+              }
+              if (cached) {
+                std::vector<std::pair<triton::ast::AbstractNode*, bool>> query(1, std::make_pair(nodes[index], true));
+                this->recordQueryCache(hashes[index], query, ret[index], st[index]);
+              }
+              this->recordQueryStats(nodes[index]->getHash(), converters[i]->getNumberOfConvertedNodes(), converters[i]->getVariables().size(), translationTimes[i], solveTimes[i], st[index]);
+            }
+
+            /* Free the contexts of the chunk before converting the next one */
+            releaseSolvers(solvers, converters);
+          }
+        }
+        catch (...) {
+          for (triton::usize i = 0; i < workers.size(); i++) {
+            if (workers[i].joinable())
+              workers[i].join();
+          }
+          releaseSolvers(solvers, converters);
+          throw;
+        }
+
+        /* Copy the answers of the duplicated constraints */
+        for (triton::usize index = 0; index < nodes.size(); index++) {
+          ret[index] = ret[distinct[nodes[index]]];
+          st[index]  = st[distinct[nodes[index]]];
+        }
+
+        if (status)
+          *status = st;
+
+        return ret;
+      }
+
+
+      triton::uint32 SolverEngine::getThreads(void) const {
+        return this->threads;
+      }
+
+
+      void SolverEngine::setThreads(triton::uint32 threads) {
+        if (threads == 0)
+          throw std::runtime_error("SolverEngine::setThreads(): The number of threads cannot be zero.");
+        this->threads = threads;
+      }
+
 
-          /* If there is model available */
-          if (smodel.size() > 0)
-            ret.push_back(smodel);
+      std::map<triton::uint32, SolverModel> SolverEngine::getNegatedBranchModel(triton::usize index, triton::engines::solver::status_e* status, triton::uint32 timeout) {
+        const std::vector<triton::engines::symbolic::PathConstraint>& pathConstraints = triton::api.getPathConstraints();
+        std::vector<std::pair<triton::ast::AbstractNode*, bool>> query;
+        std::map<triton::uint32, SolverModel> ret;
+        std::vector<triton::usize> prefix;
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+        triton::uint64 translationTime = 0;
+        triton::uint64 solveTime = 0;
+        triton::usize nodes = 0;
+        triton::usize variables = 0;
+        triton::uint64 hash = 0;
+
+        if (index >= pathConstraints.size())
+          throw std::runtime_error("SolverEngine::getNegatedBranchModel(): Invalid path constraint index.");
+
+        triton::ast::AbstractNode* pc = pathConstraints[index].getTakenPathConstraintAst();
+
+        /* Only keep the path constraints which depend on the same variables as the branch */
+        bool sliced = triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::PC_INDEPENDENCE);
+        if (sliced)
+          prefix = triton::api.getRelevantPathConstraints(pc, index);
+
+        /* Look for a previous answer */
+        bool cached = triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::SOLVER_QUERY_CACHE);
+        if (cached) {
+          if (sliced) {
+            for (triton::usize i = 0; i < prefix.size(); i++)
+              query.push_back(std::make_pair(pathConstraints[prefix[i]].getTakenPathConstraintAst(), true));
+          }
+          else {
+            for (triton::usize i = 0; i < index; i++)
+              query.push_back(std::make_pair(pathConstraints[i].getTakenPathConstraintAst(), true));
+          }
+          query.push_back(std::make_pair(pc, false));
+          hash = this->getQueryHash(query);
+          if (this->lookupQueryCache(hash, query, ret, st)) {
+            if (status)
+              *status = st;
+            return ret;
+          }
+        }
+
+        /* A slice is solved on its own, the incremental session keeps the whole prefix */
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        if (sliced) {
+          triton::ast::TritonToZ3Ast z3Ast{false};
+          z3::solver solver(z3Ast.getContext());
+
+          this->setLimits(solver, timeout);
+          for (triton::usize i = 0; i < prefix.size(); i++)
+            solver.add(z3Ast.convert(pathConstraints[prefix[i]].getTakenPathConstraintAst()));
+          solver.add(!z3Ast.convert(pc));
+          translationTime = elapsedSince(start);
+
+          start = std::chrono::steady_clock::now();
+          st = this->check(solver);
+          solveTime = elapsedSince(start);
+
+          if (st == triton::engines::solver::SAT) {
+            z3::model m = solver.get_model();
+            z3::expr_vector args(z3Ast.getContext());
+            ret = this->extractModel(m, z3Ast, args);
+          }
+
+          nodes     = z3Ast.getNumberOfConvertedNodes();
+          variables = z3Ast.getVariables().size();
+        }
+
+        else {
+          /* Assert the prefix */
+          this->syncSession(index);
+
+          /* Then, ask for another branch in a temporary scope */
+          this->setLimits(*this->sessionSolver, timeout);
+          this->sessionSolver->push();
+          this->sessionSolver->add(!this->session->convert(pc));
+          translationTime = elapsedSince(start);
+
+          start = std::chrono::steady_clock::now();
+          st = this->check(*this->sessionSolver);
+          solveTime = elapsedSince(start);
+
+          if (st == triton::engines::solver::SAT) {
+            z3::model m = this->sessionSolver->get_model();
+            z3::expr_vector args(this->session->getContext());
+            ret = this->extractModel(m, *this->session, args);
+          }
+
+          this->sessionSolver->pop();
 
-          /* Decrement the limit */
-          limit--;
+          nodes     = this->session->getNumberOfConvertedNodes();
+          variables = this->session->getVariables().size();
         }
 
-        /* Restore the representation mode */
-        triton::api.setAstRepresentationMode(representationMode);
+        if (cached)
+          this->recordQueryCache(hash, query, ret, st);
+
+        this->recordQueryStats((cached ? hash : pc->getHash()), nodes, variables, translationTime, solveTime, st);
+
+        if (status)
+          *status = st;
+
+        return ret;
+      }
+
+
+      std::vector<std::map<triton::uint32, SolverModel>> SolverEngine::getNegatedBranchesModels(void) {
+        std::vector<std::map<triton::uint32, SolverModel>> ret;
+        triton::usize size = triton::api.getPathConstraints().size();
+
+        /* Each query only adds one path constraint to the session built by the previous one */
+        for (triton::usize index = 0; index < size; index++)
+          ret.push_back(this->getNegatedBranchModel(index));
 
         return ret;
       }
 
 
-      std::map<triton::uint32, SolverModel> SolverEngine::getModel(triton::ast::AbstractNode *node) const {
+      std::map<triton::uint32, SolverModel> SolverEngine::getModel(triton::ast::AbstractNode *node, triton::engines::solver::status_e* status, triton::uint32 timeout) {
         std::map<triton::uint32, SolverModel> ret;
         std::list<std::map<triton::uint32, SolverModel>> allModels;
+        std::vector<std::pair<triton::ast::AbstractNode*, bool>> query;
+        triton::engines::solver::status_e st = triton::engines::solver::UNKNOWN;
+        triton::uint64 hash = 0;
 
-        allModels = this->getModels(node, 1);
+        if (node == nullptr)
+          throw std::runtime_error("SolverEngine::getModel(): node cannot be null.");
+
+        /* Drop the path constraints which do not share variables with the rest of the query */
+        if (triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::PC_INDEPENDENCE))
+          node = triton::api.sliceQueryAst(node);
+
+        /* Look for a previous answer */
+        bool cached = triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::SOLVER_QUERY_CACHE);
+        if (cached) {
+          query.push_back(std::make_pair(node, true));
+          hash = this->getQueryHash(query);
+          if (this->lookupQueryCache(hash, query, ret, st)) {
+            if (status)
+              *status = st;
+            return ret;
+          }
+        }
+
+        allModels = this->getModels(node, 1, &st, timeout);
         if (allModels.size() > 0)
           ret = allModels.front();
 
+        if (cached)
+          this->recordQueryCache(hash, query, ret, st);
+
+        if (status)
+          *status = st;
+
         return ret;
       }
 
@@ -203,7 +998,7 @@ namespace triton {
         if (node == nullptr)
           throw std::runtime_error("SolverEngine::evaluateAstViaZ3(): node cannot be null.");
         triton::ast::TritonToZ3Ast z3ast{};
-        triton::ast::Z3Result result = z3ast.eval(*node);
+        triton::ast::Z3Result& result = z3ast.eval(*node);
         triton::uint512 nbResult{result.getStringValue()};
         return nbResult;
       }
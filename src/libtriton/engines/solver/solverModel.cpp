@@ -30,6 +30,13 @@ namespace triton {
       }
 
 
+      SolverModel::SolverModel(const std::string& name, triton::uint32 id, triton::uint512 value) {
+        this->name  = name;
+        this->id    = id;
+        this->value = value;
+      }
+
+
       SolverModel::SolverModel(const SolverModel& other) {
         this->copy(other);
       }
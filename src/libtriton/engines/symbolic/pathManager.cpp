@@ -5,6 +5,8 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
+#include <map>
 #include <stdexcept>
 
 #include <api.hpp>
@@ -18,10 +20,14 @@ namespace triton {
     namespace symbolic {
 
       PathManager::PathManager() {
+        this->pathConstraintsSnapshot     = false;
+        this->snapshotPathConstraintsSize = 0;
       }
 
 
       PathManager::PathManager(const PathManager& copy) {
+        this->pathConstraintsSnapshot     = false;
+        this->snapshotPathConstraintsSize = 0;
         this->copy(copy);
       }
 
@@ -31,7 +37,206 @@ namespace triton {
 
 
       void PathManager::copy(const PathManager& other) {
-        this->pathConstraints = other.pathConstraints;
+        this->pathConstraints          = other.pathConstraints;
+        this->pathConstraintsVariables = other.pathConstraintsVariables;
+        this->pathConstraintsIndexes   = other.pathConstraintsIndexes;
+      }
+
+
+      /* Collects the symbolic variable ids of an AST, references included */
+      static void collectSymbolicVariables(triton::ast::AbstractNode* root, std::set<triton::usize>& variables) {
+        std::vector<triton::ast::AbstractNode*> worklist;
+        std::set<triton::ast::AbstractNode*> visited;
+
+        worklist.push_back(root);
+        while (!worklist.empty()) {
+          triton::ast::AbstractNode* node = worklist.back();
+          worklist.pop_back();
+
+          if (node->isSymbolized() == false || visited.insert(node).second == false)
+            continue;
+
+          switch (node->getKind()) {
+            case triton::ast::VARIABLE_NODE: {
+              const std::string& name = reinterpret_cast<triton::ast::VariableNode*>(node)->getValue();
+              variables.insert(triton::api.getSymbolicVariableFromName(name)->getId());
+              break;
+            }
+
+            case triton::ast::REFERENCE_NODE:
+              worklist.push_back(triton::api.getAstFromId(reinterpret_cast<triton::ast::ReferenceNode*>(node)->getValue()));
+              break;
+
+            default:
+              for (triton::uint32 index = 0; index < node->getChilds().size(); index++)
+                worklist.push_back(node->getChilds()[index]);
+              break;
+          }
+        }
+      }
+
+
+      const std::set<triton::usize>& PathManager::getPathConstraintVariables(triton::usize index) {
+        while (this->pathConstraintsVariables.size() <= index) {
+          triton::usize next = this->pathConstraintsVariables.size();
+          this->pathConstraintsVariables.push_back(std::set<triton::usize>());
+          collectSymbolicVariables(this->pathConstraints[next].getTakenPathConstraintAst(), this->pathConstraintsVariables.back());
+        }
+        return this->pathConstraintsVariables[index];
+      }
+
+
+      /* Returns the representative of a symbolic variable in a union-find, with path halving */
+      static triton::usize findVariable(std::map<triton::usize, triton::usize>& parents, triton::usize id) {
+        std::map<triton::usize, triton::usize>::iterator it = parents.find(id);
+
+        if (it == parents.end()) {
+          parents[id] = id;
+          return id;
+        }
+
+        while (parents[id] != id) {
+          parents[id] = parents[parents[id]];
+          id = parents[id];
+        }
+
+        return id;
+      }
+
+
+      /* Merges the components of a set of symbolic variables */
+      static void unionVariables(std::map<triton::usize, triton::usize>& parents, const std::set<triton::usize>& variables) {
+        if (variables.empty())
+          return;
+
+        triton::usize root = findVariable(parents, *variables.begin());
+        for (std::set<triton::usize>::const_iterator it = variables.begin(); it != variables.end(); it++)
+          parents[findVariable(parents, *it)] = root;
+      }
+
+
+      /*
+       * Constraint independence: the variables of each path constraint are
+       * merged in a union-find, in one pass over the path constraints. The
+       * relevant ones are in the component of the variables of the node, the
+       * others do not share any variable with it, so the concrete values of
+       * their variables still satisfy them.
+       */
+      std::vector<triton::usize> PathManager::getRelevantPathConstraints(triton::ast::AbstractNode* node, triton::usize limit) {
+        std::map<triton::usize, triton::usize> parents;
+        std::vector<triton::usize> ret;
+        std::set<triton::usize> variables;
+
+        if (node == nullptr)
+          throw std::runtime_error("PathManager::getRelevantPathConstraints(): The node cannot be null.");
+
+        if (limit > this->pathConstraints.size())
+          throw std::runtime_error("PathManager::getRelevantPathConstraints(): Invalid path constraint index.");
+
+        collectSymbolicVariables(node, variables);
+        if (variables.empty())
+          return ret;
+
+        unionVariables(parents, variables);
+        for (triton::usize index = 0; index < limit; index++)
+          unionVariables(parents, this->getPathConstraintVariables(index));
+
+        /* All variables of a path constraint are in the same component */
+        triton::usize root = findVariable(parents, *variables.begin());
+        for (triton::usize index = 0; index < limit; index++) {
+          const std::set<triton::usize>& pcVariables = this->getPathConstraintVariables(index);
+          if (!pcVariables.empty() && findVariable(parents, *pcVariables.begin()) == root)
+            ret.push_back(index);
+        }
+
+        return ret;
+      }
+
+
+      /*
+       * The taken path constraints of the conjunction are satisfied by the
+       * concrete values, so only the ones in the component of the rest of
+       * the query are kept. The query is returned as is if there is nothing
+       * to drop.
+       */
+      triton::ast::AbstractNode* PathManager::sliceQueryAst(triton::ast::AbstractNode* node) {
+        std::map<triton::usize, triton::usize> parents;
+        std::vector<triton::ast::AbstractNode*> worklist;
+        std::vector<triton::ast::AbstractNode*> others;
+        std::vector<triton::usize> pcs;
+        std::vector<triton::usize> kept;
+        std::set<triton::usize> variables;
+        triton::ast::AbstractNode* ret = nullptr;
+
+        if (node == nullptr)
+          throw std::runtime_error("PathManager::sliceQueryAst(): The node cannot be null.");
+
+        /* Split the conjunction into path constraints and the rest of the query */
+        worklist.push_back((node->getKind() == triton::ast::ASSERT_NODE) ? node->getChilds()[0] : node);
+        while (!worklist.empty()) {
+          triton::ast::AbstractNode* conjunct = worklist.back();
+          worklist.pop_back();
+
+          if (conjunct->getKind() == triton::ast::LAND_NODE) {
+            for (triton::usize index = conjunct->getChilds().size(); index > 0; index--)
+              worklist.push_back(conjunct->getChilds()[index - 1]);
+            continue;
+          }
+
+          std::map<triton::ast::AbstractNode*, triton::usize>::const_iterator it = this->pathConstraintsIndexes.find(conjunct);
+          if (it != this->pathConstraintsIndexes.end())
+            pcs.push_back(it->second);
+          else
+            others.push_back(conjunct);
+        }
+
+        for (triton::usize index = 0; index < others.size(); index++)
+          collectSymbolicVariables(others[index], variables);
+
+        /* Without a target, the path constraints are the question */
+        if (pcs.empty() || variables.empty())
+          return node;
+
+        unionVariables(parents, variables);
+        for (triton::usize index = 0; index < pcs.size(); index++)
+          unionVariables(parents, this->getPathConstraintVariables(pcs[index]));
+
+        triton::usize root = findVariable(parents, *variables.begin());
+        for (triton::usize index = 0; index < pcs.size(); index++) {
+          const std::set<triton::usize>& pcVariables = this->getPathConstraintVariables(pcs[index]);
+          if (!pcVariables.empty() && findVariable(parents, *pcVariables.begin()) == root)
+            kept.push_back(pcs[index]);
+        }
+
+        if (kept.size() == pcs.size())
+          return node;
+
+        for (triton::usize index = 0; index < others.size(); index++)
+          ret = (ret == nullptr) ? others[index] : triton::ast::land(ret, others[index]);
+
+        for (triton::usize index = 0; index < kept.size(); index++)
+          ret = triton::ast::land(ret, this->pathConstraints[kept[index]].getTakenPathConstraintAst());
+
+        if (node->getKind() == triton::ast::ASSERT_NODE)
+          ret = triton::ast::assert_(ret);
+
+        return ret;
+      }
+
+
+      triton::ast::AbstractNode* PathManager::getRelevantPathConstraintsAst(triton::ast::AbstractNode* node) {
+        std::vector<triton::usize> indexes = this->getRelevantPathConstraints(node, this->pathConstraints.size());
+
+        /* by default PC is T (top) */
+        triton::ast::AbstractNode* ret = triton::ast::equal(
+                                           triton::ast::bvtrue(),
+                                           triton::ast::bvtrue()
+                                         );
+
+        for (triton::usize index = 0; index < indexes.size(); index++)
+          ret = triton::ast::land(ret, this->pathConstraints[indexes[index]].getTakenPathConstraintAst());
+
+        return ret;
       }
 
 
@@ -110,21 +315,68 @@ namespace triton {
 
           pco.addBranchConstraint(bb1 == dstAddr, srcAddr, bb1, bb1pc);
           pco.addBranchConstraint(bb2 == dstAddr, srcAddr, bb2, bb2pc);
-
-          this->pathConstraints.push_back(pco);
         }
 
         /* Direct branch */
         else {
           pco.addBranchConstraint(true, srcAddr, dstAddr, triton::ast::equal(pc, triton::ast::bv(dstAddr, size)));
-          this->pathConstraints.push_back(pco);
         }
 
+        this->pathConstraintsIndexes.insert(std::make_pair(pco.getTakenPathConstraintAst(), this->pathConstraints.size()));
+        this->pathConstraints.push_back(pco);
       }
 
 
       void PathManager::clearPathConstraints(void) {
+        /* Save the path constraints of the snapshot before they are lost */
+        if (this->pathConstraintsSnapshot && this->snapshotPathConstraints.empty() && this->snapshotPathConstraintsSize) {
+          this->pathConstraints.resize(std::min(this->pathConstraints.size(), this->snapshotPathConstraintsSize));
+          this->snapshotPathConstraints.swap(this->pathConstraints);
+        }
+
         this->pathConstraints.clear();
+        this->pathConstraintsVariables.clear();
+        this->pathConstraintsIndexes.clear();
+      }
+
+
+      void PathManager::takePathConstraintsSnapshot(void) {
+        this->pathConstraintsSnapshot     = true;
+        this->snapshotPathConstraintsSize = this->pathConstraints.size();
+        this->snapshotPathConstraints.clear();
+      }
+
+
+      void PathManager::restorePathConstraintsSnapshot(void) {
+        if (!this->pathConstraintsSnapshot)
+          return;
+
+        if (!this->snapshotPathConstraints.empty()) {
+          this->pathConstraints = this->snapshotPathConstraints;
+          this->pathConstraintsVariables.clear();
+          this->pathConstraintsIndexes.clear();
+          for (triton::usize index = 0; index < this->pathConstraints.size(); index++)
+            this->pathConstraintsIndexes.insert(std::make_pair(this->pathConstraints[index].getTakenPathConstraintAst(), index));
+        }
+
+        else if (this->pathConstraints.size() > this->snapshotPathConstraintsSize) {
+          /* The index of an AST is its first path constraint, it is dropped with it */
+          for (triton::usize index = this->snapshotPathConstraintsSize; index < this->pathConstraints.size(); index++) {
+            std::map<triton::ast::AbstractNode*, triton::usize>::iterator it = this->pathConstraintsIndexes.find(this->pathConstraints[index].getTakenPathConstraintAst());
+            if (it != this->pathConstraintsIndexes.end() && it->second == index)
+              this->pathConstraintsIndexes.erase(it);
+          }
+          this->pathConstraints.resize(this->snapshotPathConstraintsSize);
+          if (this->pathConstraintsVariables.size() > this->snapshotPathConstraintsSize)
+            this->pathConstraintsVariables.resize(this->snapshotPathConstraintsSize);
+        }
+      }
+
+
+      void PathManager::disablePathConstraintsSnapshot(void) {
+        this->pathConstraintsSnapshot     = false;
+        this->snapshotPathConstraintsSize = 0;
+        this->snapshotPathConstraints.clear();
       }
 
 
@@ -5,8 +5,12 @@
 **  This program is under the terms of the BSD License.
 */
 
+#include <algorithm>
 #include <cstring>
+#include <iterator>
 #include <stdexcept>
+#include <set>
+#include <vector>
 
 #include <api.hpp>
 #include <coreUtils.hpp>
@@ -80,9 +84,15 @@ namespace triton {
         for (triton::uint32 i = 0; i < this->numberOfRegisters; i++)
           this->symbolicReg[i] = triton::engines::symbolic::UNSET;
 
-        this->enableFlag      = true;
-        this->uniqueSymExprId = 0;
-        this->uniqueSymVarId  = 0;
+        this->enableFlag           = true;
+        this->uniqueSymExprId      = 0;
+        this->uniqueSymVarId       = 0;
+        this->snapshotFlag         = false;
+        this->snapshotEnableFlag   = true;
+        this->snapshotSymExprId    = 0;
+        this->snapshotSymVarId     = 0;
+        this->eliminationSymExprId = 0;
+        this->liveAfterElimination = 0;
       }
 
 
@@ -102,6 +112,14 @@ namespace triton {
         this->symbolicVariables           = other.symbolicVariables;
         this->uniqueSymExprId             = other.uniqueSymExprId;
         this->uniqueSymVarId              = other.uniqueSymVarId;
+        this->eliminationSymExprId        = other.eliminationSymExprId;
+        this->liveAfterElimination        = other.liveAfterElimination;
+
+        /* A snapshot belongs to the engine which took it */
+        this->snapshotFlag                = false;
+        this->snapshotEnableFlag          = other.enableFlag;
+        this->snapshotSymExprId           = 0;
+        this->snapshotSymVarId            = 0;
       }
 
 
@@ -119,6 +137,7 @@ namespace triton {
         triton::engines::symbolic::SymbolicOptimization::operator=(other);
         triton::engines::symbolic::SymbolicSimplification::operator=(other);
         triton::engines::symbolic::PathManager::operator=(other);
+        this->disableSnapshot();
         delete[] this->symbolicReg;
         this->init(other);
       }
@@ -136,6 +155,14 @@ namespace triton {
         for (; it2 != this->symbolicVariables.end(); ++it2)
           delete it2->second;
 
+        /* Delete the expressions kept by the snapshot */
+        for (triton::usize index = 0; index < this->undoRemovedExpressions.size(); index++)
+          delete this->undoRemovedExpressions[index];
+
+        /* Delete the removed expressions which are still held */
+        for (std::set<SymbolicExpression*>::iterator it = this->detachedExpressions.begin(); it != this->detachedExpressions.end(); it++)
+          delete *it;
+
         /* Delete all symbolic register */
         delete[] this->symbolicReg;
       }
@@ -150,14 +177,14 @@ namespace triton {
         triton::uint32 parentId = reg.getParent().getId();
         if (!triton::api.isCpuRegisterValid(parentId))
           return;
-        this->symbolicReg[parentId] = triton::engines::symbolic::UNSET;
+        this->setSymbolicRegisterId(parentId, triton::engines::symbolic::UNSET);
       }
 
 
       /* Same as concretizeRegister but with all registers */
       void SymbolicEngine::concretizeAllRegister(void) {
         for (triton::uint32 i = 0; i < this->numberOfRegisters; i++)
-          this->symbolicReg[i] = triton::engines::symbolic::UNSET;
+          this->setSymbolicRegisterId(i, triton::engines::symbolic::UNSET);
       }
 
 
@@ -180,7 +207,7 @@ namespace triton {
        * before symbolic processing.
        */
       void SymbolicEngine::concretizeMemory(triton::uint64 addr) {
-        this->memoryReference.erase(addr);
+        this->setSymbolicMemoryId(addr, triton::engines::symbolic::UNSET);
         if (triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::ALIGNED_MEMORY))
           this->removeAlignedMemory(addr);
       }
@@ -188,58 +215,74 @@ namespace triton {
 
       /* Same as concretizeMemory but with all address memory */
       void SymbolicEngine::concretizeAllMemory(void) {
+        if (this->snapshotFlag) {
+          std::map<triton::uint64, triton::usize> references = this->memoryReference.getReferences();
+          for (auto it = references.begin(); it != references.end(); it++)
+            this->undoMemory.push_back(*it);
+          for (auto it = this->alignedMemoryReference.begin(); it != this->alignedMemoryReference.end(); it++)
+            this->undoAlignedMemory.push_back(*it);
+        }
         this->memoryReference.clear();
         this->alignedMemoryReference.clear();
       }
 
 
-      /* Remove aligned memory */
-      void SymbolicEngine::removeAlignedMemory(triton::uint64 addr) {
-        /* Remove address with several sizes */
-        this->alignedMemoryReference.erase(std::make_pair(addr,  BYTE_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr,  WORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr,  DWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr,  QWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr,  DQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr,  QQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr,  DQQWORD_SIZE));
+      /* Remove the aligned entries overlapping [addr:size] */
+      void SymbolicEngine::removeAlignedMemory(triton::uint64 addr, triton::uint32 size) {
+        std::map<triton::uint64, std::pair<triton::uint32, triton::ast::AbstractNode*>>::iterator it;
+
+        /* Entries are disjoint, only the one before addr may start below and overlap */
+        it = this->alignedMemoryReference.lower_bound(addr);
+        if (it != this->alignedMemoryReference.begin()) {
+          std::map<triton::uint64, std::pair<triton::uint32, triton::ast::AbstractNode*>>::iterator prev = std::prev(it);
+          if (addr - prev->first < prev->second.first)
+            it = prev;
+        }
+
+        while (it != this->alignedMemoryReference.end() && (it->first <= addr || it->first - addr < size)) {
+          if (this->snapshotFlag)
+            this->undoAlignedMemory.push_back(*it);
+          it = this->alignedMemoryReference.erase(it);
+        }
+      }
+
+
+      /* Record the AST stored in [addr:size] */
+      void SymbolicEngine::addAlignedMemory(triton::uint64 addr, triton::uint32 size, triton::ast::AbstractNode* node) {
+        this->removeAlignedMemory(addr, size);
+        if (this->snapshotFlag)
+          this->undoAlignedMemory.push_back(std::make_pair(addr, std::make_pair(size, static_cast<triton::ast::AbstractNode*>(nullptr))));
+        this->alignedMemoryReference[addr] = std::make_pair(size, node);
+      }
+
 
-        /* Remove overloaded range */
-        this->alignedMemoryReference.erase(std::make_pair(addr-BYTE_SIZE,   WORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-BYTE_SIZE,   DWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-BYTE_SIZE,   QWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-BYTE_SIZE,   DQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-BYTE_SIZE,   QQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-BYTE_SIZE,   DQQWORD_SIZE));
+      /* Returns the AST of [addr:size] if an aligned entry covers it, nullptr otherwise */
+      triton::ast::AbstractNode* SymbolicEngine::getAlignedMemory(triton::uint64 addr, triton::uint32 size) const {
+        std::map<triton::uint64, std::pair<triton::uint32, triton::ast::AbstractNode*>>::const_iterator it;
 
-        this->alignedMemoryReference.erase(std::make_pair(addr-WORD_SIZE,   DWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-WORD_SIZE,   QWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-WORD_SIZE,   DQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-WORD_SIZE,   QQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-WORD_SIZE,   DQQWORD_SIZE));
+        it = this->alignedMemoryReference.upper_bound(addr);
+        if (it == this->alignedMemoryReference.begin())
+          return nullptr;
+        it--;
 
-        this->alignedMemoryReference.erase(std::make_pair(addr-DWORD_SIZE,  QWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-DWORD_SIZE,  DQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-DWORD_SIZE,  QQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-DWORD_SIZE,  DQQWORD_SIZE));
+        triton::uint64 offset = addr - it->first;
+        triton::uint32 stored = it->second.first;
 
-        this->alignedMemoryReference.erase(std::make_pair(addr-QWORD_SIZE,  DQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-QWORD_SIZE,  QQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-QWORD_SIZE,  DQQWORD_SIZE));
+        if (offset >= stored || size > stored - offset)
+          return nullptr;
 
-        this->alignedMemoryReference.erase(std::make_pair(addr-DQWORD_SIZE, QQWORD_SIZE));
-        this->alignedMemoryReference.erase(std::make_pair(addr-DQWORD_SIZE, DQQWORD_SIZE));
+        /* Exact hit */
+        if (offset == 0 && size == stored)
+          return it->second.second;
 
-        this->alignedMemoryReference.erase(std::make_pair(addr-QQWORD_SIZE, DQQWORD_SIZE));
+        /* Partial hit, the load is a slice of the stored value (little endian) */
+        return triton::ast::extract(((offset + size) * BYTE_SIZE_BIT) - 1, offset * BYTE_SIZE_BIT, it->second.second);
       }
 
 
       /* Returns the reference memory if it's referenced otherwise returns UNSET */
       triton::usize SymbolicEngine::getSymbolicMemoryId(triton::uint64 addr) const {
-        std::map<triton::uint64, triton::usize>::const_iterator it;
-        if ((it = this->memoryReference.find(addr)) != this->memoryReference.end())
-          return it->second;
-        return triton::engines::symbolic::UNSET;
+        return this->memoryReference.get(addr);
       }
 
 
@@ -338,32 +381,239 @@ namespace triton {
       }
 
 
+      /* Deletes and removes the pointer. Expressions older than the snapshot are kept to be restored. */
+      void SymbolicEngine::dropSymbolicExpression(triton::usize symExprId) {
+        if (this->snapshotFlag && symExprId < this->snapshotSymExprId)
+          this->undoRemovedExpressions.push_back(this->symbolicExpressions[symExprId]);
+        else
+          this->deleteSymbolicExpression(this->symbolicExpressions[symExprId]);
+        this->symbolicExpressions.erase(symExprId);
+      }
+
+
+      /*
+       * The pointer of a held expression stays valid, so it cannot be reused
+       * by another expression while it is held (its id may be).
+       */
+      void SymbolicEngine::deleteSymbolicExpression(SymbolicExpression* se) {
+        if (this->heldExpressions.find(se) != this->heldExpressions.end())
+          this->detachedExpressions.insert(se);
+        else
+          delete se;
+      }
+
+
+      void SymbolicEngine::holdSymbolicExpression(SymbolicExpression* se) {
+        if (se != nullptr)
+          this->heldExpressions[se]++;
+      }
+
+
+      void SymbolicEngine::releaseSymbolicExpression(SymbolicExpression* se) {
+        std::map<SymbolicExpression*, triton::usize>::iterator it = this->heldExpressions.find(se);
+
+        if (it == this->heldExpressions.end())
+          return;
+
+        if (--it->second == 0) {
+          this->heldExpressions.erase(it);
+          if (this->detachedExpressions.erase(se))
+            delete se;
+        }
+      }
+
+
       /* Removes the symbolic expression corresponding to the id */
       void SymbolicEngine::removeSymbolicExpression(triton::usize symExprId) {
-        std::map<triton::uint64, triton::usize>::iterator it;
+        std::map<triton::usize, SymbolicExpression*>::iterator it = this->symbolicExpressions.find(symExprId);
 
-        if (this->symbolicExpressions.find(symExprId) != this->symbolicExpressions.end()) {
-          /* Delete and remove the pointer */
-          delete this->symbolicExpressions[symExprId];
-          this->symbolicExpressions.erase(symExprId);
+        if (it != this->symbolicExpressions.end()) {
+          /* Only the bytes the expression has been assigned to may reference it */
+          triton::arch::MemoryOperand mem = it->second->getOriginMemory();
+
+          this->dropSymbolicExpression(symExprId);
 
           /* Concretize the register if it exists */
           for (triton::uint32 i = 0; i < this->numberOfRegisters; i++) {
             if (this->symbolicReg[i] == symExprId) {
-              this->symbolicReg[i] = triton::engines::symbolic::UNSET;
+              this->setSymbolicRegisterId(i, triton::engines::symbolic::UNSET);
               return;
             }
           }
 
           /* Concretize the memory if it exists */
-          for (it = this->memoryReference.begin(); it != memoryReference.end(); it++) {
-            if (it->second == symExprId) {
-              this->concretizeMemory(it->first);
-              return;
+          for (triton::uint32 index = 0; index < mem.getSize(); index++) {
+            if (this->memoryReference.get(mem.getAddress() + index) == symExprId)
+              this->concretizeMemory(mem.getAddress() + index);
+          }
+        }
+
+      }
+
+
+      /* Marks live an expression from `fromId` and queues it */
+      void SymbolicEngine::markLiveExpression(triton::usize id, triton::usize fromId, std::set<triton::usize>& live, std::vector<SymbolicExpression*>& worklist) const {
+        std::map<triton::usize, SymbolicExpression*>::const_iterator it;
+
+        if (id == triton::engines::symbolic::UNSET || id < fromId || live.insert(id).second == false)
+          return;
+
+        it = this->symbolicExpressions.find(id);
+        if (it != this->symbolicExpressions.end())
+          worklist.push_back(it->second);
+      }
+
+
+      /* Propagates the liveness through the references of the ASTs of `nodes` and of the queued expressions */
+      void SymbolicEngine::propagateLiveExpressions(std::vector<triton::ast::AbstractNode*>& nodes, triton::usize fromId, std::set<triton::usize>& live, std::vector<SymbolicExpression*>& worklist) const {
+        std::set<triton::ast::AbstractNode*> visited;
+
+        while (!nodes.empty() || !worklist.empty()) {
+          if (nodes.empty()) {
+            worklist.back()->extractRoots(nodes);
+            worklist.pop_back();
+            continue;
+          }
+
+          triton::ast::AbstractNode* node = nodes.back();
+          nodes.pop_back();
+
+          if (node == nullptr || visited.insert(node).second == false)
+            continue;
+
+          if (node->getKind() == triton::ast::REFERENCE_NODE) {
+            this->markLiveExpression(reinterpret_cast<triton::ast::ReferenceNode*>(node)->getValue(), fromId, live, worklist);
+            continue;
+          }
+
+          nodes.insert(nodes.end(), node->getChilds().begin(), node->getChilds().end());
+        }
+      }
+
+
+      /*
+       * Intra-block liveness. The roots are the expressions of the block
+       * still assigned to a register or to a memory byte at the end of the
+       * block, the references of a live expression are live. The path
+       * constraint of the block comes from its last instruction, so its
+       * references are the ones of the program counter which is a root.
+       */
+      triton::usize SymbolicEngine::removeDeadBlockExpressions(std::vector<triton::arch::Instruction>& block) {
+        std::set<triton::usize> live;
+        std::vector<SymbolicExpression*> worklist;
+        std::vector<triton::ast::AbstractNode*> nodes;
+        std::vector<triton::usize> ids;
+        triton::usize fromId = this->uniqueSymExprId;
+        triton::usize removed = 0;
+
+        /* Only the expressions created by the block are candidates */
+        for (triton::usize index = 0; index < block.size(); index++) {
+          const std::vector<SymbolicExpression*>& exprs = block[index].symbolicExpressions;
+          for (triton::usize expr = 0; expr < exprs.size(); expr++)
+            fromId = std::min(fromId, exprs[expr]->getId());
+        }
+
+        for (triton::uint32 index = 0; index < this->numberOfRegisters; index++)
+          this->markLiveExpression(this->symbolicReg[index], fromId, live, worklist);
+
+        /* A store is live while one of its bytes is not overwritten */
+        for (triton::usize index = 0; index < block.size(); index++) {
+          const std::vector<SymbolicExpression*>& exprs = block[index].symbolicExpressions;
+          for (triton::usize expr = 0; expr < exprs.size(); expr++) {
+            if (exprs[expr]->getKind() != triton::engines::symbolic::MEM)
+              continue;
+            const triton::arch::MemoryOperand& mem = exprs[expr]->getOriginMemory();
+            ids.resize(mem.getSize());
+            if (this->memoryReference.get(mem.getAddress(), ids.data(), mem.getSize()) && std::find(ids.begin(), ids.end(), exprs[expr]->getId()) != ids.end())
+              this->markLiveExpression(exprs[expr]->getId(), fromId, live, worklist);
+          }
+        }
+
+        this->propagateLiveExpressions(nodes, fromId, live, worklist);
+
+        /* Remove the dead ones, they are neither in a register nor in the memory. Their nodes are reclaimed by the AST garbage collector. */
+        for (triton::usize index = 0; index < block.size(); index++) {
+          std::vector<SymbolicExpression*> newVector;
+          std::vector<SymbolicExpression*>& exprs = block[index].symbolicExpressions;
+          for (triton::usize expr = 0; expr < exprs.size(); expr++) {
+            if (live.find(exprs[expr]->getId()) != live.end())
+              newVector.push_back(exprs[expr]);
+            else {
+              block[index].concretizeLazyWrittenRegister(exprs[expr]);
+              this->dropSymbolicExpression(exprs[expr]->getId());
+              removed++;
             }
           }
+          exprs = newVector;
         }
 
+        return removed;
+      }
+
+
+      /*
+       * Liveness over the whole expression table. The roots are the
+       * registers, the memory, the aligned memory and the path constraints.
+       * Expressions older than a snapshot are kept aside to be restored.
+       */
+      triton::usize SymbolicEngine::removeDeadSymbolicExpressions(void) {
+        std::map<triton::usize, SymbolicExpression*>::const_iterator it1;
+        std::map<triton::uint64, std::pair<triton::uint32, triton::ast::AbstractNode*>>::const_iterator it2;
+        std::vector<triton::engines::symbolic::PathConstraint>::const_iterator it3;
+        std::set<triton::usize> live;
+        std::set<triton::usize> memory;
+        std::vector<SymbolicExpression*> worklist;
+        std::vector<triton::ast::AbstractNode*> nodes;
+        std::vector<triton::usize> dead;
+
+        for (triton::uint32 index = 0; index < this->numberOfRegisters; index++)
+          this->markLiveExpression(this->symbolicReg[index], 0, live, worklist);
+
+        this->memoryReference.extractIds(memory);
+        for (std::set<triton::usize>::const_iterator it = memory.begin(); it != memory.end(); it++)
+          this->markLiveExpression(*it, 0, live, worklist);
+
+        for (it2 = this->alignedMemoryReference.begin(); it2 != this->alignedMemoryReference.end(); it2++)
+          nodes.push_back(it2->second.second);
+
+        for (it3 = this->pathConstraints.begin(); it3 != this->pathConstraints.end(); it3++) {
+          const std::vector<std::tuple<bool, triton::uint64, triton::uint64, triton::ast::AbstractNode*>>& branches = it3->getBranchConstraints();
+          for (triton::usize index = 0; index < branches.size(); index++)
+            nodes.push_back(std::get<3>(branches[index]));
+        }
+
+        for (it3 = this->snapshotPathConstraints.begin(); it3 != this->snapshotPathConstraints.end(); it3++) {
+          const std::vector<std::tuple<bool, triton::uint64, triton::uint64, triton::ast::AbstractNode*>>& branches = it3->getBranchConstraints();
+          for (triton::usize index = 0; index < branches.size(); index++)
+            nodes.push_back(std::get<3>(branches[index]));
+        }
+
+        this->propagateLiveExpressions(nodes, 0, live, worklist);
+
+        for (it1 = this->symbolicExpressions.begin(); it1 != this->symbolicExpressions.end(); it1++) {
+          if (live.find(it1->first) == live.end())
+            dead.push_back(it1->first);
+        }
+
+        for (triton::usize index = 0; index < dead.size(); index++)
+          this->dropSymbolicExpression(dead[index]);
+
+        this->eliminationSymExprId = this->uniqueSymExprId;
+        this->liveAfterElimination = this->symbolicExpressions.size();
+
+        return dead.size();
+      }
+
+
+      /* Removes the dead expressions if enough expressions have been created since the last time */
+      triton::usize SymbolicEngine::removeDeadSymbolicExpressionsIfNeeded(void) {
+        triton::usize created = this->uniqueSymExprId - this->eliminationSymExprId;
+
+        /* Amortize the cost of a pass over as many expressions as there are live ones */
+        if (created < triton::engines::symbolic::DEAD_EXPRESSIONS_THRESHOLD || created < this->liveAfterElimination)
+          return 0;
+
+        return this->removeDeadSymbolicExpressions();
       }
 
 
@@ -381,23 +631,203 @@ namespace triton {
       }
 
 
-      /* Returns the full symbolic expression backtracked. */
-      triton::ast::AbstractNode* SymbolicEngine::getFullAst(triton::ast::AbstractNode* node) {
-        std::vector<triton::ast::AbstractNode*>& childs = node->getChilds();
-
-        for (triton::uint32 index = 0; index < childs.size(); index++) {
-          if (childs[index]->getKind() == triton::ast::REFERENCE_NODE) {
-            triton::usize id = reinterpret_cast<triton::ast::ReferenceNode*>(childs[index])->getValue();
-            triton::ast::AbstractNode* ref = this->getSymbolicExpressionFromId(id)->getAst();
-            childs[index] = ref;
+      /* Extracts the roots of the ASTs still used by the engine */
+      void SymbolicEngine::extractAstRoots(std::vector<triton::ast::AbstractNode*>& roots) const {
+        std::map<triton::usize, SymbolicExpression*>::const_iterator it1;
+        std::map<triton::uint64, std::pair<triton::uint32, triton::ast::AbstractNode*>>::const_iterator it2;
+        std::vector<triton::engines::symbolic::PathConstraint>::const_iterator it3;
+
+        /* Lazy expressions keep their operands alive instead of an AST */
+        for (it1 = this->symbolicExpressions.begin(); it1 != this->symbolicExpressions.end(); it1++)
+          it1->second->extractRoots(roots);
+
+        for (it2 = this->alignedMemoryReference.begin(); it2 != this->alignedMemoryReference.end(); it2++)
+          roots.push_back(it2->second.second);
+
+        for (it3 = this->pathConstraints.begin(); it3 != this->pathConstraints.end(); it3++) {
+          const std::vector<std::tuple<bool, triton::uint64, triton::uint64, triton::ast::AbstractNode*>>& branches = it3->getBranchConstraints();
+          for (triton::usize index = 0; index < branches.size(); index++)
+            roots.push_back(std::get<3>(branches[index]));
+        }
+
+        /* The snapshot keeps the previous state alive */
+        for (triton::usize index = 0; index < this->undoAsts.size(); index++)
+          roots.push_back(this->undoAsts[index].second);
+
+        for (triton::usize index = 0; index < this->undoAlignedMemory.size(); index++) {
+          if (this->undoAlignedMemory[index].second.second != nullptr)
+            roots.push_back(this->undoAlignedMemory[index].second.second);
+        }
+
+        for (triton::usize index = 0; index < this->undoRemovedExpressions.size(); index++)
+          this->undoRemovedExpressions[index]->extractRoots(roots);
+
+        /* The removed expressions which are still held */
+        for (std::set<SymbolicExpression*>::const_iterator it = this->detachedExpressions.begin(); it != this->detachedExpressions.end(); it++)
+          (*it)->extractRoots(roots);
+
+        for (it3 = this->snapshotPathConstraints.begin(); it3 != this->snapshotPathConstraints.end(); it3++) {
+          const std::vector<std::tuple<bool, triton::uint64, triton::uint64, triton::ast::AbstractNode*>>& branches = it3->getBranchConstraints();
+          for (triton::usize index = 0; index < branches.size(); index++)
+            roots.push_back(std::get<3>(branches[index]));
+        }
+      }
+
+
+      /* Builds the AST of every lazy expression */
+      void SymbolicEngine::buildLazyAsts(void) {
+        std::map<triton::usize, SymbolicExpression*>::const_iterator it;
+
+        for (it = this->symbolicExpressions.begin(); it != this->symbolicExpressions.end(); it++) {
+          if (it->second->isLazy())
+            it->second->getAst();
+        }
+
+        for (triton::usize index = 0; index < this->undoRemovedExpressions.size(); index++) {
+          if (this->undoRemovedExpressions[index]->isLazy())
+            this->undoRemovedExpressions[index]->getAst();
+        }
+      }
+
+
+      /* Returns the AST stored by a single memory write if the bytes are exactly this write */
+      triton::ast::AbstractNode* SymbolicEngine::getStoredAst(const triton::usize* ids, triton::uint32 size) const {
+        triton::ast::AbstractNode* stored = nullptr;
+
+        for (triton::uint32 index = 0; index < size; index++) {
+          std::map<triton::usize, SymbolicExpression*>::const_iterator it = this->symbolicExpressions.find(ids[index]);
+          if (it == this->symbolicExpressions.end())
+            return nullptr;
+
+          /* Each byte must be the extract of its own position in the stored AST */
+          triton::ast::AbstractNode* byte = it->second->getAst();
+          if (byte->getKind() != triton::ast::EXTRACT_NODE || byte->getBitvectorSize() != BYTE_SIZE_BIT)
+            return nullptr;
+
+          triton::ast::AbstractNode* low = byte->getChilds()[1];
+          if (reinterpret_cast<triton::ast::DecimalNode*>(low)->getValue() != index * BYTE_SIZE_BIT)
+            return nullptr;
+
+          triton::ast::AbstractNode* expr = byte->getChilds()[2];
+          if (stored == nullptr)
+            stored = expr;
+          else if (stored != expr)
+            return nullptr;
+        }
+
+        if (stored == nullptr || stored->getBitvectorSize() != size * BYTE_SIZE_BIT)
+          return nullptr;
+
+        return stored;
+      }
+
+
+      /* Returns the AST pointed by a node, following the chain of references */
+      triton::ast::AbstractNode* SymbolicEngine::getReferencedAst(triton::ast::AbstractNode* node) const {
+        while (node->getKind() == triton::ast::REFERENCE_NODE) {
+          triton::usize id = reinterpret_cast<triton::ast::ReferenceNode*>(node)->getValue();
+          node = this->getSymbolicExpressionFromId(id)->getAst();
+        }
+        return node;
+      }
+
+
+      /*
+       * Expands the references of an AST in place. Each node is visited
+       * once, so shared sub-DAGs are not walked again and deep traces do
+       * not exhaust the native stack.
+       */
+      triton::ast::AbstractNode* SymbolicEngine::expandFullAst(triton::ast::AbstractNode* node) {
+        std::set<triton::ast::AbstractNode*> visited;
+        std::vector<triton::ast::AbstractNode*> worklist;
+
+        node = this->getReferencedAst(node);
+        visited.insert(node);
+        worklist.push_back(node);
+
+        while (!worklist.empty()) {
+          triton::ast::AbstractNode* current = worklist.back();
+          triton::ast::AstChilds& childs = current->getChilds();
+
+          worklist.pop_back();
+          for (triton::uint32 index = 0; index < childs.size(); index++) {
+            triton::ast::AbstractNode* child = this->getReferencedAst(childs[index]);
+            if (child != childs[index])
+              current->setChild(index, child);
+            if (visited.insert(child).second)
+              worklist.push_back(child);
           }
-          this->getFullAst(childs[index]);
         }
 
         return node;
       }
 
 
+      /*
+       * Returns a new AST where references are expanded. Nodes are rebuilt
+       * in post-order and memoized, only nodes which lead to a reference are
+       * duplicated and the others are shared with the stored expressions.
+       */
+      triton::ast::AbstractNode* SymbolicEngine::duplicateFullAst(triton::ast::AbstractNode* node) {
+        std::map<triton::ast::AbstractNode*, triton::ast::AbstractNode*> expanded;
+        std::vector<std::pair<triton::ast::AbstractNode*, bool>> worklist;
+
+        node = this->getReferencedAst(node);
+        worklist.push_back(std::make_pair(node, false));
+
+        while (!worklist.empty()) {
+          triton::ast::AbstractNode* current = worklist.back().first;
+          triton::ast::AstChilds& childs = current->getChilds();
+
+          /* Already reached from another parent */
+          if (expanded.find(current) != expanded.end()) {
+            worklist.pop_back();
+            continue;
+          }
+
+          /* First visit, expand the childs before the node */
+          if (worklist.back().second == false) {
+            worklist.back().second = true;
+            for (triton::uint32 index = 0; index < childs.size(); index++) {
+              triton::ast::AbstractNode* child = this->getReferencedAst(childs[index]);
+              if (expanded.find(child) == expanded.end())
+                worklist.push_back(std::make_pair(child, false));
+            }
+            continue;
+          }
+
+          /* Second visit, the node is duplicated only if one of its childs has changed */
+          triton::ast::AbstractNode* result = current;
+          for (triton::uint32 index = 0; index < childs.size(); index++) {
+            triton::ast::AbstractNode* child = expanded[this->getReferencedAst(childs[index])];
+            if (child != childs[index]) {
+              if (result == current)
+                result = triton::ast::newShallowInstance(current);
+              result->getChilds()[index] = child;
+            }
+          }
+
+          if (result != current) {
+            result->init();
+            result = triton::api.recordAstNode(result);
+          }
+
+          expanded[current] = result;
+          worklist.pop_back();
+        }
+
+        return expanded[node];
+      }
+
+
+      /* Returns the full symbolic expression backtracked. */
+      triton::ast::AbstractNode* SymbolicEngine::getFullAst(triton::ast::AbstractNode* node, bool inplace) {
+        if (inplace)
+          return this->expandFullAst(node);
+        return this->duplicateFullAst(node);
+      }
+
+
       /* Returns a list which contains all tainted expressions */
       std::list<SymbolicExpression*> SymbolicEngine::getTaintedSymbolicExpressions(void) const {
         std::map<triton::usize, SymbolicExpression*>::const_iterator it;
@@ -441,9 +871,10 @@ namespace triton {
       /* Returns the map of symbolic memory defined */
       std::map<triton::uint64, SymbolicExpression*> SymbolicEngine::getSymbolicMemory(void) const {
         std::map<triton::uint64, SymbolicExpression*> ret;
+        std::map<triton::uint64, triton::usize> references = this->memoryReference.getReferences();
         std::map<triton::uint64, triton::usize>::const_iterator it;
 
-        for (it = this->memoryReference.begin(); it != this->memoryReference.end(); it++)
+        for (it = references.begin(); it != references.end(); it++)
           ret[it->first] = this->getSymbolicExpressionFromId(it->second);
 
         return ret;
@@ -468,6 +899,7 @@ namespace triton {
 
         tmp = triton::ast::variable(*symVar);
         tmp->setParent(expression->getAst()->getParents());
+        this->logSymbolicExpressionAst(expression);
         expression->setAst(tmp);
         tmp->init();
 
@@ -509,6 +941,7 @@ namespace triton {
           else {
             se = this->getSymbolicExpressionFromId(memSymId);
             tmp->setParent(se->getAst()->getParents());
+            this->logSymbolicExpressionAst(se);
             se->setAst(tmp);
             tmp->init();
             se->setOriginMemory(triton::arch::MemoryOperand(memAddr+index, BYTE_SIZE, tmp->evaluate()));
@@ -546,7 +979,7 @@ namespace triton {
           /* Create the symbolic expression */
           SymbolicExpression* se = this->newSymbolicExpression(tmp, triton::engines::symbolic::REG);
           se->setOriginRegister(reg);
-          this->symbolicReg[parentId] = se->getId();
+          this->setSymbolicRegisterId(parentId, se->getId());
         }
 
         else {
@@ -560,6 +993,7 @@ namespace triton {
           triton::ast::AbstractNode* tmp = triton::ast::variable(*symVar);
           /* Set the AST node */
           tmp->setParent(expression->getAst()->getParents());
+          this->logSymbolicExpressionAst(expression);
           expression->setAst(tmp);
           tmp->init();
         }
@@ -604,23 +1038,29 @@ namespace triton {
         triton::uint64 address                    = mem.getAddress();
         triton::uint32 size                       = mem.getSize();
         triton::usize symMem                      = triton::engines::symbolic::UNSET;
+        triton::usize symMemIds[DQQWORD_SIZE];
         triton::uint8 concreteValue[DQQWORD_SIZE] = {0};
         triton::uint512 value                     = triton::api.getConcreteMemoryValue(mem);
 
         triton::utils::fromUintToBuffer(value, concreteValue);
 
+        /* Fetch the references of all bytes at once */
+        bool symbolic = this->memoryReference.get(address, symMemIds, size);
+
         /*
          * Symbolic optimization
          * If the memory access is aligned, don't split the memory.
          */
         if (triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::ALIGNED_MEMORY)) {
-          if (this->alignedMemoryReference.find(std::make_pair(address, size)) != this->alignedMemoryReference.end()) {
-            return this->alignedMemoryReference[std::make_pair(address, size)];
-          }
+          if ((tmp = this->getAlignedMemory(address, size)) != nullptr)
+            return tmp;
+          /* All bytes still come from the same write */
+          if (symbolic && (tmp = this->getStoredAst(symMemIds, size)) != nullptr)
+            return tmp;
         }
 
         while (size) {
-          symMem = this->getSymbolicMemoryId(address + size - 1);
+          symMem = symMemIds[size - 1];
           if (symMem != triton::engines::symbolic::UNSET) {
             tmp = triton::ast::reference(symMem);
             opVec.push_back(triton::ast::extract((BYTE_SIZE_BIT - 1), 0, tmp));
@@ -696,8 +1136,7 @@ namespace triton {
 
         /* Record the aligned memory for a symbolic optimization */
         if (triton::api.isSymbolicOptimizationEnabled(triton::engines::symbolic::ALIGNED_MEMORY)) {
-          this->removeAlignedMemory(address);
-          this->alignedMemoryReference[std::make_pair(address, writeSize)] = node;
+          this->addAlignedMemory(address, writeSize, node);
         }
 
         /*
@@ -809,6 +1248,32 @@ namespace triton {
       }
 
 
+      /* Returns the new lazy symbolic flag expression. Its AST is built on its first use. */
+      SymbolicExpression* SymbolicEngine::createSymbolicLazyFlagExpression(triton::arch::Instruction& inst, LazyAst* lazy, triton::uint512 value, triton::arch::RegisterOperand& flag, const std::string& comment) {
+        if (!flag.isFlag())
+          throw std::runtime_error("SymbolicEngine::createSymbolicLazyFlagExpression(): The register must be a flag.");
+
+        triton::usize id = this->getUniqueSymExprId();
+        SymbolicExpression* se = new SymbolicExpression(nullptr, id, triton::engines::symbolic::REG, comment);
+        if (se == nullptr)
+          throw std::runtime_error("SymbolicEngine::createSymbolicLazyFlagExpression(): not enough memory");
+
+        se->setLazyAst(lazy);
+        this->symbolicExpressions[id] = se;
+
+        /* Same as assignSymbolicExpressionToRegister() without looking at the AST */
+        flag.setConcreteValue(value);
+        se->setOriginRegister(flag);
+        this->setSymbolicRegisterId(flag.getId(), id);
+        triton::api.setConcreteRegisterValue(flag);
+
+        /* The AST of the written register is built when the written registers are read */
+        inst.addSymbolicExpression(se);
+        inst.setLazyWrittenRegister(flag, se);
+        return se;
+      }
+
+
       /* Returns the new symbolic volatile expression */
       SymbolicExpression* SymbolicEngine::createSymbolicVolatileExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, const std::string& comment) {
         triton::engines::symbolic::SymbolicExpression* se = this->newSymbolicExpression(node, triton::engines::symbolic::UNDEF, comment);
@@ -819,7 +1284,112 @@ namespace triton {
 
       /* Adds and assign a new memory reference */
       void SymbolicEngine::addMemoryReference(triton::uint64 mem, triton::usize id) {
-        this->memoryReference[mem] = id;
+        this->setSymbolicMemoryId(mem, id);
+      }
+
+
+      /* Assigns a reference id to a register and logs the previous one */
+      void SymbolicEngine::setSymbolicRegisterId(triton::uint32 parentId, triton::usize id) {
+        if (this->snapshotFlag && this->symbolicReg[parentId] != id)
+          this->undoRegisters.push_back(std::make_pair(parentId, this->symbolicReg[parentId]));
+        this->symbolicReg[parentId] = id;
+      }
+
+
+      /* Assigns a reference id to a memory byte and logs the previous one */
+      void SymbolicEngine::setSymbolicMemoryId(triton::uint64 addr, triton::usize id) {
+        if (this->snapshotFlag) {
+          triton::usize previous = this->memoryReference.get(addr);
+          if (previous != id)
+            this->undoMemory.push_back(std::make_pair(addr, previous));
+        }
+        this->memoryReference.set(addr, id);
+      }
+
+
+      /* Logs the AST of an expression older than the snapshot before it is replaced */
+      void SymbolicEngine::logSymbolicExpressionAst(SymbolicExpression* se) {
+        if (this->snapshotFlag && se->getId() < this->snapshotSymExprId)
+          this->undoAsts.push_back(std::make_pair(se, se->getAst()));
+      }
+
+
+      void SymbolicEngine::takeSnapshot(void) {
+        this->disableSnapshot();
+        this->snapshotFlag       = true;
+        this->snapshotEnableFlag = this->enableFlag;
+        this->snapshotSymExprId  = this->uniqueSymExprId;
+        this->snapshotSymVarId   = this->uniqueSymVarId;
+        this->takePathConstraintsSnapshot();
+      }
+
+
+      void SymbolicEngine::restoreSnapshot(void) {
+        if (!this->snapshotFlag)
+          throw std::runtime_error("SymbolicEngine::restoreSnapshot(): No snapshot has been taken.");
+
+        /* Delete the expressions and variables created since the snapshot */
+        for (auto it = this->symbolicExpressions.lower_bound(this->snapshotSymExprId); it != this->symbolicExpressions.end();) {
+          this->deleteSymbolicExpression(it->second);
+          it = this->symbolicExpressions.erase(it);
+        }
+
+        for (auto it = this->symbolicVariables.lower_bound(this->snapshotSymVarId); it != this->symbolicVariables.end();) {
+          delete it->second;
+          it = this->symbolicVariables.erase(it);
+        }
+
+        /* Bring back the removed expressions and their previous ASTs */
+        for (triton::usize index = 0; index < this->undoRemovedExpressions.size(); index++)
+          this->symbolicExpressions[this->undoRemovedExpressions[index]->getId()] = this->undoRemovedExpressions[index];
+
+        for (triton::usize index = this->undoAsts.size(); index > 0; index--)
+          this->undoAsts[index - 1].first->setAst(this->undoAsts[index - 1].second);
+
+        /* Replay the undo logs backward */
+        for (triton::usize index = this->undoRegisters.size(); index > 0; index--)
+          this->symbolicReg[this->undoRegisters[index - 1].first] = this->undoRegisters[index - 1].second;
+
+        for (triton::usize index = this->undoMemory.size(); index > 0; index--)
+          this->memoryReference.set(this->undoMemory[index - 1].first, this->undoMemory[index - 1].second);
+
+        for (triton::usize index = this->undoAlignedMemory.size(); index > 0; index--) {
+          const std::pair<triton::uint64, std::pair<triton::uint32, triton::ast::AbstractNode*>>& entry = this->undoAlignedMemory[index - 1];
+          if (entry.second.second == nullptr)
+            this->alignedMemoryReference.erase(entry.first);
+          else
+            this->alignedMemoryReference[entry.first] = entry.second;
+        }
+
+        this->undoRegisters.clear();
+        this->undoMemory.clear();
+        this->undoAlignedMemory.clear();
+        this->undoAsts.clear();
+        this->undoRemovedExpressions.clear();
+
+        this->enableFlag      = this->snapshotEnableFlag;
+        this->uniqueSymExprId = this->snapshotSymExprId;
+        this->uniqueSymVarId  = this->snapshotSymVarId;
+        this->restorePathConstraintsSnapshot();
+      }
+
+
+      void SymbolicEngine::disableSnapshot(void) {
+        for (triton::usize index = 0; index < this->undoRemovedExpressions.size(); index++)
+          this->deleteSymbolicExpression(this->undoRemovedExpressions[index]);
+
+        this->undoRegisters.clear();
+        this->undoMemory.clear();
+        this->undoAlignedMemory.clear();
+        this->undoAsts.clear();
+        this->undoRemovedExpressions.clear();
+        this->snapshotFlag = false;
+        this->disablePathConstraintsSnapshot();
+      }
+
+
+      bool SymbolicEngine::isSnapshotEnabled(void) const {
+        return this->snapshotFlag;
       }
 
 
@@ -837,9 +1407,13 @@ namespace triton {
         if (node->getBitvectorSize() != reg.getBitSize())
           throw std::runtime_error("SymbolicEngine::assignSymbolicExpressionToRegister(): The size of the symbolic expression is not equal to the target register.");
 
+        /* The id of a removed expression may have been given to another one */
+        if (this->detachedExpressions.find(se) != this->detachedExpressions.end())
+          throw std::runtime_error("SymbolicEngine::assignSymbolicExpressionToRegister(): The symbolic expression has been removed from the symbolic engine.");
+
         se->setKind(triton::engines::symbolic::REG);
         se->setOriginRegister(reg);
-        this->symbolicReg[id] = se->getId();
+        this->setSymbolicRegisterId(id, se->getId());
 
         /* Synchronize the concrete state */
         triton::api.setConcreteRegisterValue(reg);
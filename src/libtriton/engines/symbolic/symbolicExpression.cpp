@@ -22,14 +22,43 @@ namespace triton {
         this->id            = id;
         this->isTainted     = false;
         this->kind          = kind;
+        this->lazyAst       = nullptr;
       }
 
 
       SymbolicExpression::~SymbolicExpression() {
+        delete this->lazyAst;
+      }
+
+
+      bool SymbolicExpression::isLazy(void) const {
+        return (this->lazyAst != nullptr);
+      }
+
+
+      bool SymbolicExpression::isSymbolized(void) const {
+        if (this->lazyAst != nullptr)
+          return this->lazyAst->isSymbolized();
+        return this->getAst()->isSymbolized();
+      }
+
+
+      void SymbolicExpression::extractRoots(std::vector<triton::ast::AbstractNode*>& roots) const {
+        if (this->lazyAst != nullptr)
+          this->lazyAst->extractRoots(roots);
+        else
+          roots.push_back(this->ast);
       }
 
 
       triton::ast::AbstractNode* SymbolicExpression::getAst(void) const {
+        /* Build the AST of a lazy expression the same way as SymbolicEngine::newSymbolicExpression() */
+        if (this->lazyAst != nullptr) {
+          this->ast = triton::api.processSimplification(this->lazyAst->build());
+          delete this->lazyAst;
+          this->lazyAst = nullptr;
+        }
+
         if (this->ast == nullptr)
           throw std::runtime_error("SymbolicExpression::getAst(): No AST defined.");
         return this->ast;
@@ -37,9 +66,7 @@ namespace triton {
 
 
       triton::ast::AbstractNode* SymbolicExpression::getNewAst(void) const {
-        if (this->ast == nullptr)
-          throw std::runtime_error("SymbolicExpression::getNewAst(): No AST defined.");
-        return triton::ast::newInstance(this->ast);
+        return triton::ast::newInstance(this->getAst());
       }
 
 
@@ -96,12 +123,18 @@ namespace triton {
 
 
       void SymbolicExpression::setAst(triton::ast::AbstractNode* node) {
-        node->setParent(this->ast->getParents());
+        node->setParent(this->getAst()->getParents());
         this->ast = node;
         this->ast->init();
       }
 
 
+      void SymbolicExpression::setLazyAst(LazyAst* lazy) {
+        delete this->lazyAst;
+        this->lazyAst = lazy;
+      }
+
+
       void SymbolicExpression::setKind(symkind_e k) {
         this->kind = k;
       }
@@ -0,0 +1,168 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <symbolicMemory.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace symbolic {
+
+      SymbolicMemoryPage::SymbolicMemoryPage() {
+        for (triton::uint32 index = 0; index < MEMORY_PAGE_SIZE; index++)
+          this->ids[index] = triton::engines::symbolic::UNSET;
+        this->count = 0;
+      }
+
+
+      SymbolicMemory::SymbolicMemory() {
+        this->lastPageBase = 0;
+        this->lastPage     = nullptr;
+      }
+
+
+      SymbolicMemory::SymbolicMemory(const SymbolicMemory& copy) {
+        this->pages        = copy.pages;
+        this->lastPageBase = 0;
+        this->lastPage     = nullptr;
+      }
+
+
+      SymbolicMemory::~SymbolicMemory() {
+        this->clear();
+      }
+
+
+      void SymbolicMemory::operator=(const SymbolicMemory& copy) {
+        this->pages        = copy.pages;
+        this->lastPageBase = 0;
+        this->lastPage     = nullptr;
+      }
+
+
+      void SymbolicMemory::clear(void) {
+        this->pages.clear();
+        this->lastPageBase = 0;
+        this->lastPage     = nullptr;
+      }
+
+
+      SymbolicMemoryPage* SymbolicMemory::getPage(triton::uint64 addr) {
+        triton::uint64 base = addr & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK);
+
+        if (this->lastPage != nullptr && this->lastPageBase == base)
+          return this->lastPage;
+
+        this->lastPageBase = base;
+        this->lastPage     = &this->pages[base];
+
+        return this->lastPage;
+      }
+
+
+      triton::usize SymbolicMemory::get(triton::uint64 addr) const {
+        auto it = this->pages.find(addr & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK));
+
+        if (it == this->pages.end())
+          return triton::engines::symbolic::UNSET;
+
+        return it->second.ids[addr & MEMORY_PAGE_MASK];
+      }
+
+
+      bool SymbolicMemory::get(triton::uint64 addr, triton::usize* ids, triton::uint32 size) const {
+        auto it = this->pages.end();
+        bool symbolic = false;
+
+        for (triton::uint32 index = 0; index < size; index++) {
+          triton::uint64 base = (addr + index) & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK);
+
+          /* Only look the page up again when crossing a page boundary */
+          if (index == 0 || ((addr + index) & MEMORY_PAGE_MASK) == 0)
+            it = this->pages.find(base);
+
+          if (it == this->pages.end())
+            ids[index] = triton::engines::symbolic::UNSET;
+          else
+            ids[index] = it->second.ids[(addr + index) & MEMORY_PAGE_MASK];
+
+          if (ids[index] != triton::engines::symbolic::UNSET)
+            symbolic = true;
+        }
+
+        return symbolic;
+      }
+
+
+      void SymbolicMemory::set(triton::uint64 addr, triton::usize id) {
+        if (id == triton::engines::symbolic::UNSET) {
+          this->erase(addr);
+          return;
+        }
+
+        SymbolicMemoryPage* page = this->getPage(addr);
+        triton::usize& slot = page->ids[addr & MEMORY_PAGE_MASK];
+
+        if (slot == triton::engines::symbolic::UNSET)
+          page->count++;
+
+        slot = id;
+      }
+
+
+      void SymbolicMemory::erase(triton::uint64 addr) {
+        auto it = this->pages.find(addr & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK));
+
+        if (it == this->pages.end())
+          return;
+
+        SymbolicMemoryPage& page = it->second;
+        triton::usize& slot = page.ids[addr & MEMORY_PAGE_MASK];
+
+        if (slot == triton::engines::symbolic::UNSET)
+          return;
+
+        slot = triton::engines::symbolic::UNSET;
+        if (--page.count == 0) {
+          if (this->lastPage == &page)
+            this->lastPage = nullptr;
+          this->pages.erase(it);
+        }
+      }
+
+
+      std::map<triton::uint64, triton::usize> SymbolicMemory::getReferences(void) const {
+        std::map<triton::uint64, triton::usize> ret;
+
+        for (auto it = this->pages.begin(); it != this->pages.end(); it++) {
+          for (triton::uint32 index = 0; index < MEMORY_PAGE_SIZE; index++) {
+            if (it->second.ids[index] != triton::engines::symbolic::UNSET)
+              ret[it->first + index] = it->second.ids[index];
+          }
+        }
+
+        return ret;
+      }
+
+
+      void SymbolicMemory::extractIds(std::set<triton::usize>& ids) const {
+        for (auto it = this->pages.begin(); it != this->pages.end(); it++) {
+          triton::usize last = triton::engines::symbolic::UNSET;
+          for (triton::uint32 index = 0; index < MEMORY_PAGE_SIZE; index++) {
+            /* The bytes of a store are contiguous, skip the repeated ids */
+            triton::usize id = it->second.ids[index];
+            if (id != last && id != triton::engines::symbolic::UNSET)
+              ids.insert(id);
+            last = id;
+          }
+        }
+      }
+
+    }; /* symbolic namespace */
+  }; /* engines namespace */
+}; /*triton namespace */
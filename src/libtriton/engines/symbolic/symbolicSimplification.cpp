@@ -235,7 +235,7 @@ namespace triton {
         if (this->z3Enabled | z3) {
           triton::ast::TritonToZ3Ast  z3Ast{false};
           triton::ast::Z3ToTritonAst  tritonAst{};
-          triton::ast::Z3Result       result = z3Ast.eval(*node);
+          triton::ast::Z3Result&      result = z3Ast.eval(*node);
 
           /* Simplify and convert back to Triton's AST */
           z3::expr expr = result.getExpr().simplify();
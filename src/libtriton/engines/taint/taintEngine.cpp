@@ -83,6 +83,26 @@ That's why Triton uses **symbolic execution for precision** and an over-approxim
 tainting to know if we can ask a model to the SMT solver - Asking a model means that
 the symbolic variables are controllable by the user input.
 
+\section engine_Taint_granularity Granularity
+<hr>
+
+The memory taint is kept at the byte level in a shadow memory: a bitmap per page of
+memory where each bit is one byte, so a memory operand is tainted, untainted or copied
+one word at a time. The register taint is kept at the byte level too: in the example
+above, only `RAX[7..0]` is tainted and `cmp ah, 0x99` is not controllable. Except for
+memory to memory copies which are done byte per byte, the taint inside an operand is still
+an over-approximation: if one byte of the source is tainted, every byte of the destination
+is tainted.
+
+\section engine_Taint_labels Labels
+<hr>
+
+By default, a byte is only tainted or not. With TaintEngine::enableLabels(), each source
+byte can be tainted with a label (e.g. the offset of an input byte) and the union and
+assignment rules propagate sets of labels along with the taint. Then, one run answers
+which sources reach a register or a memory area with TaintEngine::getTaintLabels().
+Each distinct set of labels is stored once, so a byte only holds the id of its set.
+
 */
 
 
@@ -91,25 +111,40 @@ namespace triton {
   namespace engines {
     namespace taint {
 
+      /* Returns the mask of the bytes of reg into its parent register */
+      static triton::uint64 getRegisterMask(const triton::arch::RegisterOperand& reg) {
+        triton::uint32 low  = reg.getLow() / BYTE_SIZE_BIT;
+        triton::uint32 high = reg.getHigh() / BYTE_SIZE_BIT;
+        return triton::engines::taint::maskOf(high - low + 1) << low;
+      }
+
+
       TaintEngine::TaintEngine() {
         triton::api.checkArchitecture();
         this->numberOfRegisters = triton::api.cpuNumberOfRegisters();
-        this->taintedRegisters  = new triton::uint8[this->numberOfRegisters]();
+        this->taintedRegisters  = new triton::uint64[this->numberOfRegisters]();
         this->enableFlag  = true;
+        this->labelsFlag  = false;
+        this->snapshotFlag       = false;
+        this->snapshotEnableFlag = true;
+        this->registerLabels.assign(this->numberOfRegisters * DQQWORD_SIZE, triton::engines::taint::EMPTY_LABELS);
 
         if (!this->taintedRegisters)
           throw std::invalid_argument("TaintEngine::TaintEngine(): No enough memory.");
 
         for (triton::uint32 i = 0; i < this->numberOfRegisters; i++)
-          this->taintedRegisters[i] = !TAINTED;
+          this->taintedRegisters[i] = 0;
       }
 
 
       void TaintEngine::init(const TaintEngine& other) {
         triton::api.checkArchitecture();
         this->numberOfRegisters = other.numberOfRegisters;
-        this->taintedRegisters  = new triton::uint8[this->numberOfRegisters]();
+        this->taintedRegisters  = new triton::uint64[this->numberOfRegisters]();
         this->enableFlag  = other.enableFlag;
+        this->labelsFlag  = other.labelsFlag;
+        this->snapshotFlag       = false;
+        this->snapshotEnableFlag = other.enableFlag;
 
         if (!this->taintedRegisters)
           throw std::invalid_argument("TaintEngine::TaintEngine(): No enough memory.");
@@ -118,6 +153,9 @@ namespace triton {
           this->taintedRegisters[i] = other.taintedRegisters[i];
 
         this->taintedAddresses = other.taintedAddresses;
+        this->labelSets        = other.labelSets;
+        this->addressLabels    = other.addressLabels;
+        this->registerLabels   = other.registerLabels;
       }
 
 
@@ -133,10 +171,203 @@ namespace triton {
 
       void TaintEngine::operator=(const TaintEngine& other) {
         delete[] this->taintedRegisters;
+        this->disableSnapshot();
         init(other);
       }
 
 
+      /* Set the labels of a register byte and log the previous ones */
+      void TaintEngine::setRegisterLabels(triton::uint32 parentId, triton::uint32 byte, triton::uint32 set) {
+        triton::usize index = parentId * DQQWORD_SIZE + byte;
+
+        if (this->snapshotFlag && this->registerLabels[index] != set)
+          this->undoRegisterLabels.push_back(std::make_pair(index, this->registerLabels[index]));
+        this->registerLabels[index] = set;
+      }
+
+
+      /* Set the labels of an address and log the previous ones */
+      void TaintEngine::setAddressLabels(triton::uint64 addr, triton::uint32 set) {
+        if (this->snapshotFlag) {
+          triton::uint32 previous = this->addressLabels.get(addr);
+          if (previous != set)
+            this->undoAddressLabels.push_back(std::make_pair(addr, previous));
+        }
+        this->addressLabels.set(addr, set);
+      }
+
+
+      /* Returns the union of the labels of each byte of reg */
+      triton::uint32 TaintEngine::getRegisterLabels(const triton::arch::RegisterOperand& reg) {
+        triton::uint32 parentId = reg.getParent().getId();
+        triton::uint32 set      = triton::engines::taint::EMPTY_LABELS;
+
+        if (!this->labelsFlag)
+          return set;
+
+        for (triton::uint32 byte = reg.getLow() / BYTE_SIZE_BIT; byte <= reg.getHigh() / BYTE_SIZE_BIT; byte++)
+          set = this->labelSets.getUnion(set, this->registerLabels[parentId * DQQWORD_SIZE + byte]);
+
+        return set;
+      }
+
+
+      /* Returns the union of the labels of each byte of [addr:size] */
+      triton::uint32 TaintEngine::getAddressLabels(triton::uint64 addr, triton::uint32 size) {
+        triton::uint32 set = triton::engines::taint::EMPTY_LABELS;
+
+        if (!this->labelsFlag)
+          return set;
+
+        for (triton::uint32 index = 0; index < size; index++)
+          set = this->labelSets.getUnion(set, this->addressLabels.get(addr + index));
+
+        return set;
+      }
+
+
+      /*
+       * The flags and the implicit destinations of an instruction do not have
+       * a single source operand, they get the labels of everything it reads.
+       * The registers used to compute a memory address are not sources.
+       */
+      triton::uint32 TaintEngine::getInstructionLabels(const triton::arch::Instruction& inst) {
+        const std::set<std::pair<triton::arch::MemoryOperand, triton::ast::AbstractNode*>>& loads = inst.getLoadAccess();
+        const std::set<std::pair<triton::arch::RegisterOperand, triton::ast::AbstractNode*>>& regs = inst.getReadRegisters();
+        std::set<triton::uint32> addressing;
+        triton::uint32 set = triton::engines::taint::EMPTY_LABELS;
+
+        if (!this->labelsFlag)
+          return set;
+
+        for (auto it = loads.begin(); it != loads.end(); it++) {
+          triton::arch::MemoryOperand mem = it->first;
+          addressing.insert(mem.getBaseRegister().getId());
+          addressing.insert(mem.getIndexRegister().getId());
+          addressing.insert(mem.getSegmentRegister().getId());
+          set = this->labelSets.getUnion(set, this->getAddressLabels(mem.getAddress(), mem.getSize()));
+        }
+
+        for (auto it = regs.begin(); it != regs.end(); it++) {
+          if (addressing.find(it->first.getId()) == addressing.end())
+            set = this->labelSets.getUnion(set, this->getRegisterLabels(it->first));
+        }
+
+        return set;
+      }
+
+
+      /* Set the taint of a register and log the previous one */
+      void TaintEngine::setRegisterTaint(triton::uint32 parentId, triton::uint64 mask) {
+        triton::uint64 untainted = this->taintedRegisters[parentId] & ~mask;
+
+        if (this->snapshotFlag && this->taintedRegisters[parentId] != mask)
+          this->undoRegisters.push_back(std::make_pair(parentId, this->taintedRegisters[parentId]));
+        this->taintedRegisters[parentId] = mask;
+
+        /* Untainted bytes lose their labels */
+        if (this->labelsFlag) {
+          for (triton::uint32 byte = 0; untainted; byte++, untainted >>= 1) {
+            if (untainted & 1)
+              this->setRegisterLabels(parentId, byte, triton::engines::taint::EMPTY_LABELS);
+          }
+        }
+      }
+
+
+      /* Set the taint of [addr:size] and log the previous one */
+      void TaintEngine::setAddressTaint(triton::uint64 addr, triton::uint32 size, triton::uint64 mask) {
+        if (this->snapshotFlag || this->labelsFlag) {
+          triton::uint64 previous  = this->taintedAddresses.get(addr, size);
+          triton::uint64 untainted = previous & ~mask;
+
+          if (this->snapshotFlag && previous != (mask & triton::engines::taint::maskOf(size)))
+            this->undoAddresses.push_back(std::make_pair(std::make_pair(addr, size), previous));
+
+          /* Untainted bytes lose their labels */
+          if (this->labelsFlag) {
+            for (triton::uint32 index = 0; untainted; index++, untainted >>= 1) {
+              if (untainted & 1)
+                this->setAddressLabels(addr + index, triton::engines::taint::EMPTY_LABELS);
+            }
+          }
+        }
+        this->taintedAddresses.set(addr, size, mask);
+      }
+
+
+      /* Set the taint of a register written by an instruction */
+      bool TaintEngine::writeRegisterTaint(const triton::arch::RegisterOperand& reg, bool flag, triton::uint32 labels) {
+        triton::uint32 parentId = reg.getParent().getId();
+        triton::uint64 mask     = getRegisterMask(reg);
+        triton::uint64 taint    = this->taintedRegisters[parentId] & ~mask;
+
+        /* The upper bytes of the parent are cleared */
+        if (reg.getSize() >= DWORD_SIZE)
+          taint &= triton::engines::taint::maskOf(reg.getLow() / BYTE_SIZE_BIT);
+
+        if (flag == TAINTED)
+          taint |= mask;
+
+        this->setRegisterTaint(parentId, taint);
+
+        if (flag == TAINTED && this->labelsFlag) {
+          for (triton::uint32 byte = reg.getLow() / BYTE_SIZE_BIT; byte <= reg.getHigh() / BYTE_SIZE_BIT; byte++)
+            this->setRegisterLabels(parentId, byte, labels);
+        }
+
+        return flag;
+      }
+
+
+      void TaintEngine::takeSnapshot(void) {
+        this->disableSnapshot();
+        this->snapshotFlag       = true;
+        this->snapshotEnableFlag = this->enableFlag;
+      }
+
+
+      void TaintEngine::restoreSnapshot(void) {
+        if (!this->snapshotFlag)
+          throw std::runtime_error("TaintEngine::restoreSnapshot(): No snapshot has been taken.");
+
+        /* Replay the undo logs backward */
+        for (triton::usize index = this->undoRegisters.size(); index > 0; index--)
+          this->taintedRegisters[this->undoRegisters[index - 1].first] = this->undoRegisters[index - 1].second;
+
+        for (triton::usize index = this->undoAddresses.size(); index > 0; index--) {
+          const std::pair<std::pair<triton::uint64, triton::uint32>, triton::uint64>& entry = this->undoAddresses[index - 1];
+          this->taintedAddresses.set(entry.first.first, entry.first.second, entry.second);
+        }
+
+        for (triton::usize index = this->undoRegisterLabels.size(); index > 0; index--)
+          this->registerLabels[this->undoRegisterLabels[index - 1].first] = this->undoRegisterLabels[index - 1].second;
+
+        for (triton::usize index = this->undoAddressLabels.size(); index > 0; index--)
+          this->addressLabels.set(this->undoAddressLabels[index - 1].first, this->undoAddressLabels[index - 1].second);
+
+        this->undoRegisters.clear();
+        this->undoAddresses.clear();
+        this->undoRegisterLabels.clear();
+        this->undoAddressLabels.clear();
+        this->enableFlag = this->snapshotEnableFlag;
+      }
+
+
+      void TaintEngine::disableSnapshot(void) {
+        this->undoRegisters.clear();
+        this->undoAddresses.clear();
+        this->undoRegisterLabels.clear();
+        this->undoAddressLabels.clear();
+        this->snapshotFlag = false;
+      }
+
+
+      bool TaintEngine::isSnapshotEnabled(void) const {
+        return this->snapshotFlag;
+      }
+
+
       bool TaintEngine::isEnabled(void) const {
         return this->enableFlag;
       }
@@ -147,26 +378,56 @@ namespace triton {
       }
 
 
-      /* Returns true of false if the memory address is currently tainted */
-      bool TaintEngine::isMemoryTainted(const triton::arch::MemoryOperand& mem) const {
-        triton::uint64 addr = mem.getAddress();
-        triton::uint32 size = mem.getSize();
+      bool TaintEngine::isLabelsEnabled(void) const {
+        return this->labelsFlag;
+      }
+
+
+      void TaintEngine::enableLabels(bool flag) {
+        if (this->labelsFlag == flag)
+          return;
+
+        if (this->snapshotFlag)
+          throw std::runtime_error("TaintEngine::enableLabels(): Cannot switch the labels while a snapshot is taken.");
 
-        for (triton::uint32 index = 0; index < size; index++) {
-          if (this->taintedAddresses.find(addr+index) != this->taintedAddresses.end())
-            return TAINTED;
+        this->labelsFlag = flag;
+        if (!flag) {
+          this->labelSets.clear();
+          this->addressLabels.clear();
+          this->registerLabels.assign(this->registerLabels.size(), triton::engines::taint::EMPTY_LABELS);
         }
-        return !TAINTED;
+      }
+
+
+      /* Returns the labels which reach [addr:size] */
+      std::set<triton::uint32> TaintEngine::getTaintLabels(triton::uint64 addr, triton::uint32 size) {
+        const std::vector<triton::uint32>& labels = this->labelSets.getLabels(this->getAddressLabels(addr, size));
+        return std::set<triton::uint32>(labels.begin(), labels.end());
+      }
+
+
+      /* Returns the labels which reach the memory */
+      std::set<triton::uint32> TaintEngine::getTaintLabels(const triton::arch::MemoryOperand& mem) {
+        return this->getTaintLabels(mem.getAddress(), mem.getSize());
+      }
+
+
+      /* Returns the labels which reach the register */
+      std::set<triton::uint32> TaintEngine::getTaintLabels(const triton::arch::RegisterOperand& reg) {
+        const std::vector<triton::uint32>& labels = this->labelSets.getLabels(this->getRegisterLabels(reg));
+        return std::set<triton::uint32>(labels.begin(), labels.end());
+      }
+
+
+      /* Returns true of false if the memory address is currently tainted */
+      bool TaintEngine::isMemoryTainted(const triton::arch::MemoryOperand& mem) const {
+        return this->taintedAddresses.isTainted(mem.getAddress(), mem.getSize());
       }
 
 
       /* Returns true of false if the address is currently tainted */
       bool TaintEngine::isMemoryTainted(triton::uint64 addr, triton::uint32 size) const {
-        for (triton::uint32 index = 0; index < size; index++) {
-          if (this->taintedAddresses.find(addr+index) != this->taintedAddresses.end())
-            return TAINTED;
-        }
-        return !TAINTED;
+        return this->taintedAddresses.isTainted(addr, size);
       }
 
 
@@ -174,7 +435,7 @@ namespace triton {
       bool TaintEngine::isRegisterTainted(const triton::arch::RegisterOperand& reg) const {
         triton::uint32 parentId = reg.getParent().getId();
 
-        if (this->taintedRegisters[parentId])
+        if (this->taintedRegisters[parentId] & getRegisterMask(reg))
           return true;
 
         return false;
@@ -186,12 +447,28 @@ namespace triton {
         triton::uint32 parentId = reg.getParent().getId();
 
         if (this->isEnabled())
-          this->taintedRegisters[parentId] = TAINTED;
+          this->setRegisterTaint(parentId, this->taintedRegisters[parentId] | getRegisterMask(reg));
 
-        if (this->taintedRegisters[parentId])
-          return true;
+        return this->isRegisterTainted(reg);
+      }
 
-        return false;
+
+      /* Taint the register with a label */
+      bool TaintEngine::taintRegister(const triton::arch::RegisterOperand& reg, triton::uint32 label) {
+        triton::uint32 parentId = reg.getParent().getId();
+
+        if (!this->isEnabled())
+          return this->isRegisterTainted(reg);
+
+        this->taintRegister(reg);
+        if (this->labelsFlag) {
+          for (triton::uint32 byte = reg.getLow() / BYTE_SIZE_BIT; byte <= reg.getHigh() / BYTE_SIZE_BIT; byte++) {
+            triton::uint32 set = this->registerLabels[parentId * DQQWORD_SIZE + byte];
+            this->setRegisterLabels(parentId, byte, this->labelSets.getUnion(set, this->labelSets.getSet(label)));
+          }
+        }
+
+        return TAINTED;
       }
 
 
@@ -212,15 +489,46 @@ namespace triton {
 
       /* Set the taint on register */
       bool TaintEngine::setTaintRegister(const triton::arch::RegisterOperand& reg, bool flag) {
+        if (flag == TAINTED)
+          return this->taintRegister(reg);
+        return this->untaintRegister(reg);
+      }
+
+
+      /* Set the taint on memory with the labels read by the instruction */
+      bool TaintEngine::setTaintMemory(const triton::arch::Instruction& inst, const triton::arch::MemoryOperand& mem, bool flag) {
+        triton::uint64 addr = mem.getAddress();
+        triton::uint32 size = mem.getSize();
+
+        if (!this->isEnabled() || flag == !TAINTED)
+          return this->setTaintMemory(mem, flag);
+
+        triton::uint32 labels = this->getInstructionLabels(inst);
+        this->taintMemory(mem);
+        if (this->labelsFlag) {
+          for (triton::uint32 index = 0; index < size; index++)
+            this->setAddressLabels(addr + index, labels);
+        }
+
+        return TAINTED;
+      }
+
+
+      /* Set the taint on register with the labels read by the instruction */
+      bool TaintEngine::setTaintRegister(const triton::arch::Instruction& inst, const triton::arch::RegisterOperand& reg, bool flag) {
         triton::uint32 parentId = reg.getParent().getId();
 
-        if (this->isEnabled())
-          this->taintedRegisters[parentId] = flag;
+        if (!this->isEnabled() || flag == !TAINTED)
+          return this->setTaintRegister(reg, flag);
 
-        if (this->taintedRegisters[parentId])
-          return true;
+        triton::uint32 labels = this->getInstructionLabels(inst);
+        this->taintRegister(reg);
+        if (this->labelsFlag) {
+          for (triton::uint32 byte = reg.getLow() / BYTE_SIZE_BIT; byte <= reg.getHigh() / BYTE_SIZE_BIT; byte++)
+            this->setRegisterLabels(parentId, byte, labels);
+        }
 
-        return false;
+        return TAINTED;
       }
 
 
@@ -229,12 +537,9 @@ namespace triton {
         triton::uint32 parentId = reg.getParent().getId();
 
         if (this->isEnabled())
-          this->taintedRegisters[parentId] = !TAINTED;
-
-        if (this->taintedRegisters[parentId])
-          return true;
+          this->setRegisterTaint(parentId, this->taintedRegisters[parentId] & ~getRegisterMask(reg));
 
-        return false;
+        return this->isRegisterTainted(reg);
       }
 
 
@@ -246,8 +551,7 @@ namespace triton {
         if (!this->isEnabled())
           return this->isMemoryTainted(mem);
 
-        for (triton::uint32 index = 0; index < size; index++)
-          this->taintedAddresses[addr+index] = TAINTED;
+        this->setAddressTaint(addr, size, triton::engines::taint::maskOf(size));
 
         return TAINTED;
       }
@@ -256,8 +560,39 @@ namespace triton {
       /* Taint the address */
       bool TaintEngine::taintMemory(triton::uint64 addr) {
         if (this->isEnabled())
-          this->taintedAddresses[addr] = TAINTED;
-        return this->taintedAddresses[addr];
+          this->setAddressTaint(addr, BYTE_SIZE, triton::engines::taint::maskOf(BYTE_SIZE));
+        return this->isMemoryTainted(addr);
+      }
+
+
+      /* Taint the memory with a label */
+      bool TaintEngine::taintMemory(const triton::arch::MemoryOperand& mem, triton::uint32 label) {
+        triton::uint64 addr = mem.getAddress();
+        triton::uint32 size = mem.getSize();
+
+        if (!this->isEnabled())
+          return this->isMemoryTainted(mem);
+
+        this->taintMemory(mem);
+        if (this->labelsFlag) {
+          for (triton::uint32 index = 0; index < size; index++)
+            this->setAddressLabels(addr + index, this->labelSets.getUnion(this->addressLabels.get(addr + index), this->labelSets.getSet(label)));
+        }
+
+        return TAINTED;
+      }
+
+
+      /* Taint the address with a label */
+      bool TaintEngine::taintMemory(triton::uint64 addr, triton::uint32 label) {
+        if (!this->isEnabled())
+          return this->isMemoryTainted(addr);
+
+        this->taintMemory(addr);
+        if (this->labelsFlag)
+          this->setAddressLabels(addr, this->labelSets.getUnion(this->addressLabels.get(addr), this->labelSets.getSet(label)));
+
+        return TAINTED;
       }
 
 
@@ -269,8 +604,7 @@ namespace triton {
         if (!this->isEnabled())
           return this->isMemoryTainted(mem);
 
-        for (triton::uint32 index = 0; index < size; index++)
-          this->taintedAddresses.erase(addr+index);
+        this->setAddressTaint(addr, size, 0);
 
         return !TAINTED;
       }
@@ -280,7 +614,7 @@ namespace triton {
       bool TaintEngine::untaintMemory(triton::uint64 addr) {
         if (!this->isEnabled())
           return this->isMemoryTainted(addr);
-        this->taintedAddresses.erase(addr);
+        this->setAddressTaint(addr, BYTE_SIZE, 0);
         return !TAINTED;
       }
 
@@ -293,13 +627,7 @@ namespace triton {
         if (!this->isEnabled())
           return this->isRegisterTainted(regDst);
 
-        if (this->isRegisterTainted(regSrc)) {
-          this->taintRegister(regDst);
-          return TAINTED;
-        }
-
-        this->untaintRegister(regDst);
-        return !TAINTED;
+        return this->writeRegisterTaint(regDst, this->isRegisterTainted(regSrc), this->getRegisterLabels(regSrc));
       }
 
 
@@ -310,8 +638,7 @@ namespace triton {
       bool TaintEngine::assignmentRegisterImmediate(const triton::arch::RegisterOperand& regDst) {
         if (!this->isEnabled())
           return this->isRegisterTainted(regDst);
-        this->untaintRegister(regDst);
-        return !TAINTED;
+        return this->writeRegisterTaint(regDst, !TAINTED);
       }
 
 
@@ -323,36 +650,35 @@ namespace triton {
         if (!this->isEnabled())
           return this->isRegisterTainted(regDst);
 
-        if (this->isMemoryTainted(memSrc)) {
-          this->taintRegister(regDst);
-          return TAINTED;
-        }
-
-        this->untaintRegister(regDst);
-        return !TAINTED;
+        return this->writeRegisterTaint(regDst, this->isMemoryTainted(memSrc), this->getAddressLabels(memSrc.getAddress(), memSrc.getSize()));
       }
 
 
       /*
-       * Spread the taint in memDst if memSrc is tainted.
+       * Spread the taint of each byte of memSrc in memDst.
        * Returns true if a spreading occurs otherwise returns false.
        */
       bool TaintEngine::assignmentMemoryMemory(const triton::arch::MemoryOperand& memDst, const triton::arch::MemoryOperand& memSrc) {
-        bool isTainted          = !TAINTED;
         triton::uint32 readSize = memSrc.getSize();
-        triton::uint64 addrSrc  = memSrc.getAddress();
-        triton::uint64 addrDst  = memDst.getAddress();
+        triton::uint64 taint    = 0;
 
         if (!this->isEnabled())
           return this->isMemoryTainted(memDst);
 
-        for (triton::uint32 offset = 0; offset < readSize; offset++) {
-          if (this->isMemoryTainted(addrSrc+offset)) {
-            this->taintMemory(addrDst+offset);
-            isTainted = TAINTED;
+        taint = this->taintedAddresses.get(memSrc.getAddress(), readSize);
+        this->setAddressTaint(memDst.getAddress(), readSize, taint);
+
+        if (taint && this->labelsFlag) {
+          for (triton::uint32 offset = 0; offset < readSize; offset++) {
+            if ((taint >> offset) & 1)
+              this->setAddressLabels(memDst.getAddress() + offset, this->addressLabels.get(memSrc.getAddress() + offset));
           }
         }
-        return isTainted;
+
+        if (taint)
+          return TAINTED;
+
+        return !TAINTED;
       }
 
 
@@ -378,7 +704,12 @@ namespace triton {
 
         /* Check source */
         if (this->isRegisterTainted(regSrc)) {
+          triton::uint32 labels = this->getRegisterLabels(regSrc);
           this->taintMemory(memDst);
+          if (this->labelsFlag) {
+            for (triton::uint32 offset = 0; offset < memDst.getSize(); offset++)
+              this->setAddressLabels(memDst.getAddress() + offset, labels);
+          }
           return TAINTED;
         }
 
@@ -394,7 +725,7 @@ namespace triton {
       bool TaintEngine::unionRegisterImmediate(const triton::arch::RegisterOperand& regDst) {
         if (!this->isEnabled())
           return this->isRegisterTainted(regDst);
-        return this->isRegisterTainted(regDst);
+        return this->writeRegisterTaint(regDst, this->isRegisterTainted(regDst), this->getRegisterLabels(regDst));
       }
 
 
@@ -406,42 +737,37 @@ namespace triton {
         if (!this->isEnabled())
           return this->isRegisterTainted(regDst);
 
-        if (this->isRegisterTainted(regSrc)) {
-          this->taintRegister(regDst);
-          return TAINTED;
-        }
-
-        return this->isRegisterTainted(regDst);
+        triton::uint32 labels = this->labelSets.getUnion(this->getRegisterLabels(regSrc), this->getRegisterLabels(regDst));
+        return this->writeRegisterTaint(regDst, this->isRegisterTainted(regSrc) || this->isRegisterTainted(regDst), labels);
       }
 
 
       /*
-       * If the MemSrc is tainted we taint the memDst, otherwise
-       * we check if memDst is tainted and returns the status.
+       * Each byte of memDst is tainted if the same byte of memSrc is tainted,
+       * then we check if memDst is tainted and returns the status.
        */
       bool TaintEngine::unionMemoryMemory(const triton::arch::MemoryOperand& memDst, const triton::arch::MemoryOperand& memSrc) {
-        bool tainted             = !TAINTED;
         triton::uint32 writeSize = memDst.getSize();
         triton::uint64 addrDst   = memDst.getAddress();
-        triton::uint64 addrSrc   = memSrc.getAddress();
+        triton::uint64 taint     = 0;
 
         if (!this->isEnabled())
           return this->isMemoryTainted(memDst);
 
-        /* Check source */
-        for (triton::uint32 offset = 0; offset < writeSize; offset++) {
-          if (this->isMemoryTainted(addrSrc+offset)) {
-            this->taintMemory(addrDst+offset);
-            tainted = TAINTED;
+        taint = this->taintedAddresses.get(addrDst, writeSize) | this->taintedAddresses.get(memSrc.getAddress(), writeSize);
+        this->setAddressTaint(addrDst, writeSize, taint);
+
+        if (taint && this->labelsFlag) {
+          for (triton::uint32 offset = 0; offset < writeSize; offset++) {
+            triton::uint32 labels = this->addressLabels.get(memSrc.getAddress() + offset);
+            this->setAddressLabels(addrDst + offset, this->labelSets.getUnion(this->addressLabels.get(addrDst + offset), labels));
           }
         }
 
-        /* Check destination */
-        if (this->isMemoryTainted(memDst)) {
+        if (taint)
           return TAINTED;
-        }
 
-        return tainted;
+        return !TAINTED;
       }
 
 
@@ -453,12 +779,8 @@ namespace triton {
         if (!this->isEnabled())
           return this->isRegisterTainted(regDst);
 
-        if (this->isMemoryTainted(memSrc)) {
-          this->taintRegister(regDst);
-          return TAINTED;
-        }
-
-        return this->isRegisterTainted(regDst);
+        triton::uint32 labels = this->labelSets.getUnion(this->getAddressLabels(memSrc.getAddress(), memSrc.getSize()), this->getRegisterLabels(regDst));
+        return this->writeRegisterTaint(regDst, this->isMemoryTainted(memSrc) || this->isRegisterTainted(regDst), labels);
       }
 
 
@@ -481,7 +803,12 @@ namespace triton {
           return this->isMemoryTainted(memDst);
 
         if (this->isRegisterTainted(regSrc)) {
+          triton::uint32 labels = this->getRegisterLabels(regSrc);
           this->taintMemory(memDst);
+          if (this->labelsFlag) {
+            for (triton::uint32 offset = 0; offset < memDst.getSize(); offset++)
+              this->setAddressLabels(memDst.getAddress() + offset, this->labelSets.getUnion(this->addressLabels.get(memDst.getAddress() + offset), labels));
+          }
           return TAINTED;
         }
 
@@ -494,4 +821,3 @@ namespace triton {
     }; /* taint namespace */
   }; /* engines namespace */
 }; /* triton namespace */
-
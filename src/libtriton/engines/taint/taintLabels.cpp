@@ -0,0 +1,155 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+#include <taintLabels.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace taint {
+
+      TaintLabelSets::TaintLabelSets() {
+        this->clear();
+      }
+
+
+      void TaintLabelSets::clear(void) {
+        this->sets.clear();
+        this->ids.clear();
+        this->unions.clear();
+        this->intern(std::vector<triton::uint32>());
+      }
+
+
+      /* FNV-1a over the labels, followed by a final mix of the bits */
+      triton::uint64 TaintLabelSets::hashLabels(const std::vector<triton::uint32>& labels) {
+        triton::uint64 hash = 0xcbf29ce484222325;
+
+        for (triton::usize index = 0; index < labels.size(); index++)
+          hash = (hash ^ labels[index]) * 0x100000001b3;
+
+        hash ^= hash >> 33;
+        hash *= 0xff51afd7ed558ccd;
+        hash ^= hash >> 33;
+
+        return hash;
+      }
+
+
+      triton::uint32 TaintLabelSets::intern(const std::vector<triton::uint32>& labels) {
+        triton::uint64 hash = this->hashLabels(labels);
+        auto range = this->ids.equal_range(hash);
+
+        for (auto it = range.first; it != range.second; it++) {
+          if (this->sets[it->second] == labels)
+            return it->second;
+        }
+
+        triton::uint32 id = static_cast<triton::uint32>(this->sets.size());
+        this->sets.push_back(labels);
+        this->ids.insert(std::make_pair(hash, id));
+
+        return id;
+      }
+
+
+      triton::uint32 TaintLabelSets::getSet(triton::uint32 label) {
+        return this->intern(std::vector<triton::uint32>(1, label));
+      }
+
+
+      triton::uint32 TaintLabelSets::getUnion(triton::uint32 set1, triton::uint32 set2) {
+        if (set1 == set2 || set2 == triton::engines::taint::EMPTY_LABELS)
+          return set1;
+
+        if (set1 == triton::engines::taint::EMPTY_LABELS)
+          return set2;
+
+        triton::uint64 key = (static_cast<triton::uint64>(std::min(set1, set2)) << 32) | std::max(set1, set2);
+        auto it = this->unions.find(key);
+        if (it != this->unions.end())
+          return it->second;
+
+        const std::vector<triton::uint32>& labels1 = this->getLabels(set1);
+        const std::vector<triton::uint32>& labels2 = this->getLabels(set2);
+        std::vector<triton::uint32> labels;
+
+        labels.reserve(labels1.size() + labels2.size());
+        std::set_union(labels1.begin(), labels1.end(), labels2.begin(), labels2.end(), std::back_inserter(labels));
+
+        triton::uint32 id = this->intern(labels);
+        this->unions[key] = id;
+
+        return id;
+      }
+
+
+      const std::vector<triton::uint32>& TaintLabelSets::getLabels(triton::uint32 set) const {
+        if (set >= this->sets.size())
+          throw std::invalid_argument("TaintLabelSets::getLabels(): Invalid label set id.");
+        return this->sets[set];
+      }
+
+
+      triton::usize TaintLabelSets::getNumberOfSets(void) const {
+        return this->sets.size();
+      }
+
+
+      TaintLabelPage::TaintLabelPage() {
+        for (triton::uint32 index = 0; index < MEMORY_PAGE_SIZE; index++)
+          this->sets[index] = triton::engines::taint::EMPTY_LABELS;
+        this->count = 0;
+      }
+
+
+      void TaintLabelMemory::clear(void) {
+        this->pages.clear();
+      }
+
+
+      triton::uint32 TaintLabelMemory::get(triton::uint64 addr) const {
+        auto it = this->pages.find(addr & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK));
+
+        if (it == this->pages.end())
+          return triton::engines::taint::EMPTY_LABELS;
+
+        return it->second.sets[addr & MEMORY_PAGE_MASK];
+      }
+
+
+      void TaintLabelMemory::set(triton::uint64 addr, triton::uint32 set) {
+        triton::uint64 base = addr & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK);
+        auto it = this->pages.find(base);
+
+        if (it == this->pages.end()) {
+          if (set == triton::engines::taint::EMPTY_LABELS)
+            return;
+          it = this->pages.insert(std::make_pair(base, TaintLabelPage())).first;
+        }
+
+        TaintLabelPage& page = it->second;
+        triton::uint32& slot = page.sets[addr & MEMORY_PAGE_MASK];
+
+        if (slot == triton::engines::taint::EMPTY_LABELS && set != triton::engines::taint::EMPTY_LABELS)
+          page.count++;
+        else if (slot != triton::engines::taint::EMPTY_LABELS && set == triton::engines::taint::EMPTY_LABELS)
+          page.count--;
+
+        slot = set;
+        if (page.count == 0)
+          this->pages.erase(it);
+      }
+
+    }; /* taint namespace */
+  }; /* engines namespace */
+}; /* triton namespace */
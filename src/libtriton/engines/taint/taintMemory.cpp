@@ -0,0 +1,180 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#include <algorithm>
+
+#include <taintMemory.hpp>
+
+
+
+namespace triton {
+  namespace engines {
+    namespace taint {
+
+      /* Returns the number of bits set */
+      static triton::uint32 bitCount(triton::uint64 value) {
+        triton::uint32 count = 0;
+        for (; value; count++)
+          value &= value - 1;
+        return count;
+      }
+
+
+      TaintMemoryPage::TaintMemoryPage() {
+        for (triton::uint32 index = 0; index < MEMORY_PAGE_SIZE / TAINT_WORD_BIT; index++)
+          this->bits[index] = 0;
+        this->count = 0;
+      }
+
+
+      triton::uint64 TaintMemoryPage::getBits(triton::uint32 offset, triton::uint32 size) const {
+        triton::uint32 word  = offset / TAINT_WORD_BIT;
+        triton::uint32 shift = offset % TAINT_WORD_BIT;
+        triton::uint64 ret   = this->bits[word] >> shift;
+
+        /* The range spans two words */
+        if (shift && shift + size > TAINT_WORD_BIT)
+          ret |= this->bits[word + 1] << (TAINT_WORD_BIT - shift);
+
+        return ret & maskOf(size);
+      }
+
+
+      void TaintMemoryPage::setBits(triton::uint32 offset, triton::uint32 size, triton::uint64 value) {
+        triton::uint32 word  = offset / TAINT_WORD_BIT;
+        triton::uint32 shift = offset % TAINT_WORD_BIT;
+        triton::uint64 mask  = maskOf(size) << shift;
+
+        value &= maskOf(size);
+
+        this->count -= bitCount(this->bits[word] & mask);
+        this->bits[word] = (this->bits[word] & ~mask) | (value << shift);
+        this->count += bitCount(this->bits[word] & mask);
+
+        /* The range spans two words */
+        if (shift && shift + size > TAINT_WORD_BIT) {
+          mask  = maskOf(shift + size - TAINT_WORD_BIT);
+          value = value >> (TAINT_WORD_BIT - shift);
+          this->count -= bitCount(this->bits[word + 1] & mask);
+          this->bits[word + 1] = (this->bits[word + 1] & ~mask) | value;
+          this->count += bitCount(this->bits[word + 1] & mask);
+        }
+      }
+
+
+      TaintMemory::TaintMemory() {
+        this->lastPageBase = 0;
+        this->lastPage     = nullptr;
+      }
+
+
+      TaintMemory::TaintMemory(const TaintMemory& copy) {
+        this->pages        = copy.pages;
+        this->lastPageBase = 0;
+        this->lastPage     = nullptr;
+      }
+
+
+      TaintMemory::~TaintMemory() {
+        this->clear();
+      }
+
+
+      void TaintMemory::operator=(const TaintMemory& copy) {
+        this->pages        = copy.pages;
+        this->lastPageBase = 0;
+        this->lastPage     = nullptr;
+      }
+
+
+      void TaintMemory::clear(void) {
+        this->pages.clear();
+        this->lastPageBase = 0;
+        this->lastPage     = nullptr;
+      }
+
+
+      TaintMemoryPage* TaintMemory::getPage(triton::uint64 addr) {
+        triton::uint64 base = addr & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK);
+
+        if (this->lastPage != nullptr && this->lastPageBase == base)
+          return this->lastPage;
+
+        this->lastPageBase = base;
+        this->lastPage     = &this->pages[base];
+
+        return this->lastPage;
+      }
+
+
+      triton::uint64 TaintMemory::get(triton::uint64 addr, triton::uint32 size) const {
+        triton::uint64 ret = 0;
+        triton::uint32 done = 0;
+
+        while (done < size) {
+          triton::uint64 cur    = addr + done;
+          triton::uint32 offset = cur & MEMORY_PAGE_MASK;
+          triton::uint32 chunk  = std::min(size - done, static_cast<triton::uint32>(MEMORY_PAGE_SIZE - offset));
+
+          auto it = this->pages.find(cur & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK));
+          if (it != this->pages.end())
+            ret |= it->second.getBits(offset, chunk) << done;
+
+          done += chunk;
+        }
+
+        return ret;
+      }
+
+
+      void TaintMemory::set(triton::uint64 addr, triton::uint32 size, triton::uint64 mask) {
+        triton::uint32 done = 0;
+
+        while (done < size) {
+          triton::uint64 cur    = addr + done;
+          triton::uint64 base   = cur & ~static_cast<triton::uint64>(MEMORY_PAGE_MASK);
+          triton::uint32 offset = cur & MEMORY_PAGE_MASK;
+          triton::uint32 chunk  = std::min(size - done, static_cast<triton::uint32>(MEMORY_PAGE_SIZE - offset));
+          triton::uint64 value  = (mask >> done) & maskOf(chunk);
+
+          done += chunk;
+
+          /* Do not allocate a page to untaint it */
+          if (value == 0 && (this->lastPage == nullptr || this->lastPageBase != base)) {
+            auto it = this->pages.find(base);
+            if (it == this->pages.end())
+              continue;
+          }
+
+          TaintMemoryPage* page = this->getPage(cur);
+          page->setBits(offset, chunk, value);
+
+          if (page->count == 0) {
+            this->pages.erase(base);
+            this->lastPage = nullptr;
+          }
+        }
+      }
+
+
+      bool TaintMemory::isTainted(triton::uint64 addr, triton::usize size) const {
+        for (triton::usize index = 0; index < size; index += TAINT_WORD_BIT) {
+          triton::uint32 chunk = static_cast<triton::uint32>(std::min(size - index, static_cast<triton::usize>(TAINT_WORD_BIT)));
+          if (this->get(addr + index, chunk))
+            return true;
+        }
+        return false;
+      }
+
+
+      triton::usize TaintMemory::getNumberOfPages(void) const {
+        return this->pages.size();
+      }
+
+    }; /* taint namespace */
+  }; /* engines namespace */
+}; /* triton namespace */
@@ -133,6 +133,9 @@ namespace triton {
         //! [**architecture api**] - Returns the concrete value of a memory area.
         std::vector<triton::uint8> getConcreteMemoryAreaValue(triton::uint64 baseAddr, triton::usize size) const;
 
+        //! [**architecture api**] - Returns a read-only view on the memory area starting at `baseAddr` without copying it. `size` is set to the number of readable bytes (zero and nullptr if unmapped). The view never crosses a page of `MEMORY_PAGE_SIZE` bytes.
+        const triton::uint8* getConcreteMemoryAreaView(triton::uint64 baseAddr, triton::usize& size) const;
+
         //! [**architecture api**] - Returns the concrete value of a register.
         triton::uint512 getConcreteRegisterValue(const triton::arch::RegisterOperand& reg) const;
 
@@ -190,6 +193,17 @@ namespace triton {
         //! [**proccesing api**] - The main function. This function processes everything (engine, IR, optimization, state, ...) from a given instruction.
         void processing(triton::arch::Instruction& inst);
 
+        /*!
+         * \brief [**proccesing api**] - Processes the basic block starting at `addr`.
+         *
+         * \description The instructions of `opcodes` are disassembled and their semantics built until the first
+         * control flow instruction or the end of the buffer. The register and flag expressions overwritten inside
+         * the block before being used are removed, only the live-out expressions of the block remain. With the
+         * `AST_GARBAGE_COLLECTION` optimization, the nodes held by the instructions of the block are pinned while it
+         * is processed, so they survive the collections. Returns the instructions of the block.
+         */
+        std::vector<triton::arch::Instruction> processBasicBlock(const triton::uint8* opcodes, triton::usize size, triton::uint64 addr);
+
         //! [**proccesing api**] - Initialize everything.
         void initEngines(void);
 
@@ -206,6 +220,12 @@ namespace triton {
         //! [**AST garbage collector api**] - Raises an exception if the AST garbage collector interface is not initialized.
         void checkAstGarbageCollector(void) const;
 
+        //! [**AST garbage collector api**] - Allocates the memory of a node from the slabs of the AST garbage collector.
+        void* allocateAstNode(triton::usize size);
+
+        //! [**AST garbage collector api**] - Gives back the memory of a node to the slabs of the AST garbage collector.
+        void deallocateAstNode(void* ptr);
+
         //! [**AST garbage collector api**] - Go through every allocated nodes and free them.
         void freeAllAstNodes(void);
 
@@ -215,6 +235,33 @@ namespace triton {
         //! [**AST garbage collector api**] - Extracts all unique nodes from a partial AST into the uniqueNodes set.
         void extractUniqueAstNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, triton::ast::AbstractNode* root) const;
 
+        //! [**AST garbage collector api**] - Starts a new epoch of nodes and returns its mark.
+        triton::usize markAstNodes(void);
+
+        //! [**AST garbage collector api**] - Frees every recorded node allocated since the mark. No symbolic expression must point to these nodes anymore.
+        void freeAstNodesSinceMark(triton::usize mark);
+
+        //! [**AST garbage collector api**] - Logs the child `index` of a node before it is rewritten, so that freeAstNodesSinceMark() can restore it.
+        void logChildAstNode(triton::ast::AbstractNode* node, triton::uint32 index);
+
+        //! [**AST garbage collector api**] - Links a node to one of its parents.
+        void linkParentAstNode(triton::ast::AbstractNode* node, triton::ast::AbstractNode* parent);
+
+        //! [**AST garbage collector api**] - Unlinks a node from one of its parents.
+        void unlinkParentAstNode(triton::ast::AbstractNode* node, triton::ast::AbstractNode* parent);
+
+        //! [**AST garbage collector api**] - Returns the parents of a node.
+        std::set<triton::ast::AbstractNode*> getParentAstNodes(triton::ast::AbstractNode* node);
+
+        //! [**AST garbage collector api**] - Pins a node. A pinned node and its childs are never freed by a collection.
+        void pinAstNode(triton::ast::AbstractNode* node);
+
+        //! [**AST garbage collector api**] - Unpins a node.
+        void unpinAstNode(triton::ast::AbstractNode* node);
+
+        //! [**AST garbage collector api**] - Frees every recorded node which is not reachable anymore. Returns the number of freed nodes. Nodes of live symbolic expressions are always reachable.
+        triton::usize collectAstNodes(void);
+
         //! [**AST garbage collector api**] - Records the allocated node or returns the same node if it already exists inside the dictionaries.
         triton::ast::AbstractNode* recordAstNode(triton::ast::AbstractNode* node);
 
@@ -222,7 +269,7 @@ namespace triton {
         void recordVariableAstNode(const std::string& name, triton::ast::AbstractNode* node);
 
         //! [**AST garbage collector api**] - Returns all allocated nodes.
-        const std::set<triton::ast::AbstractNode*>& getAllocatedAstNodes(void) const;
+        std::set<triton::ast::AbstractNode*> getAllocatedAstNodes(void) const;
 
         //! [**AST garbage collector api**] - Returns all variable nodes recorded.
         const std::map<std::string, triton::ast::AbstractNode*>& getAstVariableNodes(void) const;
@@ -236,6 +283,18 @@ namespace triton {
         //! [**AST garbage collector api**] - Sets all variable nodes recorded.
         void setAstVariableNodes(const std::map<std::string, triton::ast::AbstractNode*>& nodes);
 
+        //! [**AST garbage collector api**] - Returns a new hole of `size` bits for an AST template.
+        triton::ast::AbstractNode* newAstTemplateHole(triton::uint32 size);
+
+        //! [**AST garbage collector api**] - Returns the template recorded for `key`. Nullptr if there is none.
+        const triton::ast::AstTemplate* getAstTemplate(triton::uint64 key) const;
+
+        //! [**AST garbage collector api**] - Records a template for `key` and returns it.
+        const triton::ast::AstTemplate* recordAstTemplate(triton::uint64 key, const triton::ast::AstTemplate& tpl);
+
+        //! [**AST garbage collector api**] - Forgets all the templates.
+        void clearAstTemplates(void);
+
 
 
         /* AST Representation API ======================================================================== */
@@ -331,9 +390,21 @@ namespace triton {
         //! [**symbolic api**] - Returns a new symbolic variable.
         triton::engines::symbolic::SymbolicVariable* newSymbolicVariable(triton::uint32 varSize, const std::string& comment="");
 
+        //! [**symbolic api**] - Extracts the roots of the ASTs still used by the symbolic engine.
+        void extractAstRoots(std::vector<triton::ast::AbstractNode*>& roots) const;
+
         //! [**symbolic api**] - Removes the symbolic expression corresponding to the id.
         void removeSymbolicExpression(triton::usize symExprId);
 
+        //! [**symbolic api**] - Holds a symbolic expression, it stays valid once removed from the symbolic engine. \sa triton::engines::symbolic::SymbolicEngine::holdSymbolicExpression().
+        void holdSymbolicExpression(triton::engines::symbolic::SymbolicExpression* se);
+
+        //! [**symbolic api**] - Releases a symbolic expression held by holdSymbolicExpression().
+        void releaseSymbolicExpression(triton::engines::symbolic::SymbolicExpression* se);
+
+        //! [**symbolic api**] - Removes the symbolic expressions which are not live anymore. With the `AST_GARBAGE_COLLECTION` optimization, their AST nodes are collected. Returns the number of expressions removed. \sa triton::engines::symbolic::SymbolicEngine::removeDeadSymbolicExpressions().
+        triton::usize removeDeadSymbolicExpressions(void);
+
         //! [**symbolic api**] - Returns the new symbolic abstract expression and links this expression to the instruction.
         triton::engines::symbolic::SymbolicExpression* createSymbolicExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, triton::arch::OperandWrapper& dst, const std::string& comment="");
 
@@ -346,6 +417,9 @@ namespace triton {
         //! [**symbolic api**] - Returns the new symbolic flag expression and links this expression to the instruction.
         triton::engines::symbolic::SymbolicExpression* createSymbolicFlagExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, triton::arch::RegisterOperand& flag, const std::string& comment="");
 
+        //! [**symbolic api**] - Returns a new lazy symbolic flag expression and links this expression to the instruction. Its AST is built on its first use.
+        triton::engines::symbolic::SymbolicExpression* createSymbolicLazyFlagExpression(triton::arch::Instruction& inst, triton::engines::symbolic::LazyAst* lazy, triton::uint512 value, triton::arch::RegisterOperand& flag, const std::string& comment="");
+
         //! [**symbolic api**] - Returns the new symbolic volatile expression and links this expression to the instruction.
         triton::engines::symbolic::SymbolicExpression* createSymbolicVolatileExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, const std::string& comment="");
 
@@ -374,6 +448,9 @@ namespace triton {
         //! [**symbolic api**] - Browses AST Dictionaries if the optimization `AST_DICTIONARIES` is enabled.
         triton::ast::AbstractNode* browseAstDictionaries(triton::ast::AbstractNode* node);
 
+        //! [**symbolic api**] - Removes nodes which are about to be freed from the AST Dictionaries.
+        void removeAstDictionariesNodes(const std::set<triton::ast::AbstractNode*>& nodes);
+
         //! [**symbolic api**] - Returns all stats about AST Dictionaries.
         std::map<std::string, triton::usize> getAstDictionariesStats(void);
 
@@ -395,6 +472,15 @@ namespace triton {
         //! [**symbolic api**] - Returns the logical conjunction AST of path constraints.
         triton::ast::AbstractNode* getPathConstraintsAst(void);
 
+        //! [**symbolic api**] - Returns the indexes of the path constraints before `limit` which share symbolic variables with `node`, directly or through other path constraints.
+        std::vector<triton::usize> getRelevantPathConstraints(triton::ast::AbstractNode* node, triton::usize limit);
+
+        //! [**symbolic api**] - Returns the logical conjunction AST of the path constraints which share symbolic variables with `node`.
+        triton::ast::AbstractNode* getRelevantPathConstraintsAst(triton::ast::AbstractNode* node);
+
+        //! [**symbolic api**] - Returns a query without the taken path constraints of its conjunction which do not share symbolic variables with the rest of it.
+        triton::ast::AbstractNode* sliceQueryAst(triton::ast::AbstractNode* node);
+
         //! [**symbolic api**] - Adds a path constraint.
         void addPathConstraint(const triton::arch::Instruction& inst, triton::engines::symbolic::SymbolicExpression* expr);
 
@@ -440,11 +526,11 @@ namespace triton {
         //! [**symbolic api**] - Returns the partial AST from a symbolic expression id.
         triton::ast::AbstractNode* getAstFromId(triton::usize symExprId);
 
-        //! [**symbolic api**] - Returns the full AST of a root node.
-        triton::ast::AbstractNode* getFullAst(triton::ast::AbstractNode* node);
+        //! [**symbolic api**] - Returns the full AST of a root node. If `inplace` is false, the stored expressions are not modified and a new AST is returned.
+        triton::ast::AbstractNode* getFullAst(triton::ast::AbstractNode* node, bool inplace=true);
 
-        //! [**symbolic api**] - Returns the full AST from a symbolic expression id.
-        triton::ast::AbstractNode* getFullAstFromId(triton::usize symExprId);
+        //! [**symbolic api**] - Returns the full AST from a symbolic expression id. If `inplace` is false, the stored expressions are not modified and a new AST is returned.
+        triton::ast::AbstractNode* getFullAstFromId(triton::usize symExprId, bool inplace=true);
 
         //! [**symbolic api**] - Returns the list of the tainted symbolic expressions.
         std::list<triton::engines::symbolic::SymbolicExpression*> getTaintedSymbolicExpressions(void) const;
@@ -471,8 +557,10 @@ namespace triton {
          * \description
          * **item1**: symbolic variable id<br>
          * **item2**: model
+         *
+         * If `status` is not null, it receives the status of the query. If `timeout` (in milliseconds) is 0, the default timeout is used.
          */
-        std::map<triton::uint32, triton::engines::solver::SolverModel> getModel(triton::ast::AbstractNode *node) const;
+        std::map<triton::uint32, triton::engines::solver::SolverModel> getModel(triton::ast::AbstractNode *node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
 
         /*!
          * \brief [**solver api**] - Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned.
@@ -480,8 +568,52 @@ namespace triton {
          * \description
          * **item1**: symbolic variable id<br>
          * **item2**: model
+         *
+         * If `status` is not null, it receives the status of the last check. If `timeout` (in milliseconds) is 0, the default timeout is used.
          */
-        std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>> getModels(triton::ast::AbstractNode *node, triton::uint32 limit) const;
+        std::list<std::map<triton::uint32, triton::engines::solver::SolverModel>> getModels(triton::ast::AbstractNode *node, triton::uint32 limit, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
+
+        //! [**solver api**] - Enumerates the models of a symbolic constraint which differ on a set of symbolic variables and gives them to `callback` as soon as they are found. Returns the number of models.
+        triton::usize enumerateModels(triton::ast::AbstractNode *node, const std::set<triton::usize>& variables, const std::function<bool(const std::map<triton::uint32, triton::engines::solver::SolverModel>&)>& callback, triton::uint32 limit=0, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0) const;
+
+        //! [**solver api**] - Computes a model for each symbolic constraint of a batch. The queries are solved in parallel, an empty map means no model.
+        std::vector<std::map<triton::uint32, triton::engines::solver::SolverModel>> getModels(const std::vector<triton::ast::AbstractNode*>& nodes, std::vector<triton::engines::solver::status_e>* status=nullptr, triton::uint32 timeout=0);
+
+        //! [**solver api**] - Returns the number of worker threads used to solve a batch of queries.
+        triton::uint32 getSolverThreads(void) const;
+
+        //! [**solver api**] - Sets the number of worker threads used to solve a batch of queries.
+        void setSolverThreads(triton::uint32 threads);
+
+        //! [**solver api**] - Computes a model which follows the path constraints before `index` and takes another branch at `index`. The path constraints are kept in an incremental solver session.
+        std::map<triton::uint32, triton::engines::solver::SolverModel> getNegatedBranchModel(triton::usize index, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0);
+
+        //! [**solver api**] - Computes the model of getNegatedBranchModel() for every path constraint, in one pass.
+        std::vector<std::map<triton::uint32, triton::engines::solver::SolverModel>> getNegatedBranchesModels(void);
+
+        //! [**solver api**] - Returns the default timeout of a query in milliseconds.
+        triton::uint32 getSolverTimeout(void) const;
+
+        //! [**solver api**] - Sets the default timeout of a query in milliseconds (0 means no timeout).
+        void setSolverTimeout(triton::uint32 timeout);
+
+        //! [**solver api**] - Returns the memory limit of the solver in megabytes.
+        triton::uint32 getSolverMemoryLimit(void) const;
+
+        //! [**solver api**] - Sets the memory limit of the solver in megabytes (0 means no limit).
+        void setSolverMemoryLimit(triton::uint32 limit);
+
+        //! [**solver api**] - Returns the statistics of the last queries sent to the solver (see SolverEngine::getQueryStats()).
+        const std::list<std::map<std::string, triton::uint64>>& getSolverQueryStats(void) const;
+
+        //! [**solver api**] - Clears the statistics of the queries sent to the solver.
+        void clearSolverQueryStats(void);
+
+        //! [**solver api**] - Returns the hits and misses of the solver query cache (see the SOLVER_QUERY_CACHE optimization).
+        std::map<std::string, triton::usize> getSolverQueryCacheStats(void) const;
+
+        //! [**solver api**] - Clears the solver query cache.
+        void clearSolverQueryCache(void);
 
         //! [**solver api**] - Evaluates an AST via Z3 and returns the symbolic value.
         triton::uint512 evaluateAstViaZ3(triton::ast::AbstractNode *node) const;
@@ -517,6 +649,9 @@ namespace triton {
         //! [**taint api**] - Sets the flag (taint) to an abstract operand (Register or Memory).
         bool setTaint(const triton::arch::OperandWrapper& op, bool flag);
 
+        //! [**taint api**] - Sets the flag (taint) to an abstract operand (Register or Memory) written by an instruction. Tainted bytes get the labels of the operands read by the instruction.
+        bool setTaint(const triton::arch::Instruction& inst, const triton::arch::OperandWrapper& op, bool flag);
+
 
         //! [**taint api**] - Sets the flag (taint) to a memory.
         bool setTaintMemory(const triton::arch::MemoryOperand& mem, bool flag);
@@ -524,6 +659,12 @@ namespace triton {
         //! [**taint api**] - Sets the flag (taint) to a register.
         bool setTaintRegister(const triton::arch::RegisterOperand& reg, bool flag);
 
+        //! [**taint api**] - Sets the flag (taint) to a memory written by an instruction. Tainted bytes get the labels of the operands read by the instruction.
+        bool setTaintMemory(const triton::arch::Instruction& inst, const triton::arch::MemoryOperand& mem, bool flag);
+
+        //! [**taint api**] - Sets the flag (taint) to a register written by an instruction. Tainted bytes get the labels of the operands read by the instruction.
+        bool setTaintRegister(const triton::arch::Instruction& inst, const triton::arch::RegisterOperand& reg, bool flag);
+
         //! [**taint api**] - Taints an address.
         bool taintMemory(triton::uint64 addr);
 
@@ -533,6 +674,30 @@ namespace triton {
         //! [**taint api**] - Taints a register.
         bool taintRegister(const triton::arch::RegisterOperand& reg);
 
+        //! [**taint api**] - Taints an address with a label.
+        bool taintMemory(triton::uint64 addr, triton::uint32 label);
+
+        //! [**taint api**] - Taints a memory with a label.
+        bool taintMemory(const triton::arch::MemoryOperand& mem, triton::uint32 label);
+
+        //! [**taint api**] - Taints a register with a label.
+        bool taintRegister(const triton::arch::RegisterOperand& reg, triton::uint32 label);
+
+        //! [**taint api**] - Enables or disables the propagation of taint labels.
+        void enableTaintLabels(bool flag);
+
+        //! [**taint api**] - Returns true if the taint labels are propagated.
+        bool isTaintLabelsEnabled(void) const;
+
+        //! [**taint api**] - Returns the labels which reach the address:size.
+        std::set<triton::uint32> getTaintLabels(triton::uint64 addr, triton::uint32 size=1);
+
+        //! [**taint api**] - Returns the labels which reach the memory.
+        std::set<triton::uint32> getTaintLabels(const triton::arch::MemoryOperand& mem);
+
+        //! [**taint api**] - Returns the labels which reach the register.
+        std::set<triton::uint32> getTaintLabels(const triton::arch::RegisterOperand& reg);
+
         //! [**taint api**] - Untaints an address.
         bool untaintMemory(triton::uint64 addr);
 
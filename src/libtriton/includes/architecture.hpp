@@ -131,6 +131,9 @@ namespace triton {
         //! Returns the concrete value of a memory area.
         std::vector<triton::uint8> getConcreteMemoryAreaValue(triton::uint64 baseAddr, triton::usize size) const;
 
+        //! Returns a read-only view on the memory area starting at `baseAddr` without copying it. `size` is set to the number of readable bytes (zero and nullptr if unmapped).
+        const triton::uint8* getConcreteMemoryAreaView(triton::uint64 baseAddr, triton::usize& size) const;
+
         //! Returns the concrete value of a register.
         triton::uint512 getConcreteRegisterValue(const triton::arch::RegisterOperand& reg) const;
 
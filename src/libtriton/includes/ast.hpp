@@ -8,6 +8,7 @@
 #ifndef TRITON_AST_H
 #define TRITON_AST_H
 
+#include <cstddef>
 #include <list>
 #include <map>
 #include <ostream>
@@ -38,6 +39,129 @@ namespace triton {
    *  @{
    */
 
+    class AbstractNode;
+
+    //! Number of childs stored inside the node itself.
+    const triton::uint32 AST_INLINE_CHILDS = 3;
+
+    //! \class AstChilds
+    /*!
+     *  \brief The childs of a node.
+     *
+     *  \description
+     *  Unary, binary and ternary nodes keep their childs inline. Only n-ary nodes (concat, compound, ...)
+     *  spill them to the heap.
+     */
+    class AstChilds {
+      protected:
+        //! The childs. Points to `inlined` until there are more than AST_INLINE_CHILDS childs.
+        AbstractNode** childs;
+
+        //! The number of childs.
+        triton::uint32 count;
+
+        //! The number of childs which can be stored without reallocation.
+        triton::uint32 capacity;
+
+        //! The inline storage.
+        AbstractNode* inlined[AST_INLINE_CHILDS];
+
+      public:
+        //! Iterator over the childs.
+        typedef AbstractNode** iterator;
+
+        //! Constant iterator over the childs.
+        typedef AbstractNode* const* const_iterator;
+
+        //! Constructor.
+        AstChilds();
+
+        //! Constructor by copy.
+        AstChilds(const AstChilds& copy);
+
+        //! Destructor.
+        ~AstChilds();
+
+        //! Copies the childs.
+        AstChilds& operator=(const AstChilds& other);
+
+        //! Returns true if both lists contain the same childs in the same order.
+        bool operator==(const AstChilds& other) const;
+
+        //! Returns the child at an index.
+        AbstractNode*& operator[](triton::uint32 index);
+
+        //! Returns the child at an index.
+        AbstractNode* const& operator[](triton::uint32 index) const;
+
+        //! Returns the number of childs.
+        triton::uint32 size(void) const;
+
+        //! Returns true if there is no child.
+        bool empty(void) const;
+
+        //! Appends a child.
+        void push_back(AbstractNode* child);
+
+        //! Returns an iterator to the first child.
+        iterator begin(void);
+
+        //! Returns an iterator past the last child.
+        iterator end(void);
+
+        //! Returns an iterator to the first child.
+        const_iterator begin(void) const;
+
+        //! Returns an iterator past the last child.
+        const_iterator end(void) const;
+    };
+
+
+    //! \class AstValue
+    /*!
+     *  \brief The concrete value of a node.
+     *
+     *  \description
+     *  Values which fit in 64 bits are stored inline, wider values (e.g. SSE and AVX registers) are boxed.
+     */
+    class AstValue {
+      protected:
+        //! The value if it fits in 64 bits.
+        triton::uint64 narrow;
+
+        //! The value if it does not fit in 64 bits, nullptr otherwise.
+        triton::uint512* wide;
+
+      public:
+        //! Constructor.
+        AstValue();
+
+        //! Constructor by copy.
+        AstValue(const AstValue& copy);
+
+        //! Destructor.
+        ~AstValue();
+
+        //! Copies a value.
+        AstValue& operator=(const AstValue& other);
+
+        //! Sets the value.
+        AstValue& operator=(triton::uint64 value);
+
+        //! Sets the value.
+        AstValue& operator=(const triton::uint512& value);
+
+        //! Returns true if the value fits in 64 bits.
+        bool isNarrow(void) const;
+
+        //! Returns the value. Only meaningful if isNarrow() returns true.
+        triton::uint64 getNarrow(void) const;
+
+        //! Returns the value.
+        triton::uint512 getValue(void) const;
+    };
+
+
     //! Abstract node
     class AbstractNode {
       protected:
@@ -45,16 +169,16 @@ namespace triton {
         enum kind_e kind;
 
         //! The childs of the node.
-        std::vector<AbstractNode*> childs;
-
-        //! The parents of the node. Empty if there is still no parent.
-        std::set<AbstractNode*> parents;
+        AstChilds childs;
 
         //! The size of the node.
         triton::uint32 size;
 
         //! The value of the tree from this root node.
-        triton::uint512 eval;
+        AstValue eval;
+
+        //! The structural hash of the tree from this root node. Computed once by init().
+        triton::uint64 hash;
 
         //! This value is set to true if the tree contains a symbolic variable.
         bool symbolized;
@@ -63,7 +187,7 @@ namespace triton {
         //! Constructor.
         AbstractNode(enum kind_e kind);
 
-        //! Constructor by copy.
+        //! Constructor by copy. The childs are shared with the original node, see triton::ast::newInstance() for a deep copy.
         AbstractNode(const AbstractNode& copy);
 
         //! Constructor.
@@ -72,6 +196,12 @@ namespace triton {
         //! Destructor.
         virtual ~AbstractNode();
 
+        //! Allocates a node from the slabs of the AST garbage collector.
+        static void* operator new(std::size_t size);
+
+        //! Gives back a node to the slabs of the AST garbage collector.
+        static void operator delete(void* ptr);
+
         //! Returns the kind of the node.
         enum kind_e getKind(void) const;
 
@@ -90,16 +220,25 @@ namespace triton {
         //! Evaluates the tree.
         triton::uint512 evaluate(void) const;
 
+        //! Evaluates the tree without multiprecision. Only meaningful for nodes up to 64 bits.
+        triton::uint64 evaluateNarrow(void) const;
+
+        //! Returns the structural hash of the tree. Commutative operators have the same hash whatever the order of their childs.
+        triton::uint64 getHash(void) const;
+
         //! Returns the childs of the node.
-        std::vector<AbstractNode*>& getChilds(void);
+        AstChilds& getChilds(void);
 
         /*!
          * \brief Returns the parents of node or an empty set if there is still no parent defined.
          *
+         * Parents are not stored in the node. They are looked up in the parent index of the AST
+         * garbage collector, which is built the first time parents are needed.
+         *
          * Note that if there is the `AST_DICTIONARIES` optimization enabled, this feature will
          * probably not represent the real tree of your expression.
          */
-        std::set<AbstractNode*>& getParents(void);
+        std::set<AbstractNode*> getParents(void);
 
         //! Removes a parent node.
         void removeParent(AbstractNode* p);
@@ -108,7 +247,10 @@ namespace triton {
         void setParent(AbstractNode* p);
 
         //! Sets the parent nodes.
-        void setParent(std::set<AbstractNode*>& p);
+        void setParent(const std::set<AbstractNode*>& p);
+
+        //! Re-inits the parents of the node. Does nothing if the node has never been linked to a parent.
+        void initParents(void);
 
         //! Sets the size of the node.
         void setBitvectorSize(triton::uint32 size);
@@ -125,8 +267,8 @@ namespace triton {
         //! Entry point for a visitor.
         virtual void accept(AstVisitor& v) = 0;
 
-        //! Returns the has of the tree. The hash is computed recursively on the whole tree.
-        virtual triton::uint512 hash(triton::uint32 deep) = 0;
+        //! Computes the structural hash of the node from the cached hashes of its childs.
+        virtual void initHash(void) = 0;
     };
 
 
@@ -138,7 +280,7 @@ namespace triton {
         ~AssertNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -150,7 +292,7 @@ namespace triton {
         ~BvaddNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -162,7 +304,7 @@ namespace triton {
         ~BvandNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -174,7 +316,7 @@ namespace triton {
         ~BvashrNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -186,7 +328,7 @@ namespace triton {
         ~BvdeclNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -198,7 +340,7 @@ namespace triton {
         ~BvlshrNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -210,7 +352,7 @@ namespace triton {
         ~BvmulNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -222,7 +364,7 @@ namespace triton {
         ~BvnandNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -234,7 +376,7 @@ namespace triton {
         ~BvnegNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -246,7 +388,7 @@ namespace triton {
         ~BvnorNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -258,7 +400,7 @@ namespace triton {
         ~BvnotNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -270,7 +412,7 @@ namespace triton {
         ~BvorNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -283,7 +425,7 @@ namespace triton {
         ~BvrolNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -296,7 +438,7 @@ namespace triton {
         ~BvrorNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -308,7 +450,7 @@ namespace triton {
         ~BvsdivNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -320,7 +462,7 @@ namespace triton {
         ~BvsgeNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -332,7 +474,7 @@ namespace triton {
         ~BvsgtNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -344,7 +486,7 @@ namespace triton {
         ~BvshlNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -356,7 +498,7 @@ namespace triton {
         ~BvsleNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -368,7 +510,7 @@ namespace triton {
         ~BvsltNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -380,7 +522,7 @@ namespace triton {
         ~BvsmodNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -392,7 +534,7 @@ namespace triton {
         ~BvsremNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -404,7 +546,7 @@ namespace triton {
         ~BvsubNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -416,7 +558,7 @@ namespace triton {
         ~BvudivNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -428,7 +570,7 @@ namespace triton {
         ~BvugeNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -440,7 +582,7 @@ namespace triton {
         ~BvugtNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -452,7 +594,7 @@ namespace triton {
         ~BvuleNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -464,7 +606,7 @@ namespace triton {
         ~BvultNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -476,7 +618,7 @@ namespace triton {
         ~BvuremNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -488,7 +630,7 @@ namespace triton {
         ~BvxnorNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -500,7 +642,7 @@ namespace triton {
         ~BvxorNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -512,7 +654,7 @@ namespace triton {
         ~BvNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -524,7 +666,7 @@ namespace triton {
         ~CompoundNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -538,7 +680,7 @@ namespace triton {
         ~ConcatNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -553,7 +695,7 @@ namespace triton {
         ~DecimalNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
 
         triton::uint512 getValue(void);
     };
@@ -567,7 +709,7 @@ namespace triton {
         ~DeclareFunctionNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -579,7 +721,7 @@ namespace triton {
         ~DistinctNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -591,7 +733,7 @@ namespace triton {
         ~EqualNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -603,7 +745,7 @@ namespace triton {
         ~ExtractNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -615,7 +757,7 @@ namespace triton {
         ~IteNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -627,7 +769,7 @@ namespace triton {
         ~LandNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -639,7 +781,7 @@ namespace triton {
         ~LetNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -651,7 +793,7 @@ namespace triton {
         ~LnotNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -663,7 +805,7 @@ namespace triton {
         ~LorNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -678,7 +820,7 @@ namespace triton {
         ~ReferenceNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
 
         triton::usize getValue(void);
     };
@@ -695,7 +837,7 @@ namespace triton {
         ~StringNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
 
         std::string getValue(void);
     };
@@ -709,7 +851,7 @@ namespace triton {
         ~SxNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -724,7 +866,7 @@ namespace triton {
         ~VariableNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
 
         std::string getValue(void);
     };
@@ -738,7 +880,7 @@ namespace triton {
         ~ZxNode();
         virtual void init(void);
         virtual void accept(AstVisitor& v);
-        virtual triton::uint512 hash(triton::uint32 deep);
+        virtual void initHash(void);
     };
 
 
@@ -918,11 +1060,29 @@ namespace triton {
     //! ast C++ api - Duplicates the AST
     AbstractNode* newInstance(AbstractNode* node);
 
-    //! Custom pow function for hash routine.
-    triton::uint512 pow(triton::uint512 hash, triton::uint32 n);
+    //! ast C++ api - Duplicates a node, the duplicate shares the childs of the original node
+    AbstractNode* newShallowInstance(AbstractNode* node);
+
+    //! Evaluates a unary operation according to the width class of its operand (64, 128 or 512 bits).
+    AstValue evaluateUnary(enum kind_e kind, AbstractNode* op);
+
+    //! Evaluates a binary operation according to the width class of its operands (64, 128 or 512 bits).
+    AstValue evaluateBinary(enum kind_e kind, AbstractNode* op1, AbstractNode* op2);
+
+    /*!
+     * \brief Evaluates an AST where symbolic variables take the values of `model` (symbolic variable id -> value).
+     *
+     * \description
+     * Variables missing from `model` keep their concrete value. `values` caches the nodes already evaluated
+     * and can be shared between several calls with the same `model`.
+     */
+    triton::uint512 evaluateWithModel(AbstractNode* node, const std::map<triton::usize, triton::uint512>& model, std::map<AbstractNode*, triton::uint512>& values);
+
+    //! Evaluates a node from the values of its childs (`values[i]` is the value of the child `i`). Variables and references are not supported.
+    triton::uint512 evaluateOperation(AbstractNode* node, const std::vector<triton::uint512>& values);
 
-    //! Custom rotate left function for hash routine.
-    triton::uint512 rotl(triton::uint512 value, triton::uint32 shift);
+    //! Custom mix function (splitmix64 finalizer) for hash routine.
+    triton::uint64 hashMix(triton::uint64 value);
 
     //! Custom modular sign extend for bitwise operation.
     triton::sint512 modularSignExtend(AbstractNode* node);
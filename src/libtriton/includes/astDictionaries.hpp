@@ -9,6 +9,10 @@
 #define TRITON_ASTDICTIONARIES_H
 
 #include <list>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
 
 #include "ast.hpp"
 #include "tritonTypes.hpp"
@@ -31,165 +35,67 @@ namespace triton {
    */
 
     //! \class AstDictionaries
-    /*! \brief The AST dictionaries class */
+    /*!
+     *  \brief The AST dictionaries class
+     *
+     *  \description
+     *  The dictionaries are a single hash-consing table (open addressing with linear probing) keyed by
+     *  the structure of a node: its kind, its size, its childs (which are already unique, so compared by
+     *  pointer) and its payload (value of a decimal or a reference node, name of a string or a variable node).
+     *  Each slot caches the structural hash of its node (see AbstractNode::getHash()), so a probe only compares
+     *  nodes with the same hash.
+     *
+     *  Entries are weak: the nodes are owned by the garbage collector, which drops them from the table
+     *  when they are freed (see removeAstDictionariesNodes()). A dropped slot becomes a tombstone, which
+     *  keeps the probe sequences going through it, until the next rebuild of the table.
+     */
     class AstDictionaries {
 
       protected:
+        //! A slot of the hash-consing table.
+        struct AstDictionaryEntry {
+          //! The structural hash of the node.
+          triton::uint64 hash;
+
+          //! The node. nullptr if the slot is free or a tombstone (then `hash` is astDictionariesTombstone).
+          triton::ast::AbstractNode* node;
+        };
+
+        //! The hash of a tombstone slot. A free slot has a null hash.
+        static const triton::uint64 astDictionariesTombstone = 1;
+
         //! Total of allocated nodes.
         triton::usize allocatedNodes;
 
         //! Total of allocated dictionaries.
         triton::usize allocatedDictionaries;
 
-        //! Assert Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> assertDictionary;
-
-        //! Bvadd Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvaddDictionary;
-
-        //! Bvand Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvandDictionary;
-
-        //! Bvashr Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvashrDictionary;
-
-        //! Bvdecl Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvdeclDictionary;
-
-        //! Bvlshr Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvlshrDictionary;
-
-        //! Bvmul Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvmulDictionary;
-
-        //! Bvnand Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvnandDictionary;
-
-        //! Bvneg Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvnegDictionary;
-
-        //! Bvnor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvnorDictionary;
-
-        //! Bvnot Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvnotDictionary;
-
-        //! Bvor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvorDictionary;
-
-        //! Bvrol Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvrolDictionary;
-
-        //! Bvror Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvrorDictionary;
-
-        //! Bvsdiv Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsdivDictionary;
-
-        //! Bvsge Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsgeDictionary;
-
-        //! Bvsgt Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsgtDictionary;
-
-        //! Bvshl Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvshlDictionary;
-
-        //! Bvsle Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsleDictionary;
-
-        //! Bvslt Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsltDictionary;
-
-        //! Bvsmod Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsmodDictionary;
+        //! Total of tombstone slots.
+        triton::usize tombstones;
 
-        //! Bvsrem Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsremDictionary;
+        //! Total of probes done by all lookups.
+        triton::usize totalProbes;
 
-        //! Bvsub Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvsubDictionary;
+        //! The longest probe sequence seen by a lookup.
+        triton::usize maxProbeLength;
 
-        //! Bvudiv Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvudivDictionary;
+        //! The hash-consing table. Its size is always a power of two.
+        std::vector<AstDictionaryEntry> dictionaries;
 
-        //! Bvuge Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvugeDictionary;
+        //! Returns true if two nodes have the same structure.
+        bool isSameNode(triton::ast::AbstractNode* node1, triton::ast::AbstractNode* node2) const;
 
-        //! Bvugt Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvugtDictionary;
+        //! Inserts a node into a free slot of the table without looking for duplicates.
+        void insertNode(triton::uint64 hash, triton::ast::AbstractNode* node);
 
-        //! Bvule Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvuleDictionary;
+        //! Returns true if a slot is neither free nor a tombstone.
+        static bool isUsedSlot(const AstDictionaryEntry& entry);
 
-        //! Bvult Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvultDictionary;
+        //! Returns true if a slot ends the probe sequences (free, not a tombstone).
+        static bool isFreeSlot(const AstDictionaryEntry& entry);
 
-        //! Bvurem Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvuremDictionary;
-
-        //! Bvxnor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvxnorDictionary;
-
-        //! Bvxor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvxorDictionary;
-
-        //! Bv Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> bvDictionary;
-
-        //! Compound Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> compoundDictionary;
-
-        //! Concat Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> concatDictionary;
-
-        //! Decimal Dictionary
-        std::map<triton::uint512, triton::ast::AbstractNode*> decimalDictionary;
-
-        //! Declare Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> declareFunctionDictionary;
-
-        //! Distinct Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> distinctDictionary;
-
-        //! Equal Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> equalDictionary;
-
-        //! Extract Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> extractDictionary;
-
-        //! Ite Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> iteDictionary;
-
-        //! Land Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> landDictionary;
-
-        //! Let Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> letDictionary;
-
-        //! Lnot Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> lnotDictionary;
-
-        //! Lor Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> lorDictionary;
-
-        //! Reference Dictionary
-        std::map<triton::usize, triton::ast::AbstractNode*> referenceDictionary;
-
-        //! String Dictionary
-        std::map<std::string, triton::ast::AbstractNode*> stringDictionary;
-
-        //! Sx Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> sxDictionary;
-
-        //! Variable Dictionary
-        std::map<std::string, triton::ast::AbstractNode*> variableDictionary;
-
-        //! Zx Dictionary
-        std::map<std::vector<triton::ast::AbstractNode*>, triton::ast::AbstractNode*> zxDictionary;
-
-        //! Dictionaries
-        std::map<triton::uint32, void*> dictionaries;
+        //! Re-inserts all nodes into a table of `size` slots, which drops the tombstones.
+        void rebuildDictionaries(triton::usize size);
 
     public:
         //! Constructor.
@@ -204,13 +110,30 @@ namespace triton {
         //! Copies a AstDictionaries.
         void copy(const AstDictionaries& other);
 
-        //! Links all sub dictionaries to the root one.
-        void linkDictionaries(void);
-
-        //! Browses into dictionaries.
+        /*!
+         * \brief Browses into dictionaries.
+         *
+         * \description Returns the unique node which has the same structure than `node` if it exists (`node` is then freed),
+         * otherwise `node` is recorded and nullptr is returned.
+         */
         triton::ast::AbstractNode* browseAstDictionaries(triton::ast::AbstractNode* node);
 
-        //! Returns stats about dictionaries.
+        /*!
+         * \brief Removes nodes from the dictionaries.
+         *
+         * \description The dictionaries do not own their nodes. The garbage collector calls this method
+         * with the nodes it is about to free, so the table never points to a freed node. Each node is
+         * found by its hash and its slot becomes a tombstone, so the cost only depends on the number
+         * of removed nodes.
+         */
+        void removeAstDictionariesNodes(const std::set<triton::ast::AbstractNode*>& nodes);
+
+        /*!
+         * \brief Returns stats about dictionaries.
+         *
+         * \description Returns the number of nodes per kind plus `allocatedDictionaries`, `allocatedNodes`,
+         * `capacity`, `loadFactor` (in percent), `totalProbes` and `maxProbeLength`.
+         */
         std::map<std::string, triton::usize> getAstDictionariesStats(void);
 
         //! Copies a AstDictionaries.
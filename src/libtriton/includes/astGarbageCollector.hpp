@@ -8,10 +8,14 @@
 #ifndef TRITON_ASTGARBAGECOLLECTOR_H
 #define TRITON_ASTGARBAGECOLLECTOR_H
 
+#include <map>
 #include <set>
 #include <string>
+#include <tuple>
+#include <vector>
 
 #include "ast.hpp"
+#include "astTemplate.hpp"
 #include "symbolicEnums.hpp"
 #include "tritonTypes.hpp"
 
@@ -32,25 +36,159 @@ namespace triton {
    *  @{
    */
 
+    //! Number of cells in a slab.
+    const triton::usize AST_SLAB_CELLS = 1024;
+
+    //! Minimum number of allocations between two automatic collections.
+    const triton::usize AST_COLLECTION_THRESHOLD = 65536;
+
+    //! The reference id of the first template hole. Holes take the ids below, which are never given to a symbolic expression.
+    const triton::usize AST_TEMPLATE_HOLE_ID = static_cast<triton::usize>(-2);
+
+    //! Flags of an AST cell.
+    enum ast_cell_e {
+      AST_CELL_FREE     = (1 << 0), /*!< The cell is in the free list */
+      AST_CELL_RECORDED = (1 << 1), /*!< The node is owned by the garbage collector (set on allocation) */
+      AST_CELL_DOOMED   = (1 << 2), /*!< The node is being freed by a bulk release */
+      AST_CELL_MARKED   = (1 << 3), /*!< The node has been reached during a collection */
+      AST_CELL_PARENTED = (1 << 4), /*!< The node has been linked to a parent at least once */
+    };
+
+    //! The header of a cell, stored right before the node. 16 bytes on every target to keep nodes aligned.
+    struct AstCellHeader {
+      //! The epoch at which the node has been allocated. 64 bits even on 32-bit targets to keep the size of the header.
+      triton::uint64 epoch;
+
+      //! The flags of the cell (see triton::ast::ast_cell_e).
+      triton::uint32 flags;
+
+      //! The pool which owns the cell.
+      triton::uint32 pool;
+    };
+
+    static_assert(sizeof(AstCellHeader) == 16, "AstCellHeader must be 16 bytes to keep the nodes aligned.");
+
+    //! A pool of slabs. All cells of a pool have the same size.
+    struct AstSlabPool {
+      //! The size of a cell (header included).
+      triton::usize cellSize;
+
+      //! The number of cells already carved in the last slab.
+      triton::usize used;
+
+      //! The slabs of the pool.
+      std::vector<triton::uint8*> slabs;
+
+      //! The first free cell. Each free cell stores the next one right after its header.
+      AstCellHeader* freeList;
+    };
+
     //! \class AstGarbageCollector
-    /*! \brief The AST garbage collector class */
+    /*!
+     *  \brief The AST garbage collector class
+     *
+     *  \description
+     *  All nodes are carved from slabs owned by the garbage collector (see `AbstractNode::operator new`).
+     *  There is one pool of slabs per node size class. Freed nodes go back into a free list of their pool
+     *  and bulk releases give back whole slabs. Each node is stamped with the current epoch, which allows
+     *  to free every node allocated since a mark (see markAstNodes() and freeAstNodesSinceMark()). The childs
+     *  of older nodes rewritten since the last mark (e.g. by an in-place `getFullAst()`) are logged, and the
+     *  rewrites are reverted before the nodes of the mark are freed, so no older node points to a freed one.
+     *
+     *  Recorded nodes which are not reachable anymore are reclaimed by a mark and sweep (see collectAstNodes()).
+     *  Every allocated node is recorded, copies included. The roots are the symbolic expressions, the aligned memory
+     *  and the path constraints of the symbolic engine, the variable nodes, the pinned nodes and the AST templates.
+     *  A node held outside of the engine (e.g. a copy returned by `SymbolicExpression::getNewAst()`) must be pinned
+     *  to survive a collection, this is what the Python objects do. The AST dictionaries only hold weak references:
+     *  their entries are dropped when the nodes are freed. When the `AST_GARBAGE_COLLECTION` optimization is
+     *  enabled, a collection is triggered after an instruction each time the number of allocations since the last
+     *  one reaches the number of nodes which survived it.
+     *
+     *  As every symbolic expression is a root, a collection only reclaims the nodes which are not part of an
+     *  expression anymore (e.g. temporaries, released copies or nodes replaced by a simplification). The nodes
+     *  of a trace are only reclaimed once their symbolic expressions are removed from the symbolic engine.
+     *
+     *  Nodes do not store their parents. The garbage collector builds a parent index by scanning the slabs the
+     *  first time parents are needed. From then on, new links are only logged and folded into the index on the
+     *  next lookup. Stale entries are dropped when they are looked up.
+     *
+     *  The garbage collector also keeps the AST templates (see triton::ast::AstTemplate) because their lifetime
+     *  follows the nodes: they are forgotten each time nodes are freed outside of a collection.
+     */
     class AstGarbageCollector {
       protected:
-        //! This container contains all allocated nodes.
-        std::set<triton::ast::AbstractNode*> allocatedNodes;
+        //! The pools of slabs, indexed by size class.
+        std::vector<AstSlabPool> pools;
+
+        //! The current epoch.
+        triton::usize epoch;
 
         //! This map maintains a link between symbolic variables and their nodes.
         std::map<std::string, triton::ast::AbstractNode*> variableNodes;
 
+        //! The pinned nodes and how many times they have been pinned.
+        std::map<triton::ast::AbstractNode*, triton::usize> pinnedNodes;
+
+        //! The undo log of the childs of the nodes older than the last mark: <node, child index, previous child>. The previous childs are roots of the collections.
+        std::vector<std::tuple<triton::ast::AbstractNode*, triton::uint32, triton::ast::AbstractNode*>> undoChilds;
+
+        //! The AST templates, indexed by a key chosen by their user. Their nodes are roots of the collections.
+        std::map<triton::uint64, triton::ast::AstTemplate> templates;
+
+        //! The number of template holes created.
+        triton::usize templateHoles;
+
+        //! The number of nodes allocated since the last collection.
+        triton::usize allocatedSinceCollection;
+
+        //! The number of live nodes after the last collection.
+        triton::usize liveAfterCollection;
+
+        //! True if the parent index has been built.
+        bool parentIndexed;
+
+        //! The parent index. Maps a node to its parents.
+        std::map<triton::ast::AbstractNode*, std::set<triton::ast::AbstractNode*>> parentIndex;
+
+        //! The links (node, parent) not yet folded into the parent index.
+        std::vector<std::pair<triton::ast::AbstractNode*, triton::ast::AbstractNode*>> unindexedParents;
+
+        //! Returns the cell header of a node.
+        static AstCellHeader* getCellHeader(triton::ast::AbstractNode* node);
+
+        //! Returns the number of cells carved in a slab.
+        triton::usize getSlabCells(const AstSlabPool& pool, triton::usize slab) const;
+
+        //! Returns true if `parent` still points to `node`.
+        bool isParentAstNode(triton::ast::AbstractNode* parent, triton::ast::AbstractNode* node) const;
+
+        //! Builds the parent index from the nodes of the slabs.
+        void buildParentIndex(void);
+
+        //! Folds the logged links into the parent index.
+        void flushParentIndex(void);
+
+        //! Unflags the doomed nodes reachable from the pinned nodes.
+        void spareDoomedAstNodes(void);
+
+        //! Frees all recorded nodes flagged as doomed. Unlinks them from their surviving childs and gives back empty slabs.
+        void freeDoomedAstNodes(void);
+
 
       public:
         //! Constructor.
         AstGarbageCollector();
 
-        //! Destructor.
+        //! Destructor. Frees every node allocated from the slabs.
         ~AstGarbageCollector();
 
-        //! Go through every allocated nodes and free them.
+        //! Allocates the memory of a node.
+        void* allocateAstNode(triton::usize size);
+
+        //! Gives back the memory of a node.
+        void deallocateAstNode(void* ptr);
+
+        //! Go through every allocated nodes and free them, except the ones reachable from the pinned nodes.
         void freeAllAstNodes(void);
 
         //! Frees a set of nodes and removes them from the global container.
@@ -59,6 +197,42 @@ namespace triton {
         //! Extracts all unique nodes from a partial AST into the uniqueNodes set.
         void extractUniqueAstNodes(std::set<triton::ast::AbstractNode*>& uniqueNodes, triton::ast::AbstractNode* root) const;
 
+        //! Starts a new epoch and returns its mark. Every node allocated from now on belongs to this epoch.
+        triton::usize markAstNodes(void);
+
+        /*!
+         * \brief Frees every recorded node allocated since the mark.
+         *
+         * \description The caller must make sure that no symbolic expression still points to these nodes.
+         * Nodes reachable from the pinned nodes are not freed. The childs rewritten since the last mark are
+         * restored first.
+         */
+        void freeAstNodesSinceMark(triton::usize mark);
+
+        //! Logs the child `index` of a node before it is rewritten, if the node is older than the last mark.
+        void logChildAstNode(triton::ast::AbstractNode* node, triton::uint32 index);
+
+        //! Links a node to one of its parents.
+        void linkParentAstNode(triton::ast::AbstractNode* node, triton::ast::AbstractNode* parent);
+
+        //! Unlinks a node from one of its parents.
+        void unlinkParentAstNode(triton::ast::AbstractNode* node, triton::ast::AbstractNode* parent);
+
+        //! Returns the parents of a node. Builds the parent index if needed.
+        std::set<triton::ast::AbstractNode*> getParentAstNodes(triton::ast::AbstractNode* node);
+
+        //! Pins a node. A pinned node and its childs are never freed by a collection.
+        void pinAstNode(triton::ast::AbstractNode* node);
+
+        //! Unpins a node.
+        void unpinAstNode(triton::ast::AbstractNode* node);
+
+        //! Frees every recorded node which is not reachable from the roots. Returns the number of freed nodes.
+        triton::usize collectAstNodes(void);
+
+        //! Runs a collection if enough nodes have been allocated since the last one.
+        void collectAstNodesIfNeeded(void);
+
         //! Records the allocated node or returns the same node if it already exists inside the dictionaries.
         triton::ast::AbstractNode* recordAstNode(triton::ast::AbstractNode* node);
 
@@ -66,7 +240,7 @@ namespace triton {
         void recordVariableAstNode(const std::string& name, triton::ast::AbstractNode* node);
 
         //! Returns all allocated nodes.
-        const std::set<triton::ast::AbstractNode*>& getAllocatedAstNodes(void) const;
+        std::set<triton::ast::AbstractNode*> getAllocatedAstNodes(void) const;
 
         //! Returns all variable nodes recorded.
         const std::map<std::string, triton::ast::AbstractNode*>& getAstVariableNodes(void) const;
@@ -74,11 +248,23 @@ namespace triton {
         //! Returns the node of a recorded variable.
         triton::ast::AbstractNode* getAstVariableNode(const std::string& name) const;
 
-        //! Sets all allocated nodes.
+        //! Sets all allocated nodes. Nodes which are not in `nodes` nor reachable from the pinned nodes are freed.
         void setAllocatedAstNodes(const std::set<triton::ast::AbstractNode*>& nodes);
 
         //! Sets all variable nodes recorded.
         void setAstVariableNodes(const std::map<std::string, triton::ast::AbstractNode*>& nodes);
+
+        //! Returns a new hole of `size` bits for an AST template.
+        triton::ast::AbstractNode* newAstTemplateHole(triton::uint32 size);
+
+        //! Returns the template recorded for `key`. Nullptr if there is none.
+        const triton::ast::AstTemplate* getAstTemplate(triton::uint64 key) const;
+
+        //! Records a template for `key` and returns it.
+        const triton::ast::AstTemplate* recordAstTemplate(triton::uint64 key, const triton::ast::AstTemplate& tpl);
+
+        //! Forgets all the templates. Called each time nodes are freed outside of a collection.
+        void clearAstTemplates(void);
     };
 
   /*! @} End of ast namespace */
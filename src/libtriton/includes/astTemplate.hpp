@@ -0,0 +1,95 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_ASTTEMPLATE_H
+#define TRITON_ASTTEMPLATE_H
+
+#include <map>
+#include <vector>
+
+#include "ast.hpp"
+#include "tritonTypes.hpp"
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The AST namespace
+  namespace ast {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup ast
+   *  @{
+   */
+
+    /*! \class AstTemplate
+     *  \brief A parameterized AST.
+     *
+     * \description
+     * A template is an AST built once with holes in place of some of its leaves (see API::newAstTemplateHole()).
+     * Instantiating a template only allocates the nodes which depend on a hole, the other nodes (constants,
+     * decimals, ...) are shared between all the instances. A hole appearing several times in the template gives
+     * the same node in the instance.
+     */
+    class AstTemplate {
+      protected:
+        //! The root of the template.
+        AbstractNode* root;
+
+        //! The holes of the template.
+        std::vector<AbstractNode*> holes;
+
+        //! Where the root comes from in the instance, same encoding as `sources`.
+        triton::sint32 rootSource;
+
+        //! The nodes which depend on at least one hole, childs before their parents.
+        std::vector<AbstractNode*> nodes;
+
+        /*! \brief Where the childs of `nodes` come from.
+         *
+         * \description For each node of `nodes`, one item per child: -1 if the child is shared with the
+         * template, `i` if the child is the hole `i`, `holes.size() + i` if the child is the instance of `nodes[i]`.
+         */
+        std::vector<std::vector<triton::sint32>> sources;
+
+        //! Collects the nodes which depend on a hole. Returns the source of `node` in the instance.
+        triton::sint32 extractNodes(AbstractNode* node, std::map<AbstractNode*, triton::sint32>& visited);
+
+      public:
+        //! Constructor.
+        AstTemplate(AbstractNode* root, const std::vector<AbstractNode*>& holes);
+
+        //! Constructor by copy.
+        AstTemplate(const AstTemplate& copy);
+
+        //! Destructor.
+        ~AstTemplate();
+
+        //! Returns the number of holes.
+        triton::usize getNumberOfHoles(void) const;
+
+        //! Returns the root and the holes of the template. Used by the garbage collector to keep the template alive.
+        void extractRoots(std::vector<AbstractNode*>& roots) const;
+
+        //! Returns an instance of the template where the hole `i` is replaced by `values[i]`.
+        AbstractNode* instantiate(const std::vector<AbstractNode*>& values) const;
+
+        //! Returns the concrete value of the template where the hole `i` has the value `values[i]`. No node is allocated.
+        triton::uint512 evaluate(const std::vector<triton::uint512>& values) const;
+    };
+
+  /*! @} End of ast namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_ASTTEMPLATE_H */
@@ -106,6 +106,9 @@ namespace triton {
         //! Returns the concrete value of a memory area.
         virtual std::vector<triton::uint8> getConcreteMemoryAreaValue(triton::uint64 baseAddr, triton::usize size) const = 0;
 
+        //! Returns a read-only view on the memory area starting at `baseAddr` without copying it. `size` is set to the number of readable bytes (zero and nullptr if unmapped).
+        virtual const triton::uint8* getConcreteMemoryAreaView(triton::uint64 baseAddr, triton::usize& size) const = 0;
+
         //! Returns the concrete value of a register.
         virtual triton::uint512 getConcreteRegisterValue(const triton::arch::RegisterOperand& reg) const = 0;
 
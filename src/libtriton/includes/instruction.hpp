@@ -76,7 +76,10 @@ namespace triton {
         std::set<std::pair<triton::arch::RegisterOperand, triton::ast::AbstractNode*>> readRegisters;
 
         //! Implicit and explicit register outputs (write).
-        std::set<std::pair<triton::arch::RegisterOperand, triton::ast::AbstractNode*>> writtenRegisters;
+        mutable std::set<std::pair<triton::arch::RegisterOperand, triton::ast::AbstractNode*>> writtenRegisters;
+
+        //! Register outputs (write) of lazy symbolic expressions, with the expression. Moved to writtenRegisters on their first read.
+        mutable std::set<std::pair<triton::arch::RegisterOperand, triton::engines::symbolic::SymbolicExpression*>> lazyWrittenRegisters;
 
         //! Implicit and explicit immediate inputs (read).
         std::set<std::pair<triton::arch::ImmediateOperand, triton::ast::AbstractNode*>> readImmediates;
@@ -157,12 +160,15 @@ namespace triton {
         //! Returns the list of all implicit and explicit register (flags includes) inputs (read)
         const std::set<std::pair<triton::arch::RegisterOperand, triton::ast::AbstractNode*>>& getReadRegisters(void) const;
 
-        //! Returns the list of all implicit and explicit register (flags includes) outputs (write)
+        //! Returns the list of all implicit and explicit register (flags includes) outputs (write). The ASTs of the lazy ones are built first.
         const std::set<std::pair<triton::arch::RegisterOperand, triton::ast::AbstractNode*>>& getWrittenRegisters(void) const;
 
         //! Returns the list of all implicit and explicit immediate inputs (read)
         const std::set<std::pair<triton::arch::ImmediateOperand, triton::ast::AbstractNode*>>& getReadImmediates(void) const;
 
+        //! Appends the AST nodes of the accesses, registers and immediates of the instruction to `nodes`. The lazy written registers are not built.
+        void extractAstNodes(std::vector<triton::ast::AbstractNode*>& nodes) const;
+
         //! If there is a concrete value recorded, build the appropriate MemoryOperand. Otherwise, perfrom the analysis based on args.
         triton::arch::MemoryOperand popMemoryAccess(triton::uint64=0, triton::uint32 size=0, triton::uint512 value=0);
 
@@ -187,6 +193,12 @@ namespace triton {
         //! Sets a written register.
         void setWrittenRegister(const triton::arch::RegisterOperand& reg, triton::ast::AbstractNode* node);
 
+        //! Sets a written register whose AST is the one of the lazy symbolic expression `se`.
+        void setLazyWrittenRegister(const triton::arch::RegisterOperand& reg, triton::engines::symbolic::SymbolicExpression* se);
+
+        //! Replaces the lazy written register of `se` by its concrete value. Must be called before `se` is deleted.
+        void concretizeLazyWrittenRegister(const triton::engines::symbolic::SymbolicExpression* se);
+
         //! Sets a read immediate.
         void setReadImmediate(const triton::arch::ImmediateOperand& imm, triton::ast::AbstractNode* node);
 
@@ -0,0 +1,180 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_PAGEDMEMORY_H
+#define TRITON_PAGEDMEMORY_H
+
+#include "cpuSize.hpp"
+#include "tritonTypes.hpp"
+
+/*! Returns the size of a concrete memory page in byte. */
+#define MEMORY_PAGE_SIZE 0x1000
+
+/*! Returns the mask of the offset into a concrete memory page. */
+#define MEMORY_PAGE_MASK (MEMORY_PAGE_SIZE - 1)
+
+/*! Returns the number of bits of the offset into a concrete memory page. */
+#define MEMORY_PAGE_BITS 12
+
+/*! Returns the number of bits of a page number resolved by each level of the radix tree. */
+#define MEMORY_RADIX_BITS 9
+
+/*! Returns the maximum number of levels of the radix tree. They cover the 52 bits of a 64-bit page number. */
+#define MEMORY_RADIX_MAX_LEVELS ((QWORD_SIZE_BIT - MEMORY_PAGE_BITS + MEMORY_RADIX_BITS - 1) / MEMORY_RADIX_BITS)
+
+/*! Returns the number of slots of a radix tree node. */
+#define MEMORY_RADIX_SLOTS (1 << MEMORY_RADIX_BITS)
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Architecture namespace
+  namespace arch {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup arch
+   *  @{
+   */
+
+    /*! \class MemoryPage
+     *  \brief A page of concrete memory.
+     *
+     * \description Unmapped bytes of a page are always zero so that a page can be read without checking its bitmap.
+     */
+    class MemoryPage {
+      public:
+        //! The concrete values of the page.
+        triton::uint8 data[MEMORY_PAGE_SIZE];
+
+        //! The bitmap of the mapped bytes.
+        triton::uint8 mapped[MEMORY_PAGE_SIZE / BYTE_SIZE_BIT];
+
+        //! The number of mapped bytes.
+        triton::uint32 count;
+
+        //! Constructor.
+        MemoryPage();
+    };
+
+    /*! \class MemoryRadixNode
+     *  \brief A node of the radix tree of the concrete memory.
+     */
+    class MemoryRadixNode {
+      public:
+        //! The childs of the node: MemoryRadixNode on the inner levels, MemoryPage on the last one. Nullptr if the slot is empty.
+        void* slots[MEMORY_RADIX_SLOTS];
+
+        //! The number of slots which are not empty.
+        triton::uint32 count;
+
+        //! Constructor.
+        MemoryRadixNode();
+    };
+
+    /*! \class PagedMemory
+     *  \brief The concrete memory of a CPU, stored as sparse pages of MEMORY_PAGE_SIZE bytes.
+     *
+     * \description Each mapped byte only costs one byte plus one bit of its page, accesses
+     * to a memory operand look up at most two pages and areas are copied page by page.
+     * Pages are indexed by a radix tree, like a page table, whose depth is sized to the address
+     * width of the CPU (3 levels for 32-bit addresses, 6 for 64-bit ones). The last page accessed
+     * is cached so that consecutive accesses skip the tree.
+     */
+    class PagedMemory {
+      protected:
+        //! The root of the radix tree. Nullptr if no page is mapped.
+        MemoryRadixNode* root;
+
+        //! The number of levels of the radix tree.
+        triton::uint32 levels;
+
+        //! The number of allocated pages.
+        triton::usize numberOfPages;
+
+        //! The base address of the last page accessed.
+        mutable triton::uint64 lastPageBase;
+
+        //! The last page accessed. Nullptr if the cache is empty.
+        mutable MemoryPage* lastPage;
+
+        //! Returns the index of the slot of `addr` at a level of the radix tree.
+        triton::uint32 getRadixIndex(triton::uint64 addr, triton::uint32 level) const;
+
+        //! Returns a deep copy of a node of the radix tree and of its childs.
+        MemoryRadixNode* copyRadixNode(const MemoryRadixNode* node, triton::uint32 level) const;
+
+        //! Frees a node of the radix tree and its childs.
+        void freeRadixNode(MemoryRadixNode* node, triton::uint32 level) const;
+
+        //! Returns the page of `addr`, nullptr if it is not mapped.
+        MemoryPage* findPage(triton::uint64 addr) const;
+
+        //! Returns the page of `addr`. Creates it if it is not mapped.
+        MemoryPage* getPage(triton::uint64 addr);
+
+        //! Frees the page of `addr` and the nodes of the radix tree which became empty.
+        void removePage(triton::uint64 addr);
+
+      public:
+        //! Constructor. `addressSize` is the address width of the CPU in bits.
+        PagedMemory(triton::uint32 addressSize=QWORD_SIZE_BIT);
+
+        //! Constructor by copy.
+        PagedMemory(const PagedMemory& copy);
+
+        //! Destructor.
+        ~PagedMemory();
+
+        //! Copies a PagedMemory.
+        void operator=(const PagedMemory& copy);
+
+        //! Clears the memory.
+        void clear(void);
+
+        //! Returns the concrete value of a byte. Unmapped bytes are zero.
+        triton::uint8 getByte(triton::uint64 addr) const;
+
+        //! Copies `size` bytes from `addr` into `area`. Unmapped bytes are zero.
+        void read(triton::uint64 addr, triton::uint8* area, triton::usize size) const;
+
+        /*!
+         * \brief Returns a pointer to the concrete values from `addr` without copying them.
+         *
+         * \description `size` is set to the number of contiguous bytes readable through the pointer,
+         * which never crosses a page boundary. Returns nullptr (and a size of zero) if the page of
+         * `addr` is not mapped. The pointer is invalidated by clear() and unmap().
+         */
+        const triton::uint8* getView(triton::uint64 addr, triton::usize& size) const;
+
+        //! Sets the concrete value of a byte.
+        void setByte(triton::uint64 addr, triton::uint8 value);
+
+        //! Copies `size` bytes from `area` to `addr`.
+        void write(triton::uint64 addr, const triton::uint8* area, triton::usize size);
+
+        //! Returns true if the range `[addr:size]` is mapped.
+        bool isMapped(triton::uint64 addr, triton::usize size) const;
+
+        //! Removes the range `[addr:size]`. Pages without mapped bytes are freed.
+        void unmap(triton::uint64 addr, triton::usize size);
+
+        //! Returns the number of allocated pages.
+        triton::usize getNumberOfPages(void) const;
+    };
+
+  /*! @} End of arch namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_PAGEDMEMORY_H */
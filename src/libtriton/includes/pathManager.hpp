@@ -8,6 +8,7 @@
 #ifndef TRITON_PATHMANAGER_H
 #define TRITON_PATHMANAGER_H
 
+#include <set>
 #include <vector>
 
 #include "instruction.hpp"
@@ -47,6 +48,33 @@ namespace triton {
           //! \brief The logical conjunction vector of path constraints.
           std::vector<triton::engines::symbolic::PathConstraint> pathConstraints;
 
+          //! \brief The symbolic variable ids of each path constraint, computed on demand (same index as `pathConstraints`).
+          std::vector<std::set<triton::usize>> pathConstraintsVariables;
+
+          //! \brief The index of each taken path constraint AST, the first one if several path constraints share the same AST.
+          std::map<triton::ast::AbstractNode*, triton::usize> pathConstraintsIndexes;
+
+          //! True if a snapshot of the path constraints is taken.
+          bool pathConstraintsSnapshot;
+
+          //! The number of path constraints when the snapshot was taken.
+          triton::usize snapshotPathConstraintsSize;
+
+          //! The path constraints of the snapshot, only saved if they are cleared after it.
+          std::vector<triton::engines::symbolic::PathConstraint> snapshotPathConstraints;
+
+          //! Returns the symbolic variable ids of the path constraint at `index`.
+          const std::set<triton::usize>& getPathConstraintVariables(triton::usize index);
+
+          //! Takes a snapshot of the path constraints. Only the number of path constraints is recorded.
+          void takePathConstraintsSnapshot(void);
+
+          //! Restores the path constraints of the snapshot. The snapshot remains taken.
+          void restorePathConstraintsSnapshot(void);
+
+          //! Drops the snapshot of the path constraints.
+          void disablePathConstraintsSnapshot(void);
+
 
         public:
           //! Constructor.
@@ -67,6 +95,15 @@ namespace triton {
           //! Returns the logical conjunction AST of path constraints.
           triton::ast::AbstractNode* getPathConstraintsAst(void) const;
 
+          //! Returns the indexes of the path constraints before `limit` which share symbolic variables with `node`, directly or through other path constraints.
+          std::vector<triton::usize> getRelevantPathConstraints(triton::ast::AbstractNode* node, triton::usize limit);
+
+          //! Returns the logical conjunction AST of the path constraints which share symbolic variables with `node`.
+          triton::ast::AbstractNode* getRelevantPathConstraintsAst(triton::ast::AbstractNode* node);
+
+          //! Returns a query without the taken path constraints of its conjunction which do not share symbolic variables with the rest of it.
+          triton::ast::AbstractNode* sliceQueryAst(triton::ast::AbstractNode* node);
+
           //! Returns the number of constraints.
           triton::usize getNumberOfPathConstraints(void) const;
 
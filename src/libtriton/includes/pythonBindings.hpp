@@ -102,6 +102,9 @@ namespace triton {
       //! Initializes the OPTIMIZATION python namespace.
       void initSymOptiNamespace(PyObject* symOptiDict);
 
+      //! Initializes the SOLVER_STATUS python namespace.
+      void initSolverStatusNamespace(PyObject* solverStatusDict);
+
       //! Initializes the SYMEXPR python namespace.
       void initSymExprNamespace(PyObject* symExprDict);
 
@@ -11,6 +11,8 @@
 #ifndef TRITON_PYOBJECT_H
 #define TRITON_PYOBJECT_H
 
+#include <vector>
+
 #include "ast.hpp"
 #include "bitsVector.hpp"
 #include "immediateOperand.hpp"
@@ -90,6 +92,9 @@ namespace triton {
       //! Creates the SymbolicVariable python class.
       PyObject* PySymbolicVariable(triton::engines::symbolic::SymbolicVariable* symVar);
 
+      //! Holds the symbolic expressions and pins the AST nodes of a pyInstruction. Must be called each time the engine builds its semantics.
+      void recordInstructionExpressions(PyObject* obj);
+
       /* AstNode ======================================================== */
 
       //! pyAstNode object.
@@ -130,6 +135,8 @@ namespace triton {
       typedef struct {
         PyObject_HEAD
         triton::arch::Instruction* inst;
+        std::vector<triton::engines::symbolic::SymbolicExpression*>* symExprs;
+        std::vector<triton::ast::AbstractNode*>* nodes;
       } Instruction_Object;
 
       //! pyInstruction type.
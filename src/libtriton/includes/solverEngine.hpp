@@ -9,14 +9,20 @@
 #define TRITON_SOLVERENGINE_H
 
 #include <cstdlib>
+#include <functional>
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <utility>
+#include <vector>
 
 #include <z3++.h>
 
 #include "ast.hpp"
+#include "solverEnums.hpp"
 #include "solverModel.hpp"
+#include "tritonToZ3Ast.hpp"
 #include "tritonTypes.hpp"
 
 
@@ -42,10 +48,124 @@ namespace triton {
      *  @{
      */
 
+      //! Number of recent models tried against a new query before calling the solver.
+      const triton::uint32 SOLVER_CACHE_MODELS = 32;
+
+      //! Number of answers kept by the query cache. The least recently used answer is evicted first.
+      const triton::uint32 SOLVER_CACHE_ENTRIES = 4096;
+
+      //! Number of queries kept in the statistics.
+      const triton::uint32 SOLVER_QUERY_STATS = 1024;
+
+      //! An answer of the query cache.
+      struct SolverCacheEntry {
+        //! The normalized structural hash of the query.
+        triton::uint64 hash;
+
+        //! The normalized query: its constraints without their assert node, sorted by hash. The nodes are pinned.
+        std::vector<std::pair<triton::ast::AbstractNode*, bool>> query;
+
+        //! The ASTs of the symbolic expressions referenced by the query when it has been answered. The nodes are pinned.
+        std::map<triton::usize, triton::ast::AbstractNode*> references;
+
+        //! The status of the query.
+        triton::engines::solver::status_e status;
+
+        //! The model of the query (empty if no model has been found).
+        std::map<triton::uint32, SolverModel> model;
+      };
+
       //! \class SolverEngine
       /*! \brief The solver engine class. */
       class SolverEngine
       {
+        protected:
+          //! The converter of the incremental session. It owns the Z3 context and the translation cache.
+          triton::ast::TritonToZ3Ast* session;
+
+          //! The solver of the incremental session.
+          z3::solver* sessionSolver;
+
+          /*! \brief The path constraints asserted in the incremental session, one solver scope each.
+           *
+           * \description
+           * **item1**: taken path constraint AST<br>
+           * **item2**: its structural hash
+           */
+          std::vector<std::pair<triton::ast::AbstractNode*, triton::uint64>> sessionConstraints;
+
+          //! The answers of previous queries, most recently used first.
+          std::list<SolverCacheEntry> cacheEntries;
+
+          //! The answers of previous queries indexed by their hash. Different queries may share a hash.
+          std::multimap<triton::uint64, std::list<SolverCacheEntry>::iterator> queryCache;
+
+          //! The last models found, most recent first. They are tried against new queries before calling the solver.
+          std::list<std::map<triton::uint32, SolverModel>> recentModels;
+
+          //! The number of queries answered by the cache.
+          triton::usize cacheHits;
+
+          //! The number of queries answered by evaluating a recent model.
+          triton::usize cacheModelHits;
+
+          //! The number of queries sent to the solver while the cache is enabled.
+          triton::usize cacheMisses;
+
+          //! The number of worker threads used to solve a batch of queries.
+          triton::uint32 threads;
+
+          //! The default timeout of a query in milliseconds (0 means no timeout).
+          triton::uint32 timeout;
+
+          //! The memory limit of the solver in megabytes (0 means no limit).
+          triton::uint32 memoryLimit;
+
+          //! The number of queries sent to the solver.
+          triton::uint64 queryCount;
+
+          //! The statistics of the last queries sent to the solver, most recent last.
+          std::list<std::map<std::string, triton::uint64>> queryStats;
+
+          //! Applies the timeout of a query and the memory limit to a solver. If `timeout` is 0, the default timeout is used.
+          void setLimits(z3::solver& solver, triton::uint32 timeout) const;
+
+          //! Checks a solver and returns the status of the query: TIMEOUT or OUTOFMEM according to the reason of an unknown answer, UNKNOWN otherwise. Never throws on Z3 errors.
+          triton::engines::solver::status_e check(z3::solver& solver) const;
+
+          //! Records the statistics of a query (times in microseconds).
+          void recordQueryStats(triton::uint64 hash, triton::usize nodes, triton::usize variables, triton::uint64 translationTime, triton::uint64 solveTime, triton::engines::solver::status_e status);
+
+          //! Returns the normalized structural hash of a query. A query is a conjunction of (constraint, expected truth value).
+          triton::uint64 getQueryHash(const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query) const;
+
+          //! Returns a query without the assert nodes at the root of its constraints, sorted by hash.
+          std::vector<std::pair<triton::ast::AbstractNode*, bool>> normalizeQuery(const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query) const;
+
+          //! Returns true if two nodes have the same structure. References are compared by id.
+          bool isSameQueryNode(triton::ast::AbstractNode* node1, triton::ast::AbstractNode* node2) const;
+
+          //! Returns true if an answer of the cache is the answer of a normalized query.
+          bool isSameQuery(const SolverCacheEntry& entry, const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query) const;
+
+          //! Looks for the answer of a query in the cache, then tries the recent models. Returns true if an answer has been found.
+          bool lookupQueryCache(triton::uint64 hash, const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query, std::map<triton::uint32, SolverModel>& model, triton::engines::solver::status_e& status);
+
+          //! Records the answer of a query. Only SAT and UNSAT answers are kept.
+          void recordQueryCache(triton::uint64 hash, const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query, const std::map<triton::uint32, SolverModel>& model, triton::engines::solver::status_e status);
+
+          //! Adds an answer to the cache and evicts the least recently used one if the cache is full.
+          void insertQueryCache(triton::uint64 hash, const std::vector<std::pair<triton::ast::AbstractNode*, bool>>& query, const std::map<triton::uint32, SolverModel>& model, triton::engines::solver::status_e status);
+
+          //! Removes an answer from the cache and unpins its nodes.
+          void evictQueryCache(std::list<SolverCacheEntry>::iterator entry);
+
+          //! Asserts the `depth` first path constraints in the incremental session, reusing the ones already asserted.
+          void syncSession(triton::usize depth);
+
+          //! Extracts a model and appends the clause which excludes it to `blocking`. If `projection` is not null, only its variables are excluded.
+          std::map<triton::uint32, SolverModel> extractModel(z3::model& model, const triton::ast::TritonToZ3Ast& converter, z3::expr_vector& blocking, const std::set<triton::usize>* projection=nullptr) const;
+
         public:
           //! Computes and returns a model from a symbolic constraint.
           /*! \brief map of symbolic variable id -> model
@@ -53,8 +173,11 @@ namespace triton {
            * \description
            * **item1**: symbolic variable id<br>
            * **item2**: model
+           *
+           * If `status` is not null, it receives the status of the query. If `timeout` (in milliseconds) is 0,
+           * the default timeout is used.
            */
-          std::map<triton::uint32, SolverModel> getModel(triton::ast::AbstractNode *node) const;
+          std::map<triton::uint32, SolverModel> getModel(triton::ast::AbstractNode *node, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0);
 
           //! Computes and returns several models from a symbolic constraint. The `limit` is the number of models returned.
           /*! \brief list of map of symbolic variable id -> model
@@ -62,8 +185,82 @@ namespace triton {
            * \description
            * **item1**: symbolic variable id<br>
            * **item2**: model
+           *
+           * If `status` is not null, it receives the status of the last check. If `timeout` (in milliseconds) is 0,
+           * the default timeout is used for each check.
            */
-          std::list<std::map<triton::uint32, SolverModel>> getModels(triton::ast::AbstractNode *node, triton::uint32 limit) const;
+          std::list<std::map<triton::uint32, SolverModel>> getModels(triton::ast::AbstractNode *node, triton::uint32 limit, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0);
+
+          /*! \brief Enumerates the models of a symbolic constraint which differ on a set of symbolic variables.
+           *
+           * \description
+           * Each model is given to `callback` as soon as it is found, the enumeration stops when the callback
+           * returns false, when `limit` models have been found (0 means no limit) or when there is no other model.
+           * A model is excluded by a clause over the variables of `variables` only, so models which only differ
+           * on the other variables are not enumerated. If `variables` is empty, all the variables are used.
+           * Returns the number of models found. If `status` is not null, it receives the status of the last check.
+           */
+          triton::usize enumerateModels(triton::ast::AbstractNode *node, const std::set<triton::usize>& variables, const std::function<bool(const std::map<triton::uint32, SolverModel>&)>& callback, triton::uint32 limit=0, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0);
+
+          /*! \brief Computes a model for each symbolic constraint of a batch.
+           *
+           * \description
+           * The queries go by chunks of one query per worker thread (see setThreads()). Each query of a chunk
+           * is converted into its own Z3 context, then they are solved in parallel and their contexts are freed
+           * before the next chunk. The models are returned in the order of `nodes`,
+           * an empty map means that the constraint has no model. If `status` is not null, it receives
+           * the status of each query.
+           */
+          std::vector<std::map<triton::uint32, SolverModel>> getModels(const std::vector<triton::ast::AbstractNode*>& nodes, std::vector<triton::engines::solver::status_e>* status=nullptr, triton::uint32 timeout=0);
+
+          /*! \brief Computes a model which follows the path constraints before `index` and takes another branch at `index`.
+           *
+           * \description
+           * The query is solved in the incremental session. The path constraints are asserted once and kept
+           * across calls as long as they are still the prefix of the path constraints of the symbolic engine.
+           * If the PC_INDEPENDENCE optimization is enabled, only the path constraints which share variables with the
+           * branch are sent, in a solver of their own. Returns an empty map if there is no such model.
+           */
+          std::map<triton::uint32, SolverModel> getNegatedBranchModel(triton::usize index, triton::engines::solver::status_e* status=nullptr, triton::uint32 timeout=0);
+
+          //! Computes the model of getNegatedBranchModel() for every path constraint, in one pass over the incremental session.
+          std::vector<std::map<triton::uint32, SolverModel>> getNegatedBranchesModels(void);
+
+          //! Returns the number of worker threads used to solve a batch of queries.
+          triton::uint32 getThreads(void) const;
+
+          //! Sets the number of worker threads used to solve a batch of queries.
+          void setThreads(triton::uint32 threads);
+
+          //! Returns the default timeout of a query in milliseconds.
+          triton::uint32 getTimeout(void) const;
+
+          //! Sets the default timeout of a query in milliseconds (0 means no timeout).
+          void setTimeout(triton::uint32 timeout);
+
+          //! Returns the memory limit of the solver in megabytes.
+          triton::uint32 getMemoryLimit(void) const;
+
+          //! Sets the memory limit of the solver in megabytes (0 means no limit). The limit is applied to each query.
+          void setMemoryLimit(triton::uint32 limit);
+
+          /*! \brief Returns the statistics of the last queries sent to the solver, most recent last.
+           *
+           * \description
+           * Each query is described by: `id`, `hash` (structural hash of the constraint), `nodes` (number of
+           * nodes translated), `variables` (number of symbolic variables), `translationTime` and `solveTime`
+           * (in microseconds) and `status` (see status_e).
+           */
+          const std::list<std::map<std::string, triton::uint64>>& getQueryStats(void) const;
+
+          //! Clears the statistics of the queries.
+          void clearQueryStats(void);
+
+          //! Returns the stats of the query cache.
+          std::map<std::string, triton::usize> getQueryCacheStats(void) const;
+
+          //! Clears the query cache and its stats.
+          void clearQueryCache(void);
 
           //! Evaluates an AST via Z3 and returns the symbolic value.
           triton::uint512 evaluateAstViaZ3(triton::ast::AbstractNode *node) const;
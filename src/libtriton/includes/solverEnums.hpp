@@ -0,0 +1,52 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_SOLVERENUMS_H
+#define TRITON_SOLVERENUMS_H
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Solver namespace
+    namespace solver {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup solver
+     *  @{
+     */
+
+      //! Enumerates all status of a solver query.
+      enum status_e {
+        SAT,        //!< The query has a model.
+        UNSAT,      //!< The query has no model.
+        TIMEOUT,    //!< The solver has been stopped by the timeout.
+        OUTOFMEM,   //!< The solver has reached the memory limit.
+        UNKNOWN,    //!< The solver has given up for another reason.
+      };
+
+    /*! @} End of solver namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SOLVERENUMS_H */
@@ -67,6 +67,9 @@ namespace triton {
           //! Constructor.
           SolverModel(const std::string& name, triton::uint512 value);
 
+          //! Constructor.
+          SolverModel(const std::string& name, triton::uint32 id, triton::uint512 value);
+
           //! Constructor by copy.
           SolverModel(const SolverModel& other);
 
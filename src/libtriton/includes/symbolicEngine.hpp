@@ -10,7 +10,9 @@
 
 #include <list>
 #include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 #include "ast.hpp"
 #include "astDictionaries.hpp"
@@ -19,6 +21,7 @@
 #include "registerOperand.hpp"
 #include "symbolicEnums.hpp"
 #include "symbolicExpression.hpp"
+#include "symbolicMemory.hpp"
 #include "symbolicOptimization.hpp"
 #include "symbolicSimplification.hpp"
 #include "symbolicVariable.hpp"
@@ -49,6 +52,9 @@ namespace triton {
      *  @{
      */
 
+      //! Minimum number of new expressions between two automatic removals of the dead expressions.
+      const triton::usize DEAD_EXPRESSIONS_THRESHOLD = 4096;
+
       //! \class SymbolicEngine
       /*! \brief The symbolic engine class. */
       class SymbolicEngine
@@ -87,21 +93,96 @@ namespace triton {
            */
           std::map<triton::usize, SymbolicExpression*> symbolicExpressions;
 
-          /*! \brief map of address -> symbolic expression
-           *
-           * \description
-           * **item1**: memory address<br>
-           * **item2**: symbolic reference id
-           */
-          std::map<triton::uint64, triton::usize> memoryReference;
+          //! The symbolic memory, map of address -> symbolic reference id.
+          SymbolicMemory memoryReference;
 
-          /*! \brief map of <address:size> -> symbolic expression.
+          /*! \brief map of address -> <size:AST> of the aligned memory stores.
            *
            * \description
-           * **item1**: <addr:size><br>
-           * **item2**: symbolic reference id
+           * **item1**: start address<br>
+           * **item2**: <size:stored AST>
+           *
+           * The ranges `[address:size]` never overlap: a store removes every entry it overlaps.
            */
-          std::map<std::pair<triton::uint64, triton::uint32>, triton::ast::AbstractNode*> alignedMemoryReference;
+          std::map<triton::uint64, std::pair<triton::uint32, triton::ast::AbstractNode*>> alignedMemoryReference;
+
+          //! True if a snapshot is taken. \sa takeSnapshot().
+          bool snapshotFlag;
+
+          //! The enable flag when the snapshot was taken.
+          bool snapshotEnableFlag;
+
+          //! The unique symbolic expression id when the snapshot was taken. Expressions from this id are newer than the snapshot.
+          triton::usize snapshotSymExprId;
+
+          //! The unique symbolic variable id when the snapshot was taken. Variables from this id are newer than the snapshot.
+          triton::usize snapshotSymVarId;
+
+          //! The undo log of the symbolic registers since the snapshot: <register id, previous reference id>.
+          std::vector<std::pair<triton::uint32, triton::usize>> undoRegisters;
+
+          //! The undo log of the symbolic memory since the snapshot: <address, previous reference id>.
+          std::vector<std::pair<triton::uint64, triton::usize>> undoMemory;
+
+          //! The undo log of the aligned memory since the snapshot: <address, previous <size:AST>>. A null AST means that there was no entry.
+          std::vector<std::pair<triton::uint64, std::pair<triton::uint32, triton::ast::AbstractNode*>>> undoAlignedMemory;
+
+          //! The undo log of the ASTs of the expressions older than the snapshot: <expression, previous AST>.
+          std::vector<std::pair<SymbolicExpression*, triton::ast::AbstractNode*>> undoAsts;
+
+          //! The expressions older than the snapshot which have been removed since. They are deleted when the snapshot is dropped.
+          std::vector<SymbolicExpression*> undoRemovedExpressions;
+
+          //! The unique symbolic expression id when the dead expressions were last removed. \sa removeDeadSymbolicExpressionsIfNeeded().
+          triton::usize eliminationSymExprId;
+
+          //! The number of expressions left by the last removal of the dead expressions.
+          triton::usize liveAfterElimination;
+
+          //! The expressions held outside of the engine (e.g. by the Python objects) and how many times they have been held. \sa holdSymbolicExpression().
+          std::map<SymbolicExpression*, triton::usize> heldExpressions;
+
+          //! The held expressions which have been removed from the engine. They are deleted when they are released.
+          std::set<SymbolicExpression*> detachedExpressions;
+
+          //! Marks live the expression `id` if it is not older than `fromId`, and queues it if it was not live yet.
+          void markLiveExpression(triton::usize id, triton::usize fromId, std::set<triton::usize>& live, std::vector<SymbolicExpression*>& worklist) const;
+
+          //! Marks live the expressions referenced by `nodes` and, transitively, by the queued expressions. \sa markLiveExpression().
+          void propagateLiveExpressions(std::vector<triton::ast::AbstractNode*>& nodes, triton::usize fromId, std::set<triton::usize>& live, std::vector<SymbolicExpression*>& worklist) const;
+
+          //! Deletes an expression which is neither assigned to a register nor to the memory. Expressions older than the snapshot are kept to be restored.
+          void dropSymbolicExpression(triton::usize symExprId);
+
+          //! Deletes an expression removed from the engine. A held expression is only detached, it is deleted when it is released.
+          void deleteSymbolicExpression(SymbolicExpression* se);
+
+          //! Assigns a reference id to a register and logs the previous one if a snapshot is taken.
+          void setSymbolicRegisterId(triton::uint32 parentId, triton::usize id);
+
+          //! Assigns a reference id (or UNSET) to a memory byte and logs the previous one if a snapshot is taken.
+          void setSymbolicMemoryId(triton::uint64 addr, triton::usize id);
+
+          //! Logs the AST of an expression before it is replaced, if the expression is older than the snapshot.
+          void logSymbolicExpressionAst(SymbolicExpression* se);
+
+          //! Records the AST stored in `[addr:size]` as an aligned entry.
+          void addAlignedMemory(triton::uint64 addr, triton::uint32 size, triton::ast::AbstractNode* node);
+
+          //! Returns the AST of `[addr:size]` if it is covered by an aligned entry (an extract of it for a partial hit), nullptr otherwise.
+          triton::ast::AbstractNode* getAlignedMemory(triton::uint64 addr, triton::uint32 size) const;
+
+          //! Returns the AST stored by a single memory write if the `size` bytes of `ids` are exactly this write, nullptr otherwise.
+          triton::ast::AbstractNode* getStoredAst(const triton::usize* ids, triton::uint32 size) const;
+
+          //! Returns the AST pointed by a node, following the chain of references.
+          triton::ast::AbstractNode* getReferencedAst(triton::ast::AbstractNode* node) const;
+
+          //! Expands the references of an AST in place.
+          triton::ast::AbstractNode* expandFullAst(triton::ast::AbstractNode* node);
+
+          //! Returns a new AST where references are expanded. Subtrees without reference are shared with the original AST.
+          triton::ast::AbstractNode* duplicateFullAst(triton::ast::AbstractNode* node);
 
         public:
 
@@ -114,8 +195,30 @@ namespace triton {
           //! Removes the symbolic expression corresponding to the id.
           void removeSymbolicExpression(triton::usize symExprId);
 
-          //! Removes aligned entry.
-          void removeAlignedMemory(triton::uint64 addr);
+          //! Holds an expression. A held expression removed from the engine is not deleted until it is released, its nodes are kept alive.
+          void holdSymbolicExpression(SymbolicExpression* se);
+
+          //! Releases an expression held by holdSymbolicExpression(). Deletes it if it has been removed from the engine and it is not held anymore.
+          void releaseSymbolicExpression(SymbolicExpression* se);
+
+          //! Removes the expressions of a basic block which are overwritten in the block before being used. Only the live-out expressions of the block are kept. Returns the number of expressions removed.
+          triton::usize removeDeadBlockExpressions(std::vector<triton::arch::Instruction>& block);
+
+          /*!
+           * \brief Removes the expressions which are not live anymore. Returns the number of expressions removed.
+           *
+           * \description An expression is live if it is assigned to a register or to a memory byte, or referenced by
+           * the aligned memory, a path constraint or another live expression. The removed expressions must not be used
+           * anymore (e.g. from the instructions which created them) unless they are held, their nodes are reclaimed by
+           * the AST garbage collector.
+           */
+          triton::usize removeDeadSymbolicExpressions(void);
+
+          //! Removes the dead expressions when at least as many expressions as the live ones have been created since the last removal.
+          triton::usize removeDeadSymbolicExpressionsIfNeeded(void);
+
+          //! Removes the aligned entries overlapping `[addr:size]`.
+          void removeAlignedMemory(triton::uint64 addr, triton::uint32 size=BYTE_SIZE);
 
           //! Adds a symbolic variable.
           SymbolicVariable* newSymbolicVariable(symkind_e kind, triton::uint64 kindValue, triton::uint32 size, const std::string& comment="");
@@ -189,6 +292,9 @@ namespace triton {
           //! Returns the new symbolic flag expression expression and links this expression to the instruction.
           SymbolicExpression* createSymbolicFlagExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, triton::arch::RegisterOperand& flag, const std::string& comment="");
 
+          //! Returns a new lazy symbolic flag expression and links this expression to the instruction. `value` is the concrete value of the flag. \sa triton::engines::symbolic::LAZY_FLAGS
+          SymbolicExpression* createSymbolicLazyFlagExpression(triton::arch::Instruction& inst, LazyAst* lazy, triton::uint512 value, triton::arch::RegisterOperand& flag, const std::string& comment="");
+
           //! Returns the new symbolic volatile expression expression and links this expression to the instruction.
           SymbolicExpression* createSymbolicVolatileExpression(triton::arch::Instruction& inst, triton::ast::AbstractNode* node, const std::string& comment="");
 
@@ -204,8 +310,8 @@ namespace triton {
           //! Assigns a symbolic expression to a memory.
           void assignSymbolicExpressionToMemory(SymbolicExpression *se, const triton::arch::MemoryOperand& mem);
 
-          //! Returns the full AST of a root node.
-          triton::ast::AbstractNode* getFullAst(triton::ast::AbstractNode* node);
+          //! Returns the full AST of a root node. If `inplace` is false, the stored expressions are not modified and a new AST is returned.
+          triton::ast::AbstractNode* getFullAst(triton::ast::AbstractNode* node, bool inplace=true);
 
           //! Returns the list of the tainted symbolic expressions.
           std::list<SymbolicExpression*> getTaintedSymbolicExpressions(void) const;
@@ -216,6 +322,12 @@ namespace triton {
           //! Returns all symbolic variables.
           const std::map<triton::usize, SymbolicVariable*>& getSymbolicVariables(void) const;
 
+          //! Extracts the roots of the ASTs still used by the engine (expressions, aligned memory and path constraints).
+          void extractAstRoots(std::vector<triton::ast::AbstractNode*>& roots) const;
+
+          //! Builds the AST of every lazy symbolic expression.
+          void buildLazyAsts(void);
+
           //! Returns all variable declarations representation.
           std::string getVariablesDeclaration(void) const;
 
@@ -246,6 +358,25 @@ namespace triton {
           //! Returns true if the symbolic expression ID exists.
           bool isSymbolicExpressionIdExists(triton::usize symExprId) const;
 
+          /*!
+           * \brief Takes a snapshot of the symbolic engine.
+           *
+           * \description From now on, the engine logs the previous state of what it modifies instead of
+           * copying itself, so taking and restoring a snapshot cost O(changes since the snapshot). Expressions
+           * and variables created after the snapshot are deleted on restore. A previous snapshot is dropped.
+           * ASTs modified in place (e.g. by getFullAst()) are not logged.
+           */
+          void takeSnapshot(void);
+
+          //! Restores the state of the last snapshot. The snapshot remains taken, so it can be restored again.
+          void restoreSnapshot(void);
+
+          //! Drops the snapshot and its undo log.
+          void disableSnapshot(void);
+
+          //! Returns true if a snapshot is taken.
+          bool isSnapshotEnabled(void) const;
+
           //! Initializes a SymbolicEngine.
           void init(const SymbolicEngine& other);
 
@@ -53,11 +53,17 @@ namespace triton {
 
       //! Enumerates all Kinds of symbolic optimization.
       enum optimization_e {
-        ALIGNED_MEMORY,        //!< Keep a map of aligned memory.
-        AST_DICTIONARIES,      //!< Abstract Syntax Tree dictionaries.
-        ONLY_ON_SYMBOLIZED,    //!< Perform symbolic execution only on symbolized expressions.
-        ONLY_ON_TAINTED,       //!< Perform symbolic execution only on tainted instructions.
-        PC_TRACKING_SYMBOLIC,  //!< Track path constraints only if they are symbolized.
+        ALIGNED_MEMORY,               //!< Keep a map of aligned memory.
+        AST_DICTIONARIES,             //!< Abstract Syntax Tree dictionaries.
+        ONLY_ON_SYMBOLIZED,           //!< Perform symbolic execution only on symbolized expressions.
+        ONLY_ON_TAINTED,              //!< Perform symbolic execution only on tainted instructions.
+        PC_TRACKING_SYMBOLIC,         //!< Track path constraints only if they are symbolized.
+        AST_GARBAGE_COLLECTION,       //!< Automatically free the Abstract Syntax Tree nodes which are not reachable anymore.
+        SOLVER_QUERY_CACHE,           //!< Reuse the answers of previous solver queries.
+        PC_INDEPENDENCE,              //!< Send to the solver only the path constraints which share symbolic variables with the query.
+        SEMANTICS_TEMPLATES,          //!< Instantiate the flag semantics from AST templates built on their first use.
+        LAZY_FLAGS,                   //!< Build the AST of the flags only when they are read.
+        DEAD_EXPRESSIONS_ELIMINATION, //!< Remove the symbolic expressions which are not live anymore after the basic blocks.
       };
 
     /*! @} End of symbolic namespace */
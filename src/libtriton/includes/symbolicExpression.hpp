@@ -9,6 +9,7 @@
 #define TRITON_SYMBOLICEXPRESSION_H
 
 #include <string>
+#include <vector>
 
 #include "ast.hpp"
 #include "memoryOperand.hpp"
@@ -41,6 +42,28 @@ namespace triton {
      *  @{
      */
 
+      /*! \class LazyAst
+       *  \brief The semantics of a symbolic expression whose AST is built on its first use.
+       *
+       * \description See the `LAZY_FLAGS` optimization. Architectures inherit from this class to keep
+       * what they need to build the AST later (e.g. the operands of the instruction).
+       */
+      class LazyAst {
+        public:
+          //! Destructor.
+          virtual ~LazyAst() {}
+
+          //! Builds the AST.
+          virtual triton::ast::AbstractNode* build(void) = 0;
+
+          //! Returns true if the AST will be symbolized.
+          virtual bool isSymbolized(void) const = 0;
+
+          //! Appends the nodes the AST will be built from. They are roots of the AST garbage collector.
+          virtual void extractRoots(std::vector<triton::ast::AbstractNode*>& roots) const = 0;
+      };
+
+
       //! \class SymbolicExpression
       /*! \brief The symbolic expression class */
       class SymbolicExpression {
@@ -49,8 +72,11 @@ namespace triton {
           //! The kind of the symbolic expression.
           symkind_e kind;
 
-          //! The root node (AST) of the symbolic expression.
-          triton::ast::AbstractNode* ast;
+          //! The root node (AST) of the symbolic expression. Nullptr until a lazy expression is built.
+          mutable triton::ast::AbstractNode* ast;
+
+          //! The semantics of a lazy expression, nullptr once its AST is built. Owned by the expression.
+          mutable LazyAst* lazyAst;
 
           //! The comment of the symbolic expression.
           std::string comment;
@@ -80,10 +106,19 @@ namespace triton {
           //! Returns the kind of the symbolic expression.
           symkind_e getKind(void) const;
 
-          //! Returns the SMT AST root node of the symbolic expression. This is the semantics.
+          //! Returns true if the AST of the symbolic expression has not been built yet.
+          bool isLazy(void) const;
+
+          //! Returns true if the AST of the symbolic expression is symbolized. Does not build the AST of a lazy expression.
+          bool isSymbolized(void) const;
+
+          //! Appends the nodes which keep the symbolic expression alive. Does not build the AST of a lazy expression.
+          void extractRoots(std::vector<triton::ast::AbstractNode*>& roots) const;
+
+          //! Returns the SMT AST root node of the symbolic expression. This is the semantics. The AST of a lazy expression is built first.
           triton::ast::AbstractNode* getAst(void) const;
 
-          //! Returns a new SMT AST root node of the symbolic expression. This new instance is a duplicate of the original node and may be changed without changing the original semantics.
+          //! Returns a new SMT AST root node of the symbolic expression. This new instance is a duplicate of the original node and may be changed without changing the original semantics. Pin it (see `API::pinAstNode()`) to keep it across a collection.
           triton::ast::AbstractNode* getNewAst(void) const;
 
           //! Returns the comment of the symbolic expression.
@@ -104,6 +139,9 @@ namespace triton {
           //! Sets a root node.
           void setAst(triton::ast::AbstractNode* node);
 
+          //! Sets the semantics of a lazy expression. The expression takes the ownership of `lazy`.
+          void setLazyAst(LazyAst* lazy);
+
           //! Sets the kind of the symbolic expression.
           void setKind(symkind_e k);
 
@@ -0,0 +1,120 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_SYMBOLICMEMORY_H
+#define TRITON_SYMBOLICMEMORY_H
+
+#include <map>
+#include <set>
+
+#include "pagedMemory.hpp"
+#include "symbolicEnums.hpp"
+#include "tritonTypes.hpp"
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Symbolic Execution namespace
+    namespace symbolic {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup symbolic
+     *  @{
+     */
+
+      //! \class SymbolicMemoryPage
+      /*! \brief A page of symbolic memory. Each byte holds the id of its symbolic expression or UNSET. */
+      class SymbolicMemoryPage {
+        public:
+          //! The symbolic expression ids of the page.
+          triton::usize ids[MEMORY_PAGE_SIZE];
+
+          //! The number of bytes which are not UNSET.
+          triton::uint32 count;
+
+          //! Constructor.
+          SymbolicMemoryPage();
+      };
+
+      //! \class SymbolicMemory
+      /*! \brief The symbolic memory, a map of address -> symbolic expression id stored as sparse pages of MEMORY_PAGE_SIZE bytes. */
+      class SymbolicMemory {
+        protected:
+          /*! \brief map of page base address -> page
+           *
+           * \description
+           * **item1**: page base address<br>
+           * **item2**: page
+           */
+          std::map<triton::uint64, SymbolicMemoryPage> pages;
+
+          //! The base address of the last page accessed for writing.
+          triton::uint64 lastPageBase;
+
+          //! The last page accessed for writing. Nullptr if the cache is empty.
+          SymbolicMemoryPage* lastPage;
+
+          //! Returns the page of `addr`. Creates it if it is not mapped.
+          SymbolicMemoryPage* getPage(triton::uint64 addr);
+
+        public:
+          //! Constructor.
+          SymbolicMemory();
+
+          //! Constructor by copy.
+          SymbolicMemory(const SymbolicMemory& copy);
+
+          //! Destructor.
+          ~SymbolicMemory();
+
+          //! Copies a SymbolicMemory.
+          void operator=(const SymbolicMemory& copy);
+
+          //! Removes all references.
+          void clear(void);
+
+          //! Returns the symbolic expression id of a byte, UNSET if the byte is concrete.
+          triton::usize get(triton::uint64 addr) const;
+
+          //! Copies the symbolic expression ids of `[addr:size]` into `ids`. Returns true if at least one byte is symbolic.
+          bool get(triton::uint64 addr, triton::usize* ids, triton::uint32 size) const;
+
+          //! Assigns a symbolic expression id to a byte.
+          void set(triton::uint64 addr, triton::usize id);
+
+          //! Removes the reference of a byte. Pages without references are freed.
+          void erase(triton::uint64 addr);
+
+          //! Returns all references as a map of address -> symbolic expression id.
+          std::map<triton::uint64, triton::usize> getReferences(void) const;
+
+          //! Inserts the symbolic expression ids referenced by the memory into `ids`.
+          void extractIds(std::set<triton::usize>& ids) const;
+      };
+
+    /*! @} End of symbolic namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_SYMBOLICMEMORY_H */
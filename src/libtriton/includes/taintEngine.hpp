@@ -9,11 +9,17 @@
 #define TRITON_TAINTENGINE_H
 
 #include <map>
+#include <set>
 #include <sstream>
 #include <stdint.h>
+#include <utility>
+#include <vector>
 
+#include "instruction.hpp"
 #include "memoryOperand.hpp"
 #include "registerOperand.hpp"
+#include "taintLabels.hpp"
+#include "taintMemory.hpp"
 #include "tritonTypes.hpp"
 
 
@@ -56,14 +62,74 @@ namespace triton {
           //! Enable / Disable flag.
           bool enableFlag;
 
-          //! The map of tainted address.
-          std::map<triton::uint64, bool> taintedAddresses;
+          //! The shadow memory of tainted addresses.
+          TaintMemory taintedAddresses;
 
           //! The number of register according to the CPU.
           triton::uint32 numberOfRegisters;
 
-          //! Tainted registers. Currently this is an over approximation of the taint but a byte granularity can be used.
-          triton::uint8  *taintedRegisters;
+          //! Tainted registers. Each parent register has a mask where the bit `i` is its byte `i`.
+          triton::uint64 *taintedRegisters;
+
+          //! True if the taint labels are propagated. \sa enableLabels().
+          bool labelsFlag;
+
+          //! The hash-consed label sets.
+          TaintLabelSets labelSets;
+
+          //! The label set of each tainted address.
+          TaintLabelMemory addressLabels;
+
+          //! The label set of each byte of the parent registers, at `parentId * DQQWORD_SIZE + byte`.
+          std::vector<triton::uint32> registerLabels;
+
+          //! True if a snapshot is taken. \sa takeSnapshot().
+          bool snapshotFlag;
+
+          //! The enable flag when the snapshot was taken.
+          bool snapshotEnableFlag;
+
+          //! The undo log of the tainted registers since the snapshot: <register id, previous mask>.
+          std::vector<std::pair<triton::uint32, triton::uint64>> undoRegisters;
+
+          //! The undo log of the tainted addresses since the snapshot: <<address, size>, previous mask>.
+          std::vector<std::pair<std::pair<triton::uint64, triton::uint32>, triton::uint64>> undoAddresses;
+
+          //! The undo log of the register labels since the snapshot: <index into registerLabels, previous label set>.
+          std::vector<std::pair<triton::usize, triton::uint32>> undoRegisterLabels;
+
+          //! The undo log of the address labels since the snapshot: <address, previous label set>.
+          std::vector<std::pair<triton::uint64, triton::uint32>> undoAddressLabels;
+
+          //! Sets the label set of a byte of a parent register and logs the previous one if a snapshot is taken.
+          void setRegisterLabels(triton::uint32 parentId, triton::uint32 byte, triton::uint32 set);
+
+          //! Sets the label set of an address and logs the previous one if a snapshot is taken.
+          void setAddressLabels(triton::uint64 addr, triton::uint32 set);
+
+          //! Returns the union of the label sets of the bytes of a register. EMPTY_LABELS if the labels are disabled.
+          triton::uint32 getRegisterLabels(const triton::arch::RegisterOperand& reg);
+
+          //! Returns the union of the label sets of `[addr:size]`. EMPTY_LABELS if the labels are disabled.
+          triton::uint32 getAddressLabels(triton::uint64 addr, triton::uint32 size);
+
+          //! Returns the union of the label sets of the registers and memory read by an instruction, the registers of its memory addresses excluded. EMPTY_LABELS if the labels are disabled.
+          triton::uint32 getInstructionLabels(const triton::arch::Instruction& inst);
+
+          //! Sets the taint mask of a parent register and logs the previous one if a snapshot is taken.
+          void setRegisterTaint(triton::uint32 parentId, triton::uint64 mask);
+
+          //! Sets the taint mask of `[addr:size]` and logs the previous one if a snapshot is taken.
+          void setAddressTaint(triton::uint64 addr, triton::uint32 size, triton::uint64 mask);
+
+          /*!
+           * \brief Sets the taint of a register written by an instruction.
+           *
+           * \description All bytes of `reg` get `flag` and, if they are tainted, the label set `labels`.
+           * As in SymbolicEngine::createSymbolicRegisterExpression(), a write of DWORD_SIZE or more
+           * zero-extends into the parent register, so its upper bytes are untainted.
+           */
+          bool writeRegisterTaint(const triton::arch::RegisterOperand& reg, bool flag, triton::uint32 labels=EMPTY_LABELS);
 
           //! Copies a TaintEngine.
           void init(const TaintEngine& other);
@@ -109,6 +175,22 @@ namespace triton {
           */
           bool setTaintRegister(const triton::arch::RegisterOperand& reg, bool flag);
 
+          //! Sets memory flag. If tainted, the bytes of the memory get the labels of the operands read by the instruction.
+          /*!
+            \param inst the instruction which writes the memory.
+            \param mem the memory operand.
+            \param flag TAINTED or !TAINTED
+          */
+          bool setTaintMemory(const triton::arch::Instruction& inst, const triton::arch::MemoryOperand& mem, bool flag);
+
+          //! Sets register flag. If tainted, the bytes of the register get the labels of the operands read by the instruction.
+          /*!
+            \param inst the instruction which writes the register.
+            \param reg the register operand.
+            \param flag TAINTED or !TAINTED
+          */
+          bool setTaintRegister(const triton::arch::Instruction& inst, const triton::arch::RegisterOperand& reg, bool flag);
+
           //! Taints an address.
           /*!
             \param addr the targeted address.
@@ -127,6 +209,48 @@ namespace triton {
           */
           bool taintRegister(const triton::arch::RegisterOperand& reg);
 
+          //! Taints an address with a label.
+          /*!
+            \param addr the targeted address.
+            \param label the label of the source.
+          */
+          bool taintMemory(triton::uint64 addr, triton::uint32 label);
+
+          //! Taints a memory with a label.
+          /*!
+            \param mem the memory operand.
+            \param label the label of the source.
+          */
+          bool taintMemory(const triton::arch::MemoryOperand& mem, triton::uint32 label);
+
+          //! Taints a register with a label.
+          /*!
+            \param reg the register operand.
+            \param label the label of the source.
+          */
+          bool taintRegister(const triton::arch::RegisterOperand& reg, triton::uint32 label);
+
+          //! Returns true if the taint labels are propagated.
+          bool isLabelsEnabled(void) const;
+
+          /*!
+           * \brief Enables or disables the taint labels.
+           *
+           * \description When enabled, each byte tainted with a label keeps a set of labels, and the union
+           * and assignment rules propagate these sets along with the taint. Only the bytes tainted while the
+           * labels are enabled have labels. Disabling the labels removes them.
+           */
+          void enableLabels(bool flag);
+
+          //! Returns the labels which reach the address range `[addr:size]`.
+          std::set<triton::uint32> getTaintLabels(triton::uint64 addr, triton::uint32 size=1);
+
+          //! Returns the labels which reach the memory.
+          std::set<triton::uint32> getTaintLabels(const triton::arch::MemoryOperand& mem);
+
+          //! Returns the labels which reach the register.
+          std::set<triton::uint32> getTaintLabels(const triton::arch::RegisterOperand& reg);
+
           //! Untaints an address.
           /*!
             \param addr the targeted address.
@@ -237,6 +361,18 @@ namespace triton {
           */
           bool assignmentRegisterRegister(const triton::arch::RegisterOperand& regDst, const triton::arch::RegisterOperand& regSrc);
 
+          //! Takes a snapshot of the taint engine. From now on, the previous taint of what is modified is logged. A previous snapshot is dropped.
+          void takeSnapshot(void);
+
+          //! Restores the taint of the last snapshot in O(changes since the snapshot). The snapshot remains taken.
+          void restoreSnapshot(void);
+
+          //! Drops the snapshot and its undo log.
+          void disableSnapshot(void);
+
+          //! Returns true if a snapshot is taken.
+          bool isSnapshotEnabled(void) const;
+
           //! Copies a TaintEngine.
           void operator=(const TaintEngine& other);
 
@@ -0,0 +1,134 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_TAINTLABELS_H
+#define TRITON_TAINTLABELS_H
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "pagedMemory.hpp"
+#include "tritonTypes.hpp"
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Taint namespace
+    namespace taint {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup taint
+     *  @{
+     */
+
+      //! Defines the id of the empty label set.
+      const triton::uint32 EMPTY_LABELS = 0;
+
+      /*! \class TaintLabelSets
+       *  \brief The hash-consed label sets of the taint engine.
+       *
+       * \description Each distinct set of labels is stored once and referenced by an id, so a tainted
+       * byte only holds a 32-bit id and two sets are equal if their ids are equal. Unions are memoized.
+       */
+      class TaintLabelSets {
+        protected:
+          //! The sorted labels of each set (same index as the set id). The set 0 is EMPTY_LABELS.
+          std::vector<std::vector<triton::uint32>> sets;
+
+          //! multimap of hash of the sorted labels -> set id. The labels are compared on a hit.
+          std::unordered_multimap<triton::uint64, triton::uint32> ids;
+
+          //! map of <set id, set id> packed in 64 bits -> set id of their union. The first id is the smallest.
+          std::unordered_map<triton::uint64, triton::uint32> unions;
+
+          //! Returns the hash of a sorted set of labels.
+          static triton::uint64 hashLabels(const std::vector<triton::uint32>& labels);
+
+          //! Returns the id of a sorted set of labels. Creates it if it does not exist.
+          triton::uint32 intern(const std::vector<triton::uint32>& labels);
+
+        public:
+          //! Constructor.
+          TaintLabelSets();
+
+          //! Removes all sets but EMPTY_LABELS.
+          void clear(void);
+
+          //! Returns the id of the set `{label}`.
+          triton::uint32 getSet(triton::uint32 label);
+
+          //! Returns the id of the union of two sets.
+          triton::uint32 getUnion(triton::uint32 set1, triton::uint32 set2);
+
+          //! Returns the sorted labels of a set.
+          const std::vector<triton::uint32>& getLabels(triton::uint32 set) const;
+
+          //! Returns the number of sets.
+          triton::usize getNumberOfSets(void) const;
+      };
+
+      //! \class TaintLabelPage
+      /*! \brief A page of memory labels. Each byte holds the id of its label set. */
+      class TaintLabelPage {
+        public:
+          //! The label set ids of the page.
+          triton::uint32 sets[MEMORY_PAGE_SIZE];
+
+          //! The number of bytes which are not EMPTY_LABELS.
+          triton::uint32 count;
+
+          //! Constructor.
+          TaintLabelPage();
+      };
+
+      //! \class TaintLabelMemory
+      /*! \brief The labels of the memory, a map of address -> label set id stored as sparse pages of MEMORY_PAGE_SIZE bytes. */
+      class TaintLabelMemory {
+        protected:
+          /*! \brief map of page base address -> page
+           *
+           * \description
+           * **item1**: page base address<br>
+           * **item2**: page
+           */
+          std::map<triton::uint64, TaintLabelPage> pages;
+
+        public:
+          //! Removes all labels.
+          void clear(void);
+
+          //! Returns the label set id of a byte.
+          triton::uint32 get(triton::uint64 addr) const;
+
+          //! Sets the label set id of a byte. Pages without labels are freed.
+          void set(triton::uint64 addr, triton::uint32 set);
+      };
+
+    /*! @} End of taint namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_TAINTLABELS_H */
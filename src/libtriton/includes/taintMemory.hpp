@@ -0,0 +1,131 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_TAINTMEMORY_H
+#define TRITON_TAINTMEMORY_H
+
+#include <map>
+
+#include "pagedMemory.hpp"
+#include "tritonTypes.hpp"
+
+/*! Returns the number of bits of a taint bitmap word. */
+#define TAINT_WORD_BIT 64
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Engines namespace
+  namespace engines {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup engines
+   *  @{
+   */
+
+    //! The Taint namespace
+    namespace taint {
+    /*!
+     *  \ingroup engines
+     *  \addtogroup taint
+     *  @{
+     */
+
+      //! \class TaintMemoryPage
+      /*! \brief A page of shadow memory. Each byte of the page is one bit of the bitmap. */
+      class TaintMemoryPage {
+        public:
+          //! The bitmap of the tainted bytes.
+          triton::uint64 bits[MEMORY_PAGE_SIZE / TAINT_WORD_BIT];
+
+          //! The number of tainted bytes.
+          triton::uint32 count;
+
+          //! Returns the bits of `[offset:size]`. `size` is at most TAINT_WORD_BIT.
+          triton::uint64 getBits(triton::uint32 offset, triton::uint32 size) const;
+
+          //! Sets the bits of `[offset:size]` to `value`. `size` is at most TAINT_WORD_BIT.
+          void setBits(triton::uint32 offset, triton::uint32 size, triton::uint64 value);
+
+          //! Constructor.
+          TaintMemoryPage();
+      };
+
+      /*! \class TaintMemory
+       *  \brief The shadow memory of the taint engine.
+       *
+       * \description A two-level bitmap: a map of page base address -> bitmap of MEMORY_PAGE_SIZE bits.
+       * Accesses are done with masks of at most TAINT_WORD_BIT bytes (the bit `i` of a mask is the byte
+       * `addr+i`), so a memory operand is read or written one or two words at a time instead of byte by byte.
+       */
+      class TaintMemory {
+        protected:
+          /*! \brief map of page base address -> page
+           *
+           * \description
+           * **item1**: page base address<br>
+           * **item2**: page
+           */
+          std::map<triton::uint64, TaintMemoryPage> pages;
+
+          //! The base address of the last page accessed for writing.
+          triton::uint64 lastPageBase;
+
+          //! The last page accessed for writing. Nullptr if the cache is empty.
+          TaintMemoryPage* lastPage;
+
+          //! Returns the page of `addr`. Creates it if it is not mapped.
+          TaintMemoryPage* getPage(triton::uint64 addr);
+
+        public:
+          //! Constructor.
+          TaintMemory();
+
+          //! Constructor by copy.
+          TaintMemory(const TaintMemory& copy);
+
+          //! Destructor.
+          ~TaintMemory();
+
+          //! Copies a TaintMemory.
+          void operator=(const TaintMemory& copy);
+
+          //! Untaints all the memory.
+          void clear(void);
+
+          //! Returns the taint mask of `[addr:size]`. `size` is at most TAINT_WORD_BIT.
+          triton::uint64 get(triton::uint64 addr, triton::uint32 size) const;
+
+          //! Sets the taint mask of `[addr:size]`. `size` is at most TAINT_WORD_BIT. Pages without tainted bytes are freed.
+          void set(triton::uint64 addr, triton::uint32 size, triton::uint64 mask);
+
+          //! Returns true if at least one byte of `[addr:size]` is tainted.
+          bool isTainted(triton::uint64 addr, triton::usize size) const;
+
+          //! Returns the number of allocated pages.
+          triton::usize getNumberOfPages(void) const;
+      };
+
+      //! Returns the mask of the `size` lower bits.
+      inline triton::uint64 maskOf(triton::uint32 size) {
+        return (size >= TAINT_WORD_BIT) ? ~static_cast<triton::uint64>(0) : ((static_cast<triton::uint64>(1) << size) - 1);
+      }
+
+    /*! @} End of taint namespace */
+    };
+  /*! @} End of engines namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif /* TRITON_TAINTMEMORY_H */
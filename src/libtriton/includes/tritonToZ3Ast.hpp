@@ -8,6 +8,9 @@
 #ifndef TRITON_TRITONTOZ3AST_H
 #define TRITON_TRITONTOZ3AST_H
 
+#include <map>
+#include <string>
+#include <vector>
 #include <z3++.h>
 
 #include "ast.hpp"
@@ -43,6 +46,28 @@ namespace triton {
         //! The map of symbols. E.g: (let (symbols expr1) expr2)
         std::map<std::string, triton::ast::AbstractNode*> symbols;
 
+        /*! \brief The cache of converted nodes. Each node is converted once per context.
+         *
+         * \description
+         * **item1**: node<br>
+         * **item2**: structural hash of the node when it has been converted and its Z3 expression
+         */
+        std::map<triton::ast::AbstractNode*, std::pair<triton::uint64, z3::expr>> cache;
+
+        /*! \brief The symbolic variables met during the conversion.
+         *
+         * \description
+         * **item1**: symbolic variable id<br>
+         * **item2**: Z3 constant
+         */
+        std::map<triton::usize, z3::expr> variables;
+
+        //! Returns true if a node has already been converted and is still the same.
+        bool isCached(triton::ast::AbstractNode* node);
+
+        //! Returns the nodes which must be converted before a node.
+        std::vector<triton::ast::AbstractNode*> getOperands(triton::ast::AbstractNode* node);
+
       protected:
         //! The result.
         Z3Result result;
@@ -57,6 +82,18 @@ namespace triton {
         //! Evaluates a Triton AST.
         virtual Z3Result& eval(triton::ast::AbstractNode& e);
 
+        //! Returns the Z3 expression of a node, from the cache if it has already been converted.
+        z3::expr convert(triton::ast::AbstractNode* node);
+
+        //! Returns the context in which expressions are built.
+        z3::context& getContext(void);
+
+        //! Returns the number of nodes converted in the context.
+        triton::usize getNumberOfConvertedNodes(void) const;
+
+        //! Returns the symbolic variables met during the conversion (only when the conversion is not used to evaluate).
+        const std::map<triton::usize, z3::expr>& getVariables(void) const;
+
         //! Evaluate operator.
         virtual void operator()(triton::ast::AbstractNode& e);
         //! Evaluate operator.
@@ -16,8 +16,10 @@
 #include "cpuInterface.hpp"
 #include "instruction.hpp"
 #include "memoryOperand.hpp"
+#include "pagedMemory.hpp"
 #include "registerOperand.hpp"
 #include "tritonTypes.hpp"
+#include "x86DecodeCache.hpp"
 #include "x86Semantics.hpp"
 
 
@@ -50,13 +52,14 @@ namespace triton {
 
         protected:
 
-          /*! \brief map of address -> concrete value
-           *
-           * \description
-           * **item1**: memory address<br>
-           * **item2**: concrete value
-           */
-          std::map<triton::uint64, triton::uint8> memory;
+          //! The concrete memory.
+          triton::arch::PagedMemory memory;
+
+          //! The capstone handle (a `csh`), opened by the first disassembly and closed by the destructor. Zero if it is not opened.
+          mutable triton::usize handle;
+
+          //! The instructions already decoded. Not copied with the CPU state.
+          mutable triton::arch::x86::DecodeCache decodeCache;
 
           //! Concrete value of eax
           triton::uint8 eax[DWORD_SIZE];
@@ -212,6 +215,7 @@ namespace triton {
           std::set<triton::arch::RegisterOperand*> getParentRegisters(void) const;
           triton::uint512 getConcreteMemoryValue(const triton::arch::MemoryOperand& mem) const;
           std::vector<triton::uint8> getConcreteMemoryAreaValue(triton::uint64 baseAddr, triton::usize size) const;
+          const triton::uint8* getConcreteMemoryAreaView(triton::uint64 baseAddr, triton::usize& size) const;
           triton::uint512 getConcreteRegisterValue(const triton::arch::RegisterOperand& reg) const;
           triton::uint32 invalidRegister(void) const;
           triton::uint32 numberOfRegisters(void) const;
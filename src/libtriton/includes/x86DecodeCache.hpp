@@ -0,0 +1,136 @@
+//! \file
+/*
+**  Copyright (C) - Triton
+**
+**  This program is under the terms of the BSD License.
+*/
+
+#ifndef TRITON_X86DECODECACHE_HPP
+#define TRITON_X86DECODECACHE_HPP
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "instruction.hpp"
+#include "tritonTypes.hpp"
+
+
+
+//! The Triton namespace
+namespace triton {
+/*!
+ *  \addtogroup triton
+ *  @{
+ */
+
+  //! The Architecture namespace
+  namespace arch {
+  /*!
+   *  \ingroup triton
+   *  \addtogroup arch
+   *  @{
+   */
+
+    //! The x86 namespace
+    namespace x86 {
+    /*!
+     *  \ingroup arch
+     *  \addtogroup x86
+     *  @{
+     */
+
+      //! \class DecodedOperand
+      /*! \brief The layout of an operand decoded by Capstone. Register ids are Triton ids. */
+      class DecodedOperand {
+        public:
+          //! The operand type (triton::arch::OP_IMM, OP_MEM or OP_REG).
+          triton::uint32 type;
+
+          //! The operand size in bytes.
+          triton::uint32 size;
+
+          //! The immediate value (OP_IMM) or the displacement (OP_MEM).
+          triton::uint64 value;
+
+          //! The register (OP_REG) or the base register (OP_MEM).
+          triton::uint32 reg;
+
+          //! The segment register (OP_MEM).
+          triton::uint32 segment;
+
+          //! The index register (OP_MEM).
+          triton::uint32 index;
+
+          //! The scale (OP_MEM).
+          triton::uint64 scale;
+
+          //! Constructor.
+          DecodedOperand();
+      };
+
+      //! \class DecodedInstruction
+      /*! \brief What Capstone tells about an instruction, without the runtime state (register values and memory accesses). */
+      class DecodedInstruction {
+        public:
+          //! The opcodes of the instruction. Its size is the refined size of the instruction.
+          std::vector<triton::uint8> opcodes;
+
+          //! The disassembly.
+          std::string disassembly;
+
+          //! The instruction type.
+          triton::uint32 type;
+
+          //! The instruction prefix.
+          triton::uint32 prefix;
+
+          //! True if the instruction is a branch.
+          bool branch;
+
+          //! True if the instruction modifies the control flow.
+          bool controlFlow;
+
+          //! The operands.
+          std::vector<DecodedOperand> operands;
+
+          //! Constructor.
+          DecodedInstruction();
+      };
+
+      /*! \class DecodeCache
+       *  \brief The instructions already decoded by a CPU.
+       *
+       * \description Entries are keyed by address and only hit if the opcodes of the instruction
+       * start with the opcodes of the entry, so self-modifying code is decoded again.
+       */
+      class DecodeCache {
+        protected:
+          //! map of address -> decoded instruction
+          std::map<triton::uint64, DecodedInstruction> instructions;
+
+        public:
+          //! Returns the decoded instruction of `inst`, nullptr if it is not in the cache.
+          const DecodedInstruction* find(const triton::arch::Instruction& inst) const;
+
+          //! Records the decoded instruction of `inst` and returns it.
+          const DecodedInstruction& insert(const triton::arch::Instruction& inst, const DecodedInstruction& decoded);
+
+          //! Initializes `inst` (disassembly, size, type, prefix, operands and control flow) from a decoded instruction.
+          void apply(const DecodedInstruction& decoded, triton::arch::Instruction& inst) const;
+
+          //! Removes all entries.
+          void clear(void);
+
+          //! Returns the number of entries.
+          triton::usize size(void) const;
+      };
+
+    /*! @} End of x86 namespace */
+    };
+  /*! @} End of arch namespace */
+  };
+/*! @} End of triton namespace */
+};
+
+#endif  /* TRITON_X86DECODECACHE_HPP */
@@ -33,6 +33,10 @@ in a map \f$ \langle addr, byte \rangle \f$.
 
 When the snapshot must be restored, all modifications are re-injected in memory like this: \f$ \forall (addr, byte \in map) : *addr \gets byte \f$
 
+The symbolic and taint engines are not copied. Once the snapshot is taken, they log the previous state of everything they modify
+(registers, memory references, expressions and path constraints) and restoring replays this log backward. So, taking and restoring
+a snapshot cost \f$ O(changes) \f$ since the snapshot instead of the size of the whole trace.
+
 */
 
 
@@ -42,9 +46,8 @@ namespace tracer {
 
       Snapshot::Snapshot() {
         this->locked              = true;
-        this->snapshotTaintEngine = nullptr;
-        this->snapshotSymEngine   = nullptr;
         this->mustBeRestore       = false;
+        this->nodesMark           = 0;
       }
 
 
@@ -64,14 +67,15 @@ namespace tracer {
         /* 1 - Unlock the engine */
         this->locked = false;
 
-        /* 2 - Save current symbolic engine state */
-        this->snapshotSymEngine = new triton::engines::symbolic::SymbolicEngine(*triton::api.getSymbolicEngine());
+        /* 2 - Start logging the symbolic engine modifications */
+        triton::api.getSymbolicEngine()->takeSnapshot();
 
-        /* 3 - Save current taint engine state */
-        this->snapshotTaintEngine = new triton::engines::taint::TaintEngine(*triton::api.getTaintEngine());
+        /* 3 - Start logging the taint engine modifications */
+        triton::api.getTaintEngine()->takeSnapshot();
 
-        /* 4 - Save current set of nodes */
-        this->nodesList = triton::api.getAllocatedAstNodes();
+        /* 4 - Mark the current set of nodes (lazy ASTs are built now, otherwise the restore would free them) */
+        triton::api.getSymbolicEngine()->buildLazyAsts();
+        this->nodesMark = triton::api.markAstNodes();
 
         /* 5 - Save current map of variables */
         this->variablesMap = triton::api.getAstVariableNodes();
@@ -101,39 +105,19 @@ namespace tracer {
         }
         this->memory.clear();
 
-        /* 2 - Delete unused expressions */
-        auto currentExpressions     = triton::api.getSymbolicExpressions();
-        auto snapshotExpressions    = this->snapshotSymEngine->getSymbolicExpressions();
-        triton::usize currentSize   = currentExpressions.size();
-        triton::usize snapshotSize  = snapshotExpressions.size();
-        for (auto i = currentExpressions.begin(); i != currentExpressions.end(); ++i) {
-          if (snapshotExpressions.find(i->first) == snapshotExpressions.end())
-            delete currentExpressions[i->first];
-        }
-
-        /* 3 - Delete unused variables */
-        auto currentSymbolicVars   = triton::api.getSymbolicVariables();
-        auto snapshotSymbolicVars  = this->snapshotSymEngine->getSymbolicVariables();
-        currentSize                = currentSymbolicVars.size();
-        snapshotSize               = snapshotSymbolicVars.size();
-        for (auto i = currentSymbolicVars.begin(); i != currentSymbolicVars.end(); ++i) {
-          if (snapshotSymbolicVars.find(i->first) == snapshotSymbolicVars.end())
-            delete currentSymbolicVars[i->first];
-        }
-
-        /* 4 - Restore current symbolic engine state */
-        *triton::api.getSymbolicEngine() = *this->snapshotSymEngine;
+        /* 2 - Restore current symbolic engine state */
+        triton::api.getSymbolicEngine()->restoreSnapshot();
 
-        /* 5 - Restore current taint engine state */
-        *triton::api.getTaintEngine() = *this->snapshotTaintEngine;
+        /* 3 - Restore current taint engine state */
+        triton::api.getTaintEngine()->restoreSnapshot();
 
-        /* 6 - Restore current AST node state */
-        triton::api.setAllocatedAstNodes(this->nodesList);
+        /* 4 - Restore current AST node state */
+        triton::api.freeAstNodesSinceMark(this->nodesMark);
 
-        /* 7 - Restore current variables map state */
+        /* 5 - Restore current variables map state */
         triton::api.setAstVariableNodes(this->variablesMap);
 
-        /* 8 - Restore the Triton CPU state */
+        /* 6 - Restore the Triton CPU state */
         #if defined(__x86_64__) || defined(_M_X64)
         *reinterpret_cast<triton::arch::x86::x8664Cpu*>(triton::api.getCpu()) = *this->cpu;
         #endif
@@ -141,7 +125,7 @@ namespace tracer {
         *reinterpret_cast<triton::arch::x86::x86Cpu*>(triton::api.getCpu()) = *this->cpu;
         #endif
 
-        /* 9 - Restore Pin registers context */
+        /* 7 - Restore Pin registers context */
         PIN_SaveContext(&this->pinCtx, ctx);
 
         this->mustBeRestore = false;
@@ -161,11 +145,8 @@ namespace tracer {
       void Snapshot::resetEngine(void) {
         this->memory.clear();
 
-        delete this->snapshotSymEngine;
-        this->snapshotSymEngine = nullptr;
-
-        delete this->snapshotTaintEngine;
-        this->snapshotTaintEngine = nullptr;
+        triton::api.getSymbolicEngine()->disableSnapshot();
+        triton::api.getTaintEngine()->disableSnapshot();
       }
 
 
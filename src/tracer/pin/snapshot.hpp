@@ -51,18 +51,12 @@ namespace tracer {
         //! Flag which defines if we must restore the snapshot.
         bool mustBeRestore;
 
-        //! AST node state.
-        std::set<triton::ast::AbstractNode*> nodesList;
+        //! AST node state. Every node allocated since this mark is freed when restoring.
+        triton::usize nodesMark;
 
         //! Variables node state.
         std::map<std::string, triton::ast::AbstractNode*> variablesMap;
 
-        //! Snapshot of the symbolic engine.
-        triton::engines::symbolic::SymbolicEngine* snapshotSymEngine;
-
-        //! Snapshot of the taint engine.
-        triton::engines::taint::TaintEngine* snapshotTaintEngine;
-
         //! Snapshot of triton CPU.
         #if defined(__x86_64__) || defined(_M_X64)
         triton::arch::x86::x8664Cpu* cpu;